@@ -15,6 +15,7 @@
 #pragma endregion
 
 #include <openrct2/audio/AudioContext.h>
+#include <openrct2/cmdline/CommandLine.hpp>
 #include <openrct2/Context.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/PlatformEnvironment.h>
@@ -38,6 +39,7 @@ int NormalisedMain(int argc, const char * * argv)
 int main(int argc, const char * * argv)
 #endif
 {
+    CommandLine::SetBenchAudioFunc(AudioMixer::RunBenchmark);
     int runGame = cmdline_run(argv, argc);
     core_init();
     if (runGame == 1)
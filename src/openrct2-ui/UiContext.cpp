@@ -315,6 +315,12 @@ public:
                     OnResize(e.window.data1, e.window.data2);
                 }
 
+                // Only changed regions are presented each frame, so redraw everything when the window is exposed
+                if (e.window.event == SDL_WINDOWEVENT_EXPOSED)
+                {
+                    gfx_invalidate_screen();
+                }
+
                 switch (e.window.event) {
                 case SDL_WINDOWEVENT_SIZE_CHANGED:
                 case SDL_WINDOWEVENT_MOVED:
@@ -68,6 +68,11 @@ namespace OpenRCT2 { namespace Audio
     namespace AudioMixer
     {
         IAudioMixer * Create();
+
+        /**
+         * Plays synthetic channels through the mixer on the SDL dummy audio driver and prints mixing times.
+         */
+        bool RunBenchmark(sint32 numChannels, sint32 seconds);
     }
 
     IAudioContext * CreateAudioContext();
@@ -17,8 +17,16 @@
 #include <openrct2/common.h>
 #include <SDL.h>
 #include <speex/speex_resampler.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <openrct2/Context.h>
+#include <openrct2/core/Console.hpp>
 #include <openrct2/core/Guard.hpp>
 #include <openrct2/core/Math.hpp>
 #include <openrct2/core/Memory.hpp>
@@ -35,6 +43,11 @@
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/platform/platform.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OPENRCT2_AUDIO_SSE2
+    #include <emmintrin.h>
+#endif
+
 namespace OpenRCT2 { namespace Audio
 {
     struct Buffer
@@ -69,13 +82,107 @@ namespace OpenRCT2 { namespace Audio
         }
     };
 
+    /**
+     * Ring of mixed PCM data with a single producer (the mixing thread) and a
+     * single consumer (the SDL audio callback). Neither side takes a lock.
+     */
+    struct MixRingBuffer
+    {
+    private:
+        std::vector<uint8>  _data;
+        std::atomic<size_t> _readPosition { 0 };
+        std::atomic<size_t> _writePosition { 0 };
+
+    public:
+        void Reset(size_t capacity)
+        {
+            _data.assign(capacity, 0);
+            _readPosition = 0;
+            _writePosition = 0;
+        }
+
+        size_t GetFreeSpace() const
+        {
+            return _data.size() - (_writePosition.load(std::memory_order_relaxed) - _readPosition.load(std::memory_order_acquire));
+        }
+
+        /**
+         * Called from the producer only. Returns false if there is not enough room for the whole block.
+         */
+        bool Write(const void * src, size_t length)
+        {
+            if (GetFreeSpace() < length)
+            {
+                return false;
+            }
+            size_t writePosition = _writePosition.load(std::memory_order_relaxed);
+            Copy(writePosition, src, length, true);
+            _writePosition.store(writePosition + length, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Called from the consumer only. Returns the number of bytes read, which may be less than requested.
+         */
+        size_t Read(void * dst, size_t length)
+        {
+            size_t readPosition = _readPosition.load(std::memory_order_relaxed);
+            size_t available = _writePosition.load(std::memory_order_acquire) - readPosition;
+            length = Math::Min(length, available);
+            Copy(readPosition, dst, length, false);
+            _readPosition.store(readPosition + length, std::memory_order_release);
+            return length;
+        }
+
+    private:
+        void Copy(size_t position, const void * buffer, size_t length, bool toRing)
+        {
+            if (length == 0)
+            {
+                return;
+            }
+            size_t offset = position % _data.size();
+            size_t firstLength = Math::Min(length, _data.size() - offset);
+            if (toRing)
+            {
+                Memory::Copy(&_data[offset], (const uint8 *)buffer, firstLength);
+                Memory::Copy(_data.data(), (const uint8 *)buffer + firstLength, length - firstLength);
+            }
+            else
+            {
+                Memory::Copy((uint8 *)buffer, &_data[offset], firstLength);
+                Memory::Copy((uint8 *)buffer + firstLength, _data.data(), length - firstLength);
+            }
+        }
+    };
+
     class AudioMixerImpl final : public IAudioMixer
     {
     private:
+        // Number of device buffers mixed ahead of the SDL audio callback
+        static constexpr size_t MIX_AHEAD_CHUNKS = 2;
+        // Memory for decoded sound effects before the least recently used ones are unloaded
+        static constexpr size_t SOUND_CACHE_BUDGET = 8 * 1024 * 1024;
+
+        struct AudioConverter
+        {
+            AudioFormat  Format;
+            SDL_AudioCVT CVT;
+            bool         Valid;
+        };
+
+        struct SoundCacheEntry
+        {
+            IAudioSource * Source = nullptr;
+            uint32         LastUsed = 0;
+        };
+
         IAudioSource * _nullSource = nullptr;
 
         SDL_AudioDeviceID _deviceId = 0;
         AudioFormat _format = { 0 };
+        size_t _chunkLength = 0;
+        uint8 _silence = 0;
         std::list<ISDLAudioChannel *> _channels;
         float _volume = 1.0f;
         float _adjustSoundVolume = 0.0f;
@@ -83,12 +190,32 @@ namespace OpenRCT2 { namespace Audio
         uint8 _settingSoundVolume = 0xFF;
         uint8 _settingMusicVolume = 0xFF;
 
-        IAudioSource * _css1Sources[SOUND_MAXID] = { nullptr };
+        std::string _css1Path;
+        SoundCacheEntry _css1Sources[SOUND_MAXID];
         IAudioSource * _musicSources[PATH_ID_END] = { nullptr };
+        std::mutex _soundCacheMutex;
+        size_t _soundCacheSize = 0;
+        uint32 _soundCacheTick = 0;
+        std::thread _soundPrefetchThread;
+        std::atomic<bool> _soundPrefetchStop { false };
 
         Buffer _channelBuffer;
         Buffer _convertBuffer;
         Buffer _effectBuffer;
+        Buffer _mixBuffer;
+        std::vector<AudioConverter> _converters;
+
+        std::recursive_mutex _mutex;
+        MixRingBuffer _mixRing;
+        std::thread _mixThread;
+        std::atomic<bool> _mixThreadStop { false };
+        std::mutex _mixThreadWaitMutex;
+        std::condition_variable _mixThreadCondition;
+
+        std::atomic<uint32> _mixedChunks { 0 };
+        std::atomic<uint32> _underruns { 0 };
+        std::atomic<uint64> _mixTimeTotal { 0 };
+        std::atomic<uint64> _mixTimeMax { 0 };
 
     public:
         AudioMixerImpl()
@@ -105,32 +232,19 @@ namespace OpenRCT2 { namespace Audio
         void Init(const char * device) override
         {
             Close();
-
-            SDL_AudioSpec want = { 0 };
-            want.freq = 44100;
-            want.format = AUDIO_S16SYS;
-            want.channels = 2;
-            want.samples = 1024;
-            want.callback = [](void * arg, uint8 * dst, sint32 length) -> void
-            {
-                auto mixer = static_cast<AudioMixerImpl *>(arg);
-                mixer->GetNextAudioChunk(dst, (size_t)length);
-            };
-            want.userdata = this;
-
-            SDL_AudioSpec have;
-            _deviceId = SDL_OpenAudioDevice(device, 0, &want, &have, 0);
-            _format.format = have.format;
-            _format.channels = have.channels;
-            _format.freq = have.freq;
-
-            LoadAllSounds();
-
-            SDL_PauseAudioDevice(_deviceId, 0);
+            OpenDevice(device);
+            _css1Path = context_get_path_legacy(PATH_ID_CSS1);
+            StartSoundPrefetch();
+            StartMixing();
         }
 
         void Close() override
         {
+            StopSoundPrefetch();
+            StopMixing();
+            SDL_CloseAudioDevice(_deviceId);
+            _deviceId = 0;
+
             // Free channels
             Lock();
             for (IAudioChannel * channel : _channels)
@@ -140,16 +254,17 @@ namespace OpenRCT2 { namespace Audio
             _channels.clear();
             Unlock();
 
-            SDL_CloseAudioDevice(_deviceId);
-
             // Free sources
-            for (size_t i = 0; i < Util::CountOf(_css1Sources); i++)
+            for (auto &entry : _css1Sources)
             {
-                if (_css1Sources[i] != _nullSource)
+                if (entry.Source != _nullSource)
                 {
-                    SafeDelete(_css1Sources[i]);
+                    SafeDelete(entry.Source);
                 }
+                entry.Source = nullptr;
+                entry.LastUsed = 0;
             }
+            _soundCacheSize = 0;
             for (size_t i = 0; i < Util::CountOf(_musicSources); i++)
             {
                 if (_musicSources[i] != _nullSource)
@@ -162,16 +277,83 @@ namespace OpenRCT2 { namespace Audio
             _channelBuffer.Free();
             _convertBuffer.Free();
             _effectBuffer.Free();
+            _mixBuffer.Free();
+            _converters.clear();
         }
 
+        /**
+         * Opens the audio device without loading any sounds or starting playback.
+         */
+        bool OpenDevice(const char * device)
+        {
+            SDL_AudioSpec want = { 0 };
+            want.freq = 44100;
+            want.format = AUDIO_S16SYS;
+            want.channels = 2;
+            want.samples = 1024;
+            want.callback = [](void * arg, uint8 * dst, sint32 length) -> void
+            {
+                auto mixer = static_cast<AudioMixerImpl *>(arg);
+                mixer->ReadMixedAudio(dst, (size_t)length);
+            };
+            want.userdata = this;
+
+            SDL_AudioSpec have = { 0 };
+            _deviceId = SDL_OpenAudioDevice(device, 0, &want, &have, 0);
+            _format.format = have.format;
+            _format.channels = have.channels;
+            _format.freq = have.freq;
+            _chunkLength = have.size;
+            _silence = have.silence;
+            return _deviceId != 0;
+        }
+
+        /**
+         * Starts the mixing thread and unpauses the audio device.
+         */
+        void StartMixing()
+        {
+            if (_deviceId == 0 || _chunkLength == 0)
+            {
+                return;
+            }
+
+            _mixBuffer.EnsureCapacity(_chunkLength);
+            _mixRing.Reset(_chunkLength * MIX_AHEAD_CHUNKS);
+            _mixThreadStop = false;
+            _mixThread = std::thread([this]() -> void
+            {
+                MixThreadLoop();
+            });
+
+            SDL_PauseAudioDevice(_deviceId, 0);
+        }
+
+        void StopMixing()
+        {
+            if (_mixThread.joinable())
+            {
+                _mixThreadStop = true;
+                _mixThreadCondition.notify_one();
+                _mixThread.join();
+            }
+        }
+
+        uint32 GetMixedChunks() const { return _mixedChunks; }
+        uint32 GetUnderruns() const { return _underruns; }
+        uint64 GetMixTimeTotal() const { return _mixTimeTotal; }
+        uint64 GetMixTimeMax() const { return _mixTimeMax; }
+        size_t GetChunkLength() const { return _chunkLength; }
+        const AudioFormat &GetFormat() const { return _format; }
+
         void Lock() override
         {
-            SDL_LockAudioDevice(_deviceId);
+            _mutex.lock();
         }
 
         void Unlock() override
         {
-            SDL_UnlockAudioDevice(_deviceId);
+            _mutex.unlock();
         }
 
         IAudioChannel * Play(IAudioSource * source, sint32 loop, bool deleteondone, bool deletesourceondone) override
@@ -205,7 +387,7 @@ namespace OpenRCT2 { namespace Audio
                 if (source == nullptr)
                 {
                     const utf8 * path = context_get_path_legacy((sint32)pathId);
-                    source = AudioSource::CreateMemoryFromWAV(path, &_format);
+                    source = AudioSource::CreateStreamFromWAV(path);
                     if (source == nullptr)
                     {
                         source = _nullSource;
@@ -224,7 +406,26 @@ namespace OpenRCT2 { namespace Audio
 
         IAudioSource * GetSoundSource(sint32 id) override
         {
-            return _css1Sources[id];
+            IAudioSource * source;
+            {
+                std::lock_guard<std::mutex> lock(_soundCacheMutex);
+                SoundCacheEntry &entry = _css1Sources[id];
+                if (entry.Source == nullptr)
+                {
+                    // Not prefetched yet, load it now
+                    StoreSound(entry, LoadSound(id));
+                }
+                entry.LastUsed = ++_soundCacheTick;
+                source = entry.Source;
+            }
+
+            Lock();
+            {
+                std::lock_guard<std::mutex> lock(_soundCacheMutex);
+                TrimSoundCache(id);
+            }
+            Unlock();
+            return source;
         }
 
         IAudioSource * GetMusicSource(sint32 id) override
@@ -233,21 +434,165 @@ namespace OpenRCT2 { namespace Audio
         }
 
     private:
-        void LoadAllSounds()
+        IAudioSource * LoadSound(size_t id)
         {
-            const utf8 * css1Path = context_get_path_legacy(PATH_ID_CSS1);
-            for (size_t i = 0; i < Util::CountOf(_css1Sources); i++)
+            IAudioSource * source = AudioSource::CreateMemoryFromCSS1(_css1Path, id, &_format);
+            if (source == nullptr)
             {
-                auto source = AudioSource::CreateMemoryFromCSS1(css1Path, i, &_format);
-                if (source == nullptr)
+                source = _nullSource;
+            }
+            return source;
+        }
+
+        /**
+         * Stores a loaded sound in its cache entry. Caller must hold _soundCacheMutex.
+         */
+        void StoreSound(SoundCacheEntry &entry, IAudioSource * source)
+        {
+            entry.Source = source;
+            if (source != _nullSource)
+            {
+                _soundCacheSize += (size_t)source->GetLength();
+            }
+        }
+
+        /**
+         * Unloads the least recently used sounds that are not playing until the cache is within budget.
+         * Caller must hold the mixer lock and _soundCacheMutex.
+         */
+        void TrimSoundCache(size_t keepId)
+        {
+            while (_soundCacheSize > SOUND_CACHE_BUDGET)
+            {
+                SoundCacheEntry * oldest = nullptr;
+                for (size_t i = 0; i < Util::CountOf(_css1Sources); i++)
+                {
+                    SoundCacheEntry &entry = _css1Sources[i];
+                    if (i != keepId &&
+                        entry.Source != nullptr &&
+                        entry.Source != _nullSource &&
+                        (oldest == nullptr || entry.LastUsed < oldest->LastUsed) &&
+                        !IsSourcePlaying(entry.Source))
+                    {
+                        oldest = &entry;
+                    }
+                }
+                if (oldest == nullptr)
                 {
-                    source = _nullSource;
+                    break;
                 }
-                _css1Sources[i] = source;
+                _soundCacheSize -= (size_t)oldest->Source->GetLength();
+                SafeDelete(oldest->Source);
             }
         }
 
-        void GetNextAudioChunk(uint8 * dst, size_t length)
+        bool IsSourcePlaying(const IAudioSource * source) const
+        {
+            for (const ISDLAudioChannel * channel : _channels)
+            {
+                if (channel->GetSource() == source)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Loads sounds in the background until the cache budget is reached, so that most sounds are
+         * ready before they are first played without holding up start up.
+         */
+        void StartSoundPrefetch()
+        {
+            _soundPrefetchStop = false;
+            _soundPrefetchThread = std::thread([this]() -> void
+            {
+                for (size_t i = 0; i < Util::CountOf(_css1Sources) && !_soundPrefetchStop; i++)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_soundCacheMutex);
+                        if (_soundCacheSize >= SOUND_CACHE_BUDGET)
+                        {
+                            break;
+                        }
+                        if (_css1Sources[i].Source != nullptr)
+                        {
+                            continue;
+                        }
+                    }
+
+                    IAudioSource * source = LoadSound(i);
+
+                    std::lock_guard<std::mutex> lock(_soundCacheMutex);
+                    if (_css1Sources[i].Source == nullptr)
+                    {
+                        StoreSound(_css1Sources[i], source);
+                    }
+                    else if (source != _nullSource)
+                    {
+                        // Played and loaded on demand in the meantime
+                        delete source;
+                    }
+                }
+            });
+        }
+
+        void StopSoundPrefetch()
+        {
+            if (_soundPrefetchThread.joinable())
+            {
+                _soundPrefetchStop = true;
+                _soundPrefetchThread.join();
+            }
+        }
+
+        void MixThreadLoop()
+        {
+            while (!_mixThreadStop)
+            {
+                if (_mixRing.GetFreeSpace() >= _chunkLength)
+                {
+                    auto startTime = std::chrono::high_resolution_clock::now();
+                    Lock();
+                    MixChunk((uint8 *)_mixBuffer.GetData(), _chunkLength);
+                    Unlock();
+                    auto mixTime = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+                    _mixRing.Write(_mixBuffer.GetData(), _chunkLength);
+                    _mixedChunks++;
+                    _mixTimeTotal += mixTime;
+                    if (mixTime > _mixTimeMax)
+                    {
+                        _mixTimeMax = mixTime;
+                    }
+                }
+                else
+                {
+                    // The callback notifies us after every read, the timeout only covers a missed wake up
+                    std::unique_lock<std::mutex> lock(_mixThreadWaitMutex);
+                    _mixThreadCondition.wait_for(lock, std::chrono::milliseconds(5), [this]() -> bool
+                    {
+                        return _mixThreadStop || _mixRing.GetFreeSpace() >= _chunkLength;
+                    });
+                }
+            }
+        }
+
+        /**
+         * Called from the SDL audio callback, copies out audio already mixed by the mixing thread.
+         */
+        void ReadMixedAudio(uint8 * dst, size_t length)
+        {
+            size_t bytesRead = _mixRing.Read(dst, length);
+            if (bytesRead < length)
+            {
+                Memory::Set(dst + bytesRead, _silence, length - bytesRead);
+                _underruns++;
+            }
+            _mixThreadCondition.notify_one();
+        }
+
+        void MixChunk(uint8 * dst, size_t length)
         {
             UpdateAdjustedSound();
 
@@ -307,11 +652,14 @@ namespace OpenRCT2 { namespace Audio
             AudioFormat streamformat = channel->GetFormat();
             if (streamformat != _format)
             {
-                if (SDL_BuildAudioCVT(&cvt, streamformat.format, streamformat.channels, streamformat.freq, _format.format, _format.channels, _format.freq) == -1)
+                const SDL_AudioCVT * converter = GetConverter(streamformat);
+                if (converter == nullptr)
                 {
                     // Unable to convert channel data
                     return;
                 }
+                // SDL_ConvertAudio writes to the structure, so work on a copy
+                cvt = *converter;
                 mustConvert = true;
             }
 
@@ -363,11 +711,42 @@ namespace OpenRCT2 { namespace Audio
 
             // Finally mix on to destination buffer
             size_t dstLength = Math::Min(length, bufferLen);
-            SDL_MixAudioFormat(data, (const uint8 *)buffer, _format.format, (uint32)dstLength, mixVolume);
+            if (_format.format == AUDIO_S16SYS)
+            {
+                if (mixVolume != 0)
+                {
+                    MixS16((sint16 *)data, (const sint16 *)buffer, dstLength / sizeof(sint16), mixVolume);
+                }
+            }
+            else
+            {
+                SDL_MixAudioFormat(data, (const uint8 *)buffer, _format.format, (uint32)dstLength, mixVolume);
+            }
 
             channel->UpdateOldVolume();
         }
 
+        /**
+         * Gets the cached converter from the given format to the output format, building it on first use.
+         * Returns nullptr if SDL cannot convert between the two.
+         */
+        const SDL_AudioCVT * GetConverter(const AudioFormat &srcFormat)
+        {
+            for (const auto &converter : _converters)
+            {
+                if (converter.Format == srcFormat)
+                {
+                    return converter.Valid ? &converter.CVT : nullptr;
+                }
+            }
+
+            AudioConverter converter;
+            converter.Format = srcFormat;
+            converter.Valid = SDL_BuildAudioCVT(&converter.CVT, srcFormat.format, srcFormat.channels, srcFormat.freq, _format.format, _format.channels, _format.freq) != -1;
+            _converters.push_back(converter);
+            return converter.Valid ? &_converters.back().CVT : nullptr;
+        }
+
         /**
          * Resample the given buffer into _effectBuffer.
          * Assumes that srcBuffer is the same format as _format.
@@ -466,7 +845,27 @@ namespace OpenRCT2 { namespace Audio
             const float d_left = dt * (channel->GetVolumeL() - channel->GetOldVolumeL());
             const float d_right = dt * (channel->GetVolumeR() - channel->GetOldVolumeR());
 
-            for (sint32 i = 0; i < length * 2; i += 2)
+            sint32 i = 0;
+#ifdef OPENRCT2_AUDIO_SSE2
+            // Four frames per iteration, each lane carries the volume the scalar loop would reach for its frame
+            const __m128 step = _mm_set_ps(d_right * 4, d_left * 4, d_right * 4, d_left * 4);
+            __m128 volumeLo = _mm_set_ps(volumeR + d_right, volumeL + d_left, volumeR, volumeL);
+            __m128 volumeHi = _mm_set_ps(volumeR + d_right * 3, volumeL + d_left * 3, volumeR + d_right * 2, volumeL + d_left * 2);
+            for (; i + 8 <= length * 2; i += 8)
+            {
+                __m128i samples = _mm_loadu_si128((const __m128i *)&data[i]);
+                __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+                __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+                lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(lo), volumeLo));
+                hi = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(hi), volumeHi));
+                _mm_storeu_si128((__m128i *)&data[i], _mm_packs_epi32(lo, hi));
+                volumeLo = _mm_add_ps(volumeLo, step);
+                volumeHi = _mm_add_ps(volumeHi, step);
+            }
+            volumeL += d_left * (i / 2);
+            volumeR += d_right * (i / 2);
+#endif
+            for (; i < length * 2; i += 2)
             {
                 data[i] = (sint16)(data[i] * volumeL);
                 data[i + 1] = (sint16)(data[i + 1] * volumeR);
@@ -496,13 +895,64 @@ namespace OpenRCT2 { namespace Audio
 
             float startvolume_f = (float)startvolume / SDL_MIX_MAXVOLUME;
             float endvolume_f = (float)endvolume / SDL_MIX_MAXVOLUME;
-            for (sint32 i = 0; i < length; i++)
+            sint32 i = 0;
+#ifdef OPENRCT2_AUDIO_SSE2
+            const __m128 startVolume = _mm_set1_ps(startvolume_f);
+            const __m128 endVolume = _mm_set1_ps(endvolume_f);
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 step = _mm_set1_ps(8.0f / length);
+            __m128 tLo = _mm_set_ps(3.0f / length, 2.0f / length, 1.0f / length, 0.0f);
+            __m128 tHi = _mm_set_ps(7.0f / length, 6.0f / length, 5.0f / length, 4.0f / length);
+            for (; i + 8 <= length; i += 8)
+            {
+                __m128 volumeLo = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, tLo), startVolume), _mm_mul_ps(tLo, endVolume));
+                __m128 volumeHi = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, tHi), startVolume), _mm_mul_ps(tHi, endVolume));
+                __m128i samples = _mm_loadu_si128((const __m128i *)&data[i]);
+                __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+                __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+                lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(lo), volumeLo));
+                hi = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(hi), volumeHi));
+                _mm_storeu_si128((__m128i *)&data[i], _mm_packs_epi32(lo, hi));
+                tLo = _mm_add_ps(tLo, step);
+                tHi = _mm_add_ps(tHi, step);
+            }
+#endif
+            for (; i < length; i++)
             {
                 float t = (float)i / length;
                 data[i] = (sint16)(data[i] * ((1 - t) * startvolume_f + t * endvolume_f));
             }
         }
 
+        /**
+         * Same result as SDL_MixAudioFormat for AUDIO_S16SYS.
+         */
+        static void MixS16(sint16 * dst, const sint16 * src, size_t count, sint32 volume)
+        {
+            size_t i = 0;
+#ifdef OPENRCT2_AUDIO_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i mixVolume = _mm_set1_epi32(volume);
+            const __m128i roundToZero = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i samples = _mm_loadu_si128((const __m128i *)&src[i]);
+                __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(samples, zero), mixVolume);
+                __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(samples, zero), mixVolume);
+                // Divide by SDL_MIX_MAXVOLUME, truncating towards zero like integer division
+                lo = _mm_srai_epi32(_mm_add_epi32(lo, _mm_and_si128(_mm_srai_epi32(lo, 31), roundToZero)), 7);
+                hi = _mm_srai_epi32(_mm_add_epi32(hi, _mm_and_si128(_mm_srai_epi32(hi, 31), roundToZero)), 7);
+                __m128i mixed = _mm_adds_epi16(_mm_loadu_si128((const __m128i *)&dst[i]), _mm_packs_epi32(lo, hi));
+                _mm_storeu_si128((__m128i *)&dst[i], mixed);
+            }
+#endif
+            for (; i < count; i++)
+            {
+                sint32 sample = dst[i] + (src[i] * volume) / SDL_MIX_MAXVOLUME;
+                dst[i] = (sint16)Math::Clamp<sint32>(INT16_MIN, sample, INT16_MAX);
+            }
+        }
+
         static void EffectFadeU8(uint8* data, sint32 length, sint32 startvolume, sint32 endvolume)
         {
             static_assert(SDL_MIX_MAXVOLUME == MIXER_VOLUME_MAX, "Max volume differs between OpenRCT2 and SDL2");
@@ -541,4 +991,152 @@ namespace OpenRCT2 { namespace Audio
     {
         return new AudioMixerImpl();
     }
+
+    static std::vector<uint8> CreateBenchmarkWAV(uint32 frequency, uint16 channels, uint16 bitsPerSample)
+    {
+        uint16 blockAlign = channels * (bitsPerSample / 8);
+        uint32 dataLength = frequency * blockAlign;
+
+        WaveFormat waveFormat;
+        waveFormat.encoding = 0x0001;
+        waveFormat.channels = channels;
+        waveFormat.frequency = frequency;
+        waveFormat.byterate = frequency * blockAlign;
+        waveFormat.blockalign = blockAlign;
+        waveFormat.bitspersample = bitsPerSample;
+
+        std::vector<uint8> data;
+        auto append = [&data](const void * src, size_t length) -> void
+        {
+            data.insert(data.end(), (const uint8 *)src, (const uint8 *)src + length);
+        };
+        auto appendLE32 = [&append](uint32 value) -> void
+        {
+            value = SDL_SwapLE32(value);
+            append(&value, sizeof(value));
+        };
+        append("RIFF", 4);
+        appendLE32((uint32)(4 + 8 + sizeof(waveFormat) + 8 + dataLength));
+        append("WAVE", 4);
+        append("fmt ", 4);
+        appendLE32((uint32)sizeof(waveFormat));
+        append(&waveFormat, sizeof(waveFormat));
+        append("data", 4);
+        appendLE32(dataLength);
+
+        // One second of a triangle wave
+        for (uint32 i = 0; i < frequency; i++)
+        {
+            sint32 phase = (sint32)((i * 440 * 2 * 256) / frequency) % 512;
+            sint32 amplitude = (phase < 256 ? phase : 511 - phase) - 128;
+            for (uint16 c = 0; c < channels; c++)
+            {
+                if (bitsPerSample == 8)
+                {
+                    data.push_back((uint8)(amplitude + 128));
+                }
+                else
+                {
+                    sint16 sample = (sint16)SDL_SwapLE16((uint16)(amplitude * 64));
+                    append(&sample, sizeof(sample));
+                }
+            }
+        }
+        return data;
+    }
+
+    bool AudioMixer::RunBenchmark(sint32 numChannels, sint32 seconds)
+    {
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
+        {
+            Console::Error::WriteLine("Unable to initialise SDL audio: %s", SDL_GetError());
+            return false;
+        }
+
+        bool result = false;
+        {
+            AudioMixerImpl mixer;
+            if (mixer.OpenDevice(nullptr))
+            {
+                // One source for each path through the mixer: native, converted and resampled, 8-bit mono
+                std::vector<uint8> wavData[] =
+                {
+                    CreateBenchmarkWAV(44100, 2, 16),
+                    CreateBenchmarkWAV(22050, 1, 16),
+                    CreateBenchmarkWAV(11025, 1, 8),
+                };
+                std::vector<IAudioSource *> sources;
+                for (const auto &data : wavData)
+                {
+                    IAudioSource * source = AudioSource::CreateStreamFromWAV(SDL_RWFromConstMem(data.data(), (sint32)data.size()));
+                    if (source != nullptr)
+                    {
+                        sources.push_back(source);
+                    }
+                }
+
+                if (sources.size() == Util::CountOf(wavData))
+                {
+                    std::vector<IAudioChannel *> channels;
+                    for (sint32 i = 0; i < numChannels; i++)
+                    {
+                        IAudioChannel * channel = mixer.Play(sources[i % sources.size()], MIXER_LOOP_INFINITE, false, false);
+                        if (channel != nullptr)
+                        {
+                            channel->SetVolume(MIXER_VOLUME_MAX / 2);
+                            channel->SetPan((float)i / numChannels);
+                            channel->SetRate(0.8 + (i % 8) * 0.05);
+                            channels.push_back(channel);
+                        }
+                    }
+
+                    mixer.StartMixing();
+
+                    // Move the channels around as vehicles would so that the pan and fade effects run
+                    auto startTime = std::chrono::steady_clock::now();
+                    for (sint32 tick = 0; std::chrono::steady_clock::now() - startTime < std::chrono::seconds(seconds); tick++)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+                        mixer.Lock();
+                        for (size_t i = 0; i < channels.size(); i++)
+                        {
+                            channels[i]->SetPan((float)((tick + i) % 32) / 31);
+                            channels[i]->SetVolume((tick + i) % 2 == 0 ? MIXER_VOLUME_MAX / 2 : MIXER_VOLUME_MAX / 4);
+                        }
+                        mixer.Unlock();
+                    }
+                    mixer.StopMixing();
+
+                    const AudioFormat &format = mixer.GetFormat();
+                    double chunkTime = (1000.0 * mixer.GetChunkLength()) / (format.GetByteRate() * format.freq);
+                    uint32 mixedChunks = mixer.GetMixedChunks();
+                    double averageTime = mixedChunks == 0 ? 0 : mixer.GetMixTimeTotal() / 1000000.0 / mixedChunks;
+                    double worstTime = mixer.GetMixTimeMax() / 1000000.0;
+                    Console::WriteLine("Mixed %u chunks of %.1f ms from %d channels.", mixedChunks, chunkTime, numChannels);
+                    Console::WriteLine("Mix time per chunk: %.3f ms average, %.3f ms worst (%.1f%% of real time).",
+                        averageTime, worstTime, (100.0 * averageTime) / chunkTime);
+                    Console::WriteLine("Underruns: %u", mixer.GetUnderruns());
+                    result = true;
+                }
+                else
+                {
+                    Console::Error::WriteLine("Unable to create benchmark audio sources.");
+                }
+
+                mixer.Close();
+                for (IAudioSource * source : sources)
+                {
+                    delete source;
+                }
+            }
+            else
+            {
+                Console::Error::WriteLine("Unable to open audio device: %s", SDL_GetError());
+            }
+        }
+
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return result;
+    }
 } }
@@ -16,7 +16,10 @@
 
 #include <openrct2/common.h>
 #include <SDL.h>
+#include <future>
+#include <vector>
 #include <openrct2/core/Math.hpp>
+#include <openrct2/core/Memory.hpp>
 #include <openrct2/audio/AudioSource.h>
 #include "AudioContext.h"
 #include "AudioFormat.h"
@@ -25,16 +28,33 @@ namespace OpenRCT2 { namespace Audio
 {
     /**
      * An audio source where raw PCM data is streamed directly from
-     * a file.
+     * a file. The block following the one being played is read in the
+     * background so the mixer rarely has to wait for the disk.
      */
     class FileAudioSource final : public ISDLAudioSource
     {
     private:
+        static constexpr size_t READ_AHEAD_SIZE = 128 * 1024;
+
+        struct DataBlock
+        {
+            uint64             Offset = 0;
+            std::vector<uint8> Data;
+
+            bool Contains(uint64 offset) const
+            {
+                return offset >= Offset && offset < Offset + Data.size();
+            }
+        };
+
         AudioFormat _format = { 0 };
         SDL_RWops * _rw = nullptr;
         uint64      _dataBegin = 0;
         uint64      _dataLength = 0;
 
+        DataBlock              _block;
+        std::future<DataBlock> _nextBlock;
+
     public:
         ~FileAudioSource()
         {
@@ -54,20 +74,23 @@ namespace OpenRCT2 { namespace Audio
         size_t Read(void * dst, uint64 offset, size_t len) override
         {
             size_t bytesRead = 0;
-            sint64 currentPosition = SDL_RWtell(_rw);
-            if (currentPosition != -1)
+            while (bytesRead < len && offset < _dataLength)
             {
-                size_t bytesToRead = (size_t)Math::Min<uint64>(len, _dataLength - offset);
-                sint64 dataOffset = _dataBegin + offset;
-                if (currentPosition != dataOffset)
+                if (!_block.Contains(offset))
                 {
-                    sint64 newPosition = SDL_RWseek(_rw, dataOffset, SEEK_SET);
-                    if (newPosition == -1)
+                    _block = FetchBlock(offset);
+                    if (!_block.Contains(offset))
                     {
-                        return 0;
+                        break;
                     }
+                    ReadAhead(_block.Offset + _block.Data.size());
                 }
-                bytesRead = SDL_RWread(_rw, dst, 1, bytesToRead);
+
+                size_t blockOffset = (size_t)(offset - _block.Offset);
+                size_t bytesToCopy = Math::Min(len - bytesRead, _block.Data.size() - blockOffset);
+                Memory::Copy((uint8 *)dst + bytesRead, _block.Data.data() + blockOffset, bytesToCopy);
+                bytesRead += bytesToCopy;
+                offset += bytesToCopy;
             }
             return bytesRead;
         }
@@ -145,6 +168,9 @@ namespace OpenRCT2 { namespace Audio
 
             _dataLength = dataChunkSize;
             _dataBegin = SDL_RWtell(rw);
+
+            // Start reading now so the first mix does not wait on the disk
+            ReadAhead(0);
             return true;
         }
 
@@ -174,8 +200,65 @@ namespace OpenRCT2 { namespace Audio
             return 0;
         }
 
+        /**
+         * Gets the block starting at the given offset, from the read ahead if it has it.
+         */
+        DataBlock FetchBlock(uint64 offset)
+        {
+            if (_nextBlock.valid())
+            {
+                // Always collect the read ahead, it is using the file
+                DataBlock block = _nextBlock.get();
+                if (block.Contains(offset))
+                {
+                    return block;
+                }
+            }
+            return ReadBlock(offset);
+        }
+
+        /**
+         * Starts reading the block at the given offset in the background, wrapping to the start for looping channels.
+         */
+        void ReadAhead(uint64 offset)
+        {
+            if (offset >= _dataLength)
+            {
+                offset = 0;
+            }
+            if (_nextBlock.valid())
+            {
+                _nextBlock.wait();
+            }
+            _nextBlock = std::async(std::launch::async, [this, offset]() -> DataBlock
+            {
+                return ReadBlock(offset);
+            });
+        }
+
+        DataBlock ReadBlock(uint64 offset)
+        {
+            DataBlock block;
+            block.Offset = offset;
+            size_t blockLength = (size_t)Math::Min<uint64>(READ_AHEAD_SIZE, _dataLength - offset);
+            if (SDL_RWseek(_rw, _dataBegin + offset, RW_SEEK_SET) != -1)
+            {
+                block.Data.resize(blockLength);
+                size_t bytesRead = SDL_RWread(_rw, block.Data.data(), 1, blockLength);
+                block.Data.resize(bytesRead);
+            }
+            return block;
+        }
+
         void Unload()
         {
+            if (_nextBlock.valid())
+            {
+                _nextBlock.wait();
+                _nextBlock = std::future<DataBlock>();
+            }
+            _block = DataBlock();
+
             if (_rw != nullptr)
             {
                 SDL_RWclose(_rw);
@@ -14,11 +14,13 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <openrct2/common.h>
 #include <SDL.h>
 #include <openrct2/config/Config.h>
+#include <openrct2/drawing/Drawing.h>
 #include <openrct2/drawing/IDrawingEngine.h>
 #include <openrct2/drawing/X8DrawingEngine.h>
 #include <openrct2/ui/UiContext.h>
@@ -37,6 +39,12 @@ class HardwareDisplayDrawingEngine final : public X8DrawingEngine
 private:
     constexpr static uint32 DIRTY_VISUAL_TIME = 32;
 
+    struct DirtyVisual
+    {
+        DirtyRect   Rect;
+        uint32      TimeLeft;
+    };
+
     IUiContext * const  _uiContext;
     SDL_Window *        _window                     = nullptr;
     SDL_Renderer *      _sdlRenderer                = nullptr;
@@ -55,7 +63,8 @@ private:
     bool    _pausedBeforeOverlay    = false;
     bool    _useVsync               = true;
 
-    std::vector<uint32> _dirtyVisualsTime;
+    std::vector<DirtyVisual> _dirtyVisuals;
+    std::vector<PresentRect> _presentRects;
     
     bool    smoothNN = false;
 
@@ -160,6 +169,7 @@ public:
             {
                 _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].red, palette[i].green, palette[i].blue);
             }
+            MarkPresentDirtyAll();
 
 #ifdef __ENABLE_LIGHTFX__
             if (gConfigGeneral.enable_light_fx)
@@ -185,19 +195,11 @@ public:
     }
 
 protected:
-    void OnDrawDirtyBlock(uint32 left, uint32 top, uint32 columns, uint32 rows) override
+    void OnDrawDirtyRect(const DirtyRect &rect) override
     {
         if (gShowDirtyVisuals)
         {
-            uint32 right = left + columns;
-            uint32 bottom = top + rows;
-            for (uint32 x = left; x < right; x++)
-            {
-                for (uint32 y = top; y < bottom; y++)
-                {
-                    SetDirtyVisualTime(x, y, DIRTY_VISUAL_TIME);
-                }
-            }
+            _dirtyVisuals.push_back({ rect, DIRTY_VISUAL_TIME });
         }
     }
 
@@ -218,7 +220,7 @@ private:
         else
 #endif
         {
-            CopyBitsToTexture(_screenTexture, _bits, (sint32)_width, (sint32)_height, _paletteHWMapped);
+            CopyDirtyBitsToTexture();
         }
         if (smoothNN)
         {
@@ -252,6 +254,44 @@ private:
         }
     }
 
+    /**
+     * Converts only the parts of the screen that have changed since the last frame. The texture keeps the
+     * rest from previous frames.
+     */
+    void CopyDirtyBitsToTexture()
+    {
+        GetPresentDirtyRects(&_presentRects);
+        if (_presentRects.empty())
+        {
+            return;
+        }
+
+        if (SDL_BYTESPERPIXEL(_screenTextureFormat->format) != 4)
+        {
+            CopyBitsToTexture(_screenTexture, _bits, (sint32)_width, (sint32)_height, _paletteHWMapped);
+            return;
+        }
+
+        for (const auto &rect : _presentRects)
+        {
+            SDL_Rect textureRect = { (sint32)rect.X, (sint32)rect.Y, (sint32)rect.Width, (sint32)rect.Height };
+            void *  pixels;
+            sint32  pitch;
+            if (SDL_LockTexture(_screenTexture, &textureRect, &pixels, &pitch) == 0)
+            {
+                const uint8 * src = _bits + (rect.Y * _pitch) + rect.X;
+                uint8 * dst = (uint8 *)pixels;
+                for (uint32 y = 0; y < rect.Height; y++)
+                {
+                    palette_to_32bpp_fn(src, (uint32 *)dst, (sint32)rect.Width, _paletteHWMapped);
+                    src += _pitch;
+                    dst += pitch;
+                }
+                SDL_UnlockTexture(_screenTexture);
+            }
+        }
+    }
+
     void CopyBitsToTexture(SDL_Texture * texture, uint8 * src, sint32 width, sint32 height, const uint32 * palette)
     {
         void *  pixels;
@@ -261,11 +301,7 @@ private:
             sint32 padding = pitch - (width * 4);
             if (pitch == width * 4)
             {
-                uint32 * dst = (uint32 *)pixels;
-                for (sint32 i = width * height; i > 0; i--)
-                {
-                    *dst++ = palette[*src++];
-                }
+                palette_to_32bpp_fn(src, (uint32 *)pixels, width * height, palette);
             }
             else
             {
@@ -300,40 +336,16 @@ private:
         }
     }
 
-    uint32 GetDirtyVisualTime(uint32 x, uint32 y)
-    {
-        uint32 result = 0;
-        uint32 i = y * _dirtyGrid.BlockColumns + x;
-        if (_dirtyVisualsTime.size() > i)
-        {
-            result = _dirtyVisualsTime[i];
-        }
-        return result;
-    }
-
-    void SetDirtyVisualTime(uint32 x, uint32 y, uint32 value)
-    {
-        uint32 i = y * _dirtyGrid.BlockColumns + x;
-        if (_dirtyVisualsTime.size() > i)
-        {
-            _dirtyVisualsTime[i] = value;
-        }
-    }
-
     void UpdateDirtyVisuals()
     {
-        _dirtyVisualsTime.resize(_dirtyGrid.BlockRows * _dirtyGrid.BlockColumns);
-        for (uint32 y = 0; y < _dirtyGrid.BlockRows; y++)
+        for (auto &visual : _dirtyVisuals)
         {
-            for (uint32 x = 0; x < _dirtyGrid.BlockColumns; x++)
-            {
-                auto timeLeft = GetDirtyVisualTime(x, y);
-                if (timeLeft > 0)
-                {
-                    SetDirtyVisualTime(x, y, timeLeft - 1);
-                }
-            }
+            visual.TimeLeft--;
         }
+        _dirtyVisuals.erase(std::remove_if(_dirtyVisuals.begin(), _dirtyVisuals.end(), [](const DirtyVisual &visual) -> bool
+        {
+            return visual.TimeLeft == 0;
+        }), _dirtyVisuals.end());
     }
 
     void RenderDirtyVisuals()
@@ -342,25 +354,18 @@ private:
         float scaleY = gConfigGeneral.window_scale;
 
         SDL_SetRenderDrawBlendMode(_sdlRenderer, SDL_BLENDMODE_BLEND);
-        for (uint32 y = 0; y < _dirtyGrid.BlockRows; y++)
+        for (const auto &visual : _dirtyVisuals)
         {
-            for (uint32 x = 0; x < _dirtyGrid.BlockColumns; x++)
-            {
-                auto timeLeft = GetDirtyVisualTime(x, y);
-                if (timeLeft > 0)
-                {
-                    uint8 alpha = (uint8)(timeLeft * 5 / 2);
+            uint8 alpha = (uint8)(visual.TimeLeft * 5 / 2);
 
-                    SDL_Rect ddRect;
-                    ddRect.x = (sint32)(x * _dirtyGrid.BlockWidth * scaleX);
-                    ddRect.y = (sint32)(y * _dirtyGrid.BlockHeight * scaleY);
-                    ddRect.w = (sint32)(_dirtyGrid.BlockWidth * scaleX);
-                    ddRect.h = (sint32)(_dirtyGrid.BlockHeight * scaleY);
+            SDL_Rect ddRect;
+            ddRect.x = (sint32)(visual.Rect.Left * scaleX);
+            ddRect.y = (sint32)(visual.Rect.Top * scaleY);
+            ddRect.w = (sint32)((visual.Rect.Right - visual.Rect.Left) * scaleX);
+            ddRect.h = (sint32)((visual.Rect.Bottom - visual.Rect.Top) * scaleY);
 
-                    SDL_SetRenderDrawColor(_sdlRenderer, 255, 255, 255, alpha);
-                    SDL_RenderFillRect(_sdlRenderer, &ddRect);
-                }
-            }
+            SDL_SetRenderDrawColor(_sdlRenderer, 255, 255, 255, alpha);
+            SDL_RenderFillRect(_sdlRenderer, &ddRect);
         }
     }
 
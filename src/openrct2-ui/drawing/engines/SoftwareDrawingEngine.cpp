@@ -14,6 +14,7 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <vector>
 #include <openrct2/common.h>
 #include <SDL.h>
 #include <openrct2/config/Config.h>
@@ -39,6 +40,9 @@ private:
     SDL_Surface *       _RGBASurface    = nullptr;
     SDL_Palette *       _palette        = nullptr;
 
+    std::vector<PresentRect>    _presentRects;
+    std::vector<SDL_Rect>       _windowRects;
+
 public:
     explicit SoftwareDrawingEngine(IUiContext * uiContext)
         : X8DrawingEngine(uiContext),
@@ -99,6 +103,7 @@ public:
                 colours[i].a = palette[i].alpha;
             }
             SDL_SetPaletteColors(_palette, colours, 0, 256);
+            MarkPresentDirtyAll();
         }
     }
 
@@ -110,6 +115,12 @@ public:
 private:
     void Display()
     {
+        GetPresentDirtyRects(&_presentRects);
+        if (_presentRects.empty())
+        {
+            return;
+        }
+
         // Lock the surface before setting its pixels
         if (SDL_MUSTLOCK(_surface))
         {
@@ -120,8 +131,15 @@ private:
             }
         }
 
-        // Copy pixels from the virtual screen buffer to the surface
-        Memory::Copy<void>(_surface->pixels, _bits, _surface->pitch * _surface->h);
+        // Copy the changed pixels from the virtual screen buffer to the surface
+        for (const auto &rect : _presentRects)
+        {
+            for (uint32 y = rect.Y; y < rect.Y + rect.Height; y++)
+            {
+                size_t offset = (y * _surface->pitch) + rect.X;
+                Memory::Copy<uint8>((uint8 *)_surface->pixels + offset, _bits + offset, rect.Width);
+            }
+        }
 
         // Unlock the surface
         if (SDL_MUSTLOCK(_surface))
@@ -133,9 +151,21 @@ private:
         if (gConfigGeneral.window_scale == 1 || gConfigGeneral.window_scale <= 0)
         {
             SDL_Surface * windowSurface = SDL_GetWindowSurface(_window);
-            if (SDL_BlitSurface(_surface, nullptr, windowSurface, nullptr))
+            _windowRects.clear();
+            for (const auto &rect : _presentRects)
             {
-                log_fatal("SDL_BlitSurface %s", SDL_GetError());
+                SDL_Rect windowRect = { (sint32)rect.X, (sint32)rect.Y, (sint32)rect.Width, (sint32)rect.Height };
+                SDL_Rect blitRect = windowRect;
+                if (SDL_BlitSurface(_surface, &windowRect, windowSurface, &blitRect))
+                {
+                    log_fatal("SDL_BlitSurface %s", SDL_GetError());
+                    exit(1);
+                }
+                _windowRects.push_back(windowRect);
+            }
+            if (SDL_UpdateWindowSurfaceRects(_window, _windowRects.data(), (sint32)_windowRects.size()))
+            {
+                log_fatal("SDL_UpdateWindowSurfaceRects %s", SDL_GetError());
                 exit(1);
             }
         }
@@ -155,11 +185,11 @@ private:
                 log_fatal("SDL_BlitScaled %s", SDL_GetError());
                 exit(1);
             }
-        }
-        if (SDL_UpdateWindowSurface(_window))
-        {
-            log_fatal("SDL_UpdateWindowSurface %s", SDL_GetError());
-            exit(1);
+            if (SDL_UpdateWindowSurface(_window))
+            {
+                log_fatal("SDL_UpdateWindowSurface %s", SDL_GetError());
+                exit(1);
+            }
         }
     }
 };
@@ -323,6 +323,12 @@ public:
                        ->InvalidateImage(image);
     }
 
+    bool GetDirtyRegionStats(DirtyRegionStats * stats) override
+    {
+        // Everything is redrawn every frame
+        return false;
+    }
+
     rct_drawpixelinfo * GetDPI()
     {
         return &_bitsDPI;
@@ -0,0 +1,105 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <cstring>
+#include <openrct2/core/Guard.hpp>
+#include <openrct2/core/Math.hpp>
+#include <openrct2/Game.h>
+#include <openrct2/localisation/Localisation.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/platform/platform.h>
+#include "ScrollListModel.h"
+
+constexpr size_t ScrollListModel::MAX_TEXT_ARGS_SIZE;
+constexpr uint32 ScrollListModel::TEXT_CACHE_LIFETIME;
+
+ScrollListModel::ScrollListModel(sint32 rowHeight)
+    : _rowHeight(rowHeight)
+{
+}
+
+void ScrollListModel::Invalidate()
+{
+    _invalid = true;
+    _textCache.clear();
+}
+
+bool ScrollListModel::NeedsRefresh() const
+{
+    return _invalid || _refreshTick != gCurrentTicks || (game_is_paused() && _refreshFrame != gCurrentDrawCount);
+}
+
+void ScrollListModel::SetItems(std::vector<uint16> items)
+{
+    _items = std::move(items);
+    _invalid = false;
+    _refreshTick = gCurrentTicks;
+    _refreshFrame = gCurrentDrawCount;
+
+    // Forget the text of entities that are no longer in the list
+    if (_textCache.size() > _items.size() * 4)
+    {
+        _textCache.clear();
+    }
+}
+
+sint32 ScrollListModel::GetIndexAt(sint32 y) const
+{
+    if (y < 0)
+    {
+        return -1;
+    }
+    sint32 index = y / _rowHeight;
+    return index < GetCount() ? index : -1;
+}
+
+void ScrollListModel::GetVisibleRange(const rct_drawpixelinfo * dpi, sint32 offsetY, sint32 * first, sint32 * last) const
+{
+    sint32 top = dpi->y - offsetY;
+    sint32 bottom = top + dpi->height;
+    *first = Math::Clamp(0, top / _rowHeight - 1, GetCount());
+    *last = Math::Clamp(*first, bottom / _rowHeight + 1, GetCount());
+}
+
+void ScrollListModel::DrawText(rct_drawpixelinfo * dpi, uint16 item, uint8 column, rct_string_id format, const void * args,
+                               size_t argsSize, sint32 x, sint32 y, sint32 width)
+{
+    Guard::Assert(argsSize <= MAX_TEXT_ARGS_SIZE, "Too many format arguments for a list row");
+    argsSize = std::min(argsSize, MAX_TEXT_ARGS_SIZE);
+
+    uint32 now = platform_get_ticks();
+    CachedText * cached = &_textCache[(item << 8) | column];
+    if (cached->Format != format ||
+        cached->Width != width ||
+        memcmp(cached->Args, args, argsSize) != 0 ||
+        now - cached->Timestamp > TEXT_CACHE_LIFETIME)
+    {
+        utf8 buffer[256];
+        format_string(buffer, sizeof(buffer), format, (void *)args);
+        gfx_clip_string(buffer, width);
+
+        cached->Format = format;
+        cached->Width = width;
+        std::fill_n(cached->Args, MAX_TEXT_ARGS_SIZE, 0);
+        memcpy(cached->Args, args, argsSize);
+        cached->Timestamp = now;
+        cached->Text = buffer;
+    }
+
+    gCurrentFontSpriteBase = FONT_SPRITE_BASE_MEDIUM;
+    gfx_draw_string(dpi, (char *)cached->Text.c_str(), COLOUR_BLACK, x, y);
+}
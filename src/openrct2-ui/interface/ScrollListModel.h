@@ -0,0 +1,85 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <openrct2/common.h>
+#include <openrct2/drawing/Drawing.h>
+#include <openrct2/localisation/StringIds.h>
+
+/**
+ * The contents of a scroll list window (e.g. guests, staff or rides): the filtered and sorted entity indices shown in the
+ * list, which rows are visible and the formatted text of each row. The indices are refreshed at most once per game tick
+ * unless the list is invalidated, and row text is only formatted again when its arguments change or it has expired.
+ * While the game is paused the tick stands still, but staff can still be hired or fired and rides built or demolished,
+ * so the indices are then refreshed every frame instead.
+ */
+class ScrollListModel final
+{
+private:
+    static constexpr size_t     MAX_TEXT_ARGS_SIZE  = 16;
+    static constexpr uint32     TEXT_CACHE_LIFETIME = 1000; // ms
+
+    struct CachedText
+    {
+        rct_string_id   Format = STR_NONE;
+        uint8           Args[MAX_TEXT_ARGS_SIZE] = { 0 };
+        sint32          Width = 0;
+        uint32          Timestamp = 0;
+        std::string     Text;
+    };
+
+    sint32                                  _rowHeight;
+    std::vector<uint16>                     _items;
+    bool                                    _invalid = true;
+    uint32                                  _refreshTick = 0;
+    uint32                                  _refreshFrame = 0;
+    std::unordered_map<uint32, CachedText>  _textCache;
+
+public:
+    explicit ScrollListModel(sint32 rowHeight);
+
+    /**
+     * Forces the items to be refreshed and all row text to be formatted again.
+     */
+    void Invalidate();
+    bool NeedsRefresh() const;
+    void SetItems(std::vector<uint16> items);
+
+    const std::vector<uint16> & GetItems() const { return _items; }
+    sint32 GetCount() const { return (sint32)_items.size(); }
+    sint32 GetHeight() const { return GetCount() * _rowHeight; }
+
+    /**
+     * Gets the index of the row at the given y position within the scroll area, or -1 if there is no row.
+     */
+    sint32 GetIndexAt(sint32 y) const;
+
+    /**
+     * Gets the range of rows [first, last) that intersect the clip region of dpi, where row 0 starts at offsetY.
+     */
+    void GetVisibleRange(const rct_drawpixelinfo * dpi, sint32 offsetY, sint32 * first, sint32 * last) const;
+
+    /**
+     * Draws a left aligned, clipped string for the given entity and column, reusing the previously formatted text if
+     * the format and arguments have not changed.
+     */
+    void DrawText(rct_drawpixelinfo * dpi, uint16 item, uint8 column, rct_string_id format, const void * args,
+                  size_t argsSize, sint32 x, sint32 y, sint32 width);
+};
@@ -14,6 +14,9 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 #include <openrct2/config/Config.h>
 #include <openrct2-ui/windows/Window.h>
 
@@ -22,6 +25,7 @@
 #include <openrct2/localisation/Localisation.h>
 #include <openrct2/sprites.h>
 #include <openrct2-ui/interface/Dropdown.h>
+#include <openrct2-ui/interface/ScrollListModel.h>
 #include <openrct2/Context.h>
 #include <openrct2/util/Util.h>
 
@@ -151,16 +155,30 @@ static sint32 _window_guest_list_num_groups;        // 0x00F1AF22
 static bool _window_guest_list_tracking_only;
 static uint16 _window_guest_list_filter_arguments[4];
 
-static uint16 _window_guest_list_groups_num_guests[240];
-static uint32 _window_guest_list_groups_argument_1[240];
-static uint32 _window_guest_list_groups_argument_2[240];
-static uint8 _window_guest_list_groups_guest_faces[240 * 58];
-static uint8 _window_guest_list_group_index[240];
+#define GUEST_LIST_MAX_GROUPS 240
+#define GUEST_LIST_MAX_GROUP_FACES 56
+
+struct guest_group
+{
+    uint32 argument_1;
+    uint32 argument_2;
+    uint16 num_guests;
+    uint8 faces[GUEST_LIST_MAX_GROUP_FACES];
+};
+
+static std::vector<guest_group> _window_guest_list_groups;
+
+// Guests shown on the individual page
+static ScrollListModel _window_guest_list_model(SCROLLABLE_ROW_HEIGHT);
+static bool _window_guest_list_any_guest_in_filter;
 
 static char _window_guest_list_filter_name[32];
 
 static sint32 window_guest_list_is_peep_in_filter(rct_peep* peep);
 static void window_guest_list_find_groups();
+static void window_guest_list_find_visible_guests();
+static void window_guest_list_invalidate_visible_guests();
+static rct_peep * window_guest_list_get_visible_guest(sint32 index);
 
 static void get_arguments_from_peep(rct_peep *peep, uint32 *argument_1, uint32* argument_2);
 
@@ -215,6 +233,7 @@ rct_window * window_guest_list_open()
     window_guest_list_widgets[WIDX_FILTER_BY_NAME].type = WWT_FLATBTN;
     window_guest_list_widgets[WIDX_PAGE_DROPDOWN].type = WWT_EMPTY;
     window_guest_list_widgets[WIDX_PAGE_DROPDOWN_BUTTON].type = WWT_EMPTY;
+    window_guest_list_invalidate_visible_guests();
     window->var_492 = 0;
     window->min_width = 350;
     window->min_height = 330;
@@ -228,6 +247,7 @@ void window_guest_list_refresh_list()
 {
     _window_guest_list_last_find_groups_wait = 0;
     _window_guest_list_last_find_groups_tick = 0;
+    window_guest_list_invalidate_visible_guests();
     window_guest_list_find_groups();
 }
 
@@ -306,6 +326,7 @@ rct_window * window_guest_list_open_with_filter(sint32 type, sint32 index)
     }
     }
 
+    window_guest_list_invalidate_visible_guests();
     return w;
 }
 
@@ -328,6 +349,7 @@ static void window_guest_list_mouseup(rct_window *w, rct_widgetindex widgetIndex
             w->pressed_widgets |= (1 << WIDX_TRACKING);
         else
             w->pressed_widgets &= ~(1 << WIDX_TRACKING);
+        window_guest_list_invalidate_visible_guests();
         window_invalidate(w);
         w->scrolls[0].v_top = 0;
         break;
@@ -337,6 +359,7 @@ static void window_guest_list_mouseup(rct_window *w, rct_widgetindex widgetIndex
             // Unset the search filter.
             _window_guest_list_filter_name[0] = '\0';
             w->pressed_widgets &= ~(1 << WIDX_FILTER_BY_NAME);
+            window_guest_list_invalidate_visible_guests();
         }
         else
         {
@@ -398,6 +421,7 @@ static void window_guest_list_mousedown(rct_window *w, rct_widgetindex widgetInd
         window_guest_list_widgets[WIDX_PAGE_DROPDOWN_BUTTON].type = WWT_EMPTY;
         w->list_information_type = 0;
         _window_guest_list_selected_filter = -1;
+        window_guest_list_invalidate_visible_guests();
         window_invalidate(w);
         w->scrolls[0].v_top = 0;
         break;
@@ -488,24 +512,13 @@ static void window_guest_list_update(rct_window *w)
  */
 static void window_guest_list_scrollgetsize(rct_window *w, sint32 scrollIndex, sint32 *width, sint32 *height)
 {
-    sint32 i, y, numGuests, spriteIndex;
-    rct_peep *peep;
+    sint32 i, y, numGuests;
 
     switch (_window_guest_list_selected_tab) {
     case PAGE_INDIVIDUAL:
         // Count the number of guests
-        numGuests = 0;
-
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            if (peep->outside_of_park != 0)
-                continue;
-            if (_window_guest_list_selected_filter != -1)
-                if (window_guest_list_is_peep_in_filter(peep))
-                    continue;
-            if (!guest_should_be_visible(peep))
-                continue;
-            numGuests++;
-        }
+        window_guest_list_find_visible_guests();
+        numGuests = _window_guest_list_model.GetCount();
         w->var_492 = numGuests;
         y = numGuests * SCROLLABLE_ROW_HEIGHT;
         _window_guest_list_num_pages = (sint32) ceilf((float)numGuests / 3173);
@@ -555,38 +568,27 @@ static void window_guest_list_scrollgetsize(rct_window *w, sint32 scrollIndex, s
  */
 static void window_guest_list_scrollmousedown(rct_window *w, sint32 scrollIndex, sint32 x, sint32 y)
 {
-    sint32 i, spriteIndex;
+    sint32 i;
     rct_peep *peep;
 
     switch (_window_guest_list_selected_tab) {
     case PAGE_INDIVIDUAL:
         i = y / SCROLLABLE_ROW_HEIGHT;
         i += _window_guest_list_selected_page * 3173;
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            if (peep->outside_of_park != 0)
-                continue;
-            if (_window_guest_list_selected_filter != -1)
-                if (window_guest_list_is_peep_in_filter(peep))
-                    continue;
-            if (!guest_should_be_visible(peep))
-                continue;
-
-            if (i == 0) {
-                // Open guest window
-                window_guest_open(peep);
-
-                break;
-            } else {
-                i--;
-            }
+        window_guest_list_find_visible_guests();
+        peep = window_guest_list_get_visible_guest(i);
+        if (peep != nullptr) {
+            // Open guest window
+            window_guest_open(peep);
         }
         break;
     case PAGE_SUMMARISED:
         i = y / SUMMARISED_GUEST_ROW_HEIGHT;
         if (i < _window_guest_list_num_groups) {
-            memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups_argument_1[i], 4);
-            memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups_argument_2[i], 4);
+            memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups[i].argument_1, 4);
+            memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups[i].argument_2, 4);
             _window_guest_list_selected_filter = _window_guest_list_selected_view;
+            window_guest_list_invalidate_visible_guests();
             _window_guest_list_selected_tab = PAGE_INDIVIDUAL;
             window_guest_list_widgets[WIDX_TRACKING].type = WWT_FLATBTN;
             window_invalidate(w);
@@ -726,7 +728,7 @@ static void window_guest_list_paint(rct_window *w, rct_drawpixelinfo *dpi)
  */
 static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, sint32 scrollIndex)
 {
-    sint32 spriteIndex, numGuests, i, j, y;
+    sint32 numGuests, i, j, y;
     rct_string_id format;
     rct_peep *peep;
     rct_peep_thought *thought;
@@ -737,21 +739,17 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
 
     switch (_window_guest_list_selected_tab) {
     case PAGE_INDIVIDUAL:
-        i = 0;
-        y = _window_guest_list_selected_page * -0x7BF2;
-
-        // For each guest
-        FOR_ALL_GUESTS(spriteIndex, peep) {
-            sprite_set_flashing((rct_sprite*)peep, false);
-            if (peep->outside_of_park != 0)
-                continue;
-            if (_window_guest_list_selected_filter != -1) {
-                if (window_guest_list_is_peep_in_filter(peep))
-                    continue;
-                gWindowMapFlashingFlags |= (1 << 0);
-                sprite_set_flashing((rct_sprite*)peep, true);
-            }
-            if (!guest_should_be_visible(peep))
+        window_guest_list_find_visible_guests();
+        if (_window_guest_list_selected_filter != -1 && _window_guest_list_any_guest_in_filter)
+            gWindowMapFlashingFlags |= (1 << 0);
+
+        // For each visible guest
+        sint32 firstRow, lastRow;
+        _window_guest_list_model.GetVisibleRange(dpi, _window_guest_list_selected_page * -0x7BF2, &firstRow, &lastRow);
+        y = _window_guest_list_selected_page * -0x7BF2 + firstRow * SCROLLABLE_ROW_HEIGHT;
+        for (i = firstRow; i < lastRow; i++, y += SCROLLABLE_ROW_HEIGHT) {
+            peep = window_guest_list_get_visible_guest(i);
+            if (peep == nullptr)
                 continue;
 
             // Check if y is beyond the scroll control
@@ -770,7 +768,7 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
                 // Guest name
                 set_format_arg(0, rct_string_id, peep->name_string_idx);
                 set_format_arg(2, uint32, peep->id);
-                gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 0, y, 113);
+                _window_guest_list_model.DrawText(dpi, peep->sprite_index, 0, format, gCommonFormatArgs, 6, 0, y, 113);
 
                 switch (_window_guest_list_selected_view) {
                 case VIEW_ACTIONS:
@@ -787,7 +785,7 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
 
                     set_format_arg(0, uint32, argument_1);
                     set_format_arg(4, uint32, argument_2);
-                    gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 133, y, 314);
+                    _window_guest_list_model.DrawText(dpi, peep->sprite_index, 1, format, gCommonFormatArgs, 8, 133, y, 314);
                     break;
                 case VIEW_THOUGHTS:
                     // For each thought
@@ -801,16 +799,12 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
                             break;
 
                         peep_thought_set_format_args(&peep->thoughts[j]);
-                        gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 118, y, 329);
+                        _window_guest_list_model.DrawText(dpi, peep->sprite_index, 2, format, gCommonFormatArgs, 8, 118, y, 329);
                         break;
                     }
                     break;
                 }
             }
-
-            // Increment list item index and y
-            i++;
-            y += SCROLLABLE_ROW_HEIGHT;
         }
         break;
     case PAGE_SUMMARISED:
@@ -818,6 +812,8 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
 
         // For each group of guests
         for (i = 0; i < _window_guest_list_num_groups; i++) {
+            const guest_group * group = &_window_guest_list_groups[i];
+
             // Check if y is beyond the scroll control
             if (y + SUMMARISED_GUEST_ROW_HEIGHT + 1 >= dpi->y) {
                 // Check if y is beyond the scroll control
@@ -832,13 +828,13 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
                 }
 
                 // Draw guest faces
-                numGuests = _window_guest_list_groups_num_guests[i];
-                for (j = 0; j < 56 && j < numGuests; j++)
-                    gfx_draw_sprite(dpi, _window_guest_list_groups_guest_faces[i * 56 + j] + SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY, j * 8, y + 12, 0);
+                numGuests = group->num_guests;
+                for (j = 0; j < GUEST_LIST_MAX_GROUP_FACES && j < numGuests; j++)
+                    gfx_draw_sprite(dpi, group->faces[j] + SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY, j * 8, y + 12, 0);
 
                 // Draw action
-                set_format_arg(0, uint32, _window_guest_list_groups_argument_1[i]);
-                set_format_arg(4, uint32, _window_guest_list_groups_argument_2[i]);
+                set_format_arg(0, uint32, group->argument_1);
+                set_format_arg(4, uint32, group->argument_2);
                 set_format_arg(10, uint32, numGuests);
                 gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 0, y, 414);
 
@@ -858,6 +854,7 @@ static void window_guest_list_textinput(rct_window *w, rct_widgetindex widgetInd
     {
         strncpy(_window_guest_list_filter_name, text, sizeof(_window_guest_list_filter_name));
         w->pressed_widgets |= (1 << WIDX_FILTER_BY_NAME);
+        window_guest_list_invalidate_visible_guests();
     }
 }
 
@@ -929,9 +926,6 @@ static void get_arguments_from_peep(rct_peep *peep, uint32 *argument_1, uint32*
  */
 static void window_guest_list_find_groups()
 {
-    sint32 spriteIndex, spriteIndex2, groupIndex, faceIndex;
-    rct_peep *peep, *peep2;
-
     uint32 tick256 = floor2(gScenarioTicks, 256);
     if (_window_guest_list_selected_view == _window_guest_list_last_find_groups_selected_view) {
         if (_window_guest_list_last_find_groups_wait != 0 ||
@@ -944,105 +938,106 @@ static void window_guest_list_find_groups()
     _window_guest_list_last_find_groups_tick = tick256;
     _window_guest_list_last_find_groups_selected_view = _window_guest_list_selected_view;
     _window_guest_list_last_find_groups_wait = 320;
-    _window_guest_list_num_groups = 0;
+    _window_guest_list_groups.clear();
 
-    // Set all guests to unassigned
-    FOR_ALL_GUESTS(spriteIndex, peep)
-        if (peep->outside_of_park == 0)
-            peep->flags |= SPRITE_FLAGS_PEEP_VISIBLE;
-
-    // For each guest / group
+    // Aggregate guests into groups in a single pass keyed on the argument pair. Groups are created in the order their
+    // first guest is found, which together with the stable sort below gives the same order as the original.
+    std::unordered_map<uint64, sint32> groupIndices;
+    sint32 spriteIndex;
+    rct_peep *peep;
     FOR_ALL_GUESTS(spriteIndex, peep) {
-        if (peep->outside_of_park != 0 || !(peep->flags & SPRITE_FLAGS_PEEP_VISIBLE))
+        if (peep->outside_of_park != 0)
             continue;
 
-        // New group, cap at 240 though
-        groupIndex = _window_guest_list_num_groups;
-        if (groupIndex >= 240)
-            break;
-
-        _window_guest_list_num_groups++;
-        _window_guest_list_groups_num_guests[groupIndex] = 1;
-        peep->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-        get_arguments_from_peep( peep, &_window_guest_list_groups_argument_1[groupIndex], &_window_guest_list_groups_argument_2[groupIndex]);
-        memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups_argument_1[groupIndex], 4);
-        memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups_argument_2[groupIndex], 4);
+        uint32 argument1, argument2;
+        get_arguments_from_peep(peep, &argument1, &argument2);
+        uint64 key = ((uint64)argument1 << 32) | argument2;
 
-        _window_guest_list_group_index[groupIndex] = groupIndex;
-        faceIndex = groupIndex * 56;
-        _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
-
-        // Find more peeps that belong to same group
-        FOR_ALL_GUESTS(spriteIndex2, peep2) {
-            if (peep2->outside_of_park != 0 || !(peep2->flags & SPRITE_FLAGS_PEEP_VISIBLE))
-                continue;
-
-            uint32 argument1, argument2;
-            // Get and check if in same group
-            get_arguments_from_peep(peep2, &argument1, &argument2);
-            if (argument1 != _window_guest_list_groups_argument_1[groupIndex] || argument2 != _window_guest_list_groups_argument_2[groupIndex] )
-                continue;
-
-            // Assign guest
-            _window_guest_list_groups_num_guests[groupIndex]++;
-            peep2->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-            // Add face sprite, cap at 56 though
-            if (_window_guest_list_groups_num_guests[groupIndex] >= 56)
+        sint32 groupIndex;
+        auto it = groupIndices.find(key);
+        if (it != groupIndices.end()) {
+            groupIndex = it->second;
+            if (groupIndex == -1)
                 continue;
-            _window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep2) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
-        }
 
-        if (_window_guest_list_filter_arguments[0] == 0) {
-            _window_guest_list_num_groups--;
+            // Assign guest, add face sprite
+            guest_group * group = &_window_guest_list_groups[groupIndex];
+            if (group->num_guests < GUEST_LIST_MAX_GROUP_FACES)
+                group->faces[group->num_guests] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+            group->num_guests++;
             continue;
         }
 
-        sint32 curr_num_guests = _window_guest_list_groups_num_guests[groupIndex];
-        sint32 swap_position = 0;
-        //This section places the groups in size order.
-        bool gotoNextPeep = false;
-        while (1) {
-            if (swap_position >= groupIndex) {
-                gotoNextPeep = true;
-                break;
-            }
-            if (curr_num_guests > _window_guest_list_groups_num_guests[swap_position])
-                break;
-            swap_position++;
-        }
-        if (gotoNextPeep) {
+        // New group, cap at 240 though and skip guests with no action / thought
+        if (_window_guest_list_groups.size() >= GUEST_LIST_MAX_GROUPS || (argument1 & 0xFFFF) == 0) {
+            groupIndices[key] = -1;
             continue;
         }
 
-        sint32 argument_1 = _window_guest_list_groups_argument_1[groupIndex];
-        sint32 argument_2 = _window_guest_list_groups_argument_2[groupIndex];
-        sint32 bl = _window_guest_list_group_index[groupIndex];
+        groupIndices[key] = (sint32)_window_guest_list_groups.size();
+        guest_group group = {};
+        group.argument_1 = argument1;
+        group.argument_2 = argument2;
+        group.num_guests = 1;
+        group.faces[0] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+        _window_guest_list_groups.push_back(group);
+    }
 
-        do {
-            sint32 temp = curr_num_guests;
-            curr_num_guests = _window_guest_list_groups_num_guests[swap_position];
-            _window_guest_list_groups_num_guests[swap_position] = temp;
+    // Place the groups in size order
+    std::stable_sort(_window_guest_list_groups.begin(), _window_guest_list_groups.end(),
+        [](const guest_group &a, const guest_group &b) -> bool
+        {
+            return a.num_guests > b.num_guests;
+        });
+    _window_guest_list_num_groups = (sint32)_window_guest_list_groups.size();
+}
 
-            temp = argument_1;
-            argument_1 = _window_guest_list_groups_argument_1[swap_position];
-            _window_guest_list_groups_argument_1[swap_position] = temp;
+static void window_guest_list_invalidate_visible_guests()
+{
+    _window_guest_list_model.Invalidate();
+}
 
-            temp = argument_2;
-            argument_2 = _window_guest_list_groups_argument_2[swap_position];
-            _window_guest_list_groups_argument_2[swap_position] = temp;
+/**
+ * Builds the list of guests shown on the individual page. The result is reused by scrollgetsize, scrollmousedown and
+ * scrollpaint until the next game tick or until the filter changes.
+ */
+static void window_guest_list_find_visible_guests()
+{
+    if (!_window_guest_list_model.NeedsRefresh())
+        return;
 
-            uint8 temp_faces[56];
-            memcpy(temp_faces, &(_window_guest_list_groups_guest_faces[groupIndex*56]), 56);
-            memcpy(&(_window_guest_list_groups_guest_faces[groupIndex * 56]), &(_window_guest_list_groups_guest_faces[swap_position * 56]), 56);
-            memcpy(&(_window_guest_list_groups_guest_faces[swap_position * 56]), temp_faces, 56);
+    _window_guest_list_any_guest_in_filter = false;
 
-            temp = _window_guest_list_group_index[swap_position];
-            _window_guest_list_group_index[swap_position] = bl;
-            bl = temp;
-        } while (++swap_position <= groupIndex);
+    std::vector<uint16> guests;
+    sint32 spriteIndex;
+    rct_peep *peep;
+    FOR_ALL_GUESTS(spriteIndex, peep) {
+        sprite_set_flashing((rct_sprite*)peep, false);
+        if (peep->outside_of_park != 0)
+            continue;
+        if (_window_guest_list_selected_filter != -1) {
+            if (window_guest_list_is_peep_in_filter(peep))
+                continue;
+            _window_guest_list_any_guest_in_filter = true;
+            sprite_set_flashing((rct_sprite*)peep, true);
+        }
+        if (!guest_should_be_visible(peep))
+            continue;
+        guests.push_back((uint16)spriteIndex);
     }
+    _window_guest_list_model.SetItems(std::move(guests));
+}
+
+static rct_peep * window_guest_list_get_visible_guest(sint32 index)
+{
+    if (index < 0 || index >= _window_guest_list_model.GetCount())
+        return nullptr;
+
+    // The guest may have been removed since the list was built
+    rct_sprite * sprite = get_sprite(_window_guest_list_model.GetItems()[index]);
+    if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_PEEP || sprite->peep.type != PEEP_TYPE_GUEST)
+        return nullptr;
+    return &sprite->peep;
 }
 
 static bool guest_should_be_visible(rct_peep *peep)
@@ -29,6 +29,7 @@
 #include <openrct2/ride/Track.h>
 #include <openrct2/world/Entrance.h>
 #include <openrct2/world/Footpath.h>
+#include <openrct2/world/MapChangeJournal.h>
 #include <openrct2/world/Scenery.h>
 
 #include <openrct2-ui/interface/LandTool.h>
@@ -171,20 +172,22 @@ static rct_window_event_list window_map_events = {
 /** rct2: 0x00F1AD61 */
 static uint8 _activeTool;
 
-/** rct2: 0x00F1AD6C */
-static uint32 _currentLine;
-
 /** rct2: 0x00F1AD68 */
 static uint8 (*_mapImageData)[MAP_WINDOW_MAP_SIZE][MAP_WINDOW_MAP_SIZE];
 
+// The tab and map size the map image was drawn for, it is redrawn completely when either changes
+static bool _mapImageNeedsRedraw;
+static sint32 _mapImageTab;
+static sint32 _mapImageMapSize;
+static std::vector<LocationXY8> _mapImageChangedTiles;
+
 static sint32 _nextPeepSpawnIndex = 0;
 
 static void window_map_init_map();
 static void window_map_centre_on_view_point();
 static void window_map_show_default_scenario_editor_buttons(rct_window *w);
 static void window_map_draw_tab_images(rct_window *w, rct_drawpixelinfo *dpi);
-static void window_map_paint_peep_overlay(rct_drawpixelinfo *dpi);
-static void window_map_paint_train_overlay(rct_drawpixelinfo *dpi);
+static void window_map_paint_sprite_overlay(rct_window *w, rct_drawpixelinfo *dpi);
 static void window_map_paint_hud_rectangle(rct_drawpixelinfo *dpi);
 static void window_map_inputsize_land(rct_window *w);
 static void window_map_inputsize_map(rct_window *w);
@@ -197,7 +200,7 @@ static void window_map_place_park_entrance_tool_down(sint32 x, sint32 y);
 static void window_map_set_peep_spawn_tool_down(sint32 x, sint32 y);
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
-static void map_window_set_pixels(rct_window *w);
+static void map_window_update_pixels(rct_window *w);
 
 static void map_window_screen_to_map(sint32 screenX, sint32 screenY, sint32 *mapX, sint32 *mapY);
 
@@ -442,8 +445,7 @@ static void window_map_update(rct_window *w)
         window_map_centre_on_view_point();
     }
 
-    for (sint32 i = 0; i < 16; i++)
-        map_window_set_pixels(w);
+    map_window_update_pixels(w);
 
     window_invalidate(w);
 
@@ -897,14 +899,7 @@ static void window_map_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, sint32
     gfx_set_g1_element(SPR_TEMP, &g1temp);
     gfx_draw_sprite(dpi, SPR_TEMP, 0, 0, 0);
 
-    if (w->selected_tab == PAGE_PEEPS)
-    {
-        window_map_paint_peep_overlay(dpi);
-    }
-    else
-    {
-        window_map_paint_train_overlay(dpi);
-    }
+    window_map_paint_sprite_overlay(w, dpi);
     window_map_paint_hud_rectangle(dpi);
 }
 
@@ -915,7 +910,7 @@ static void window_map_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, sint32
 static void window_map_init_map()
 {
     memset(_mapImageData, PALETTE_INDEX_10, sizeof(*_mapImageData));
-    _currentLine = 0;
+    _mapImageNeedsRedraw = true;
 }
 
 /**
@@ -1062,77 +1057,115 @@ static void window_map_transform_to_map_coords(sint16 *left, sint16 *top)
  *
  *  rct2: 0x0068DADA
  */
-static void window_map_paint_peep_overlay(rct_drawpixelinfo *dpi)
+static void window_map_paint_peep(rct_drawpixelinfo *dpi, rct_peep *peep)
 {
-    rct_peep *peep;
-    uint16 spriteIndex;
-
     sint16 left, right, bottom, top;
     sint16 colour;
 
-    FOR_ALL_PEEPS(spriteIndex, peep) {
-        left = peep->x;
-        top = peep->y;
+    left = peep->x;
+    top = peep->y;
 
-        if (left == LOCATION_NULL)
-            continue;
+    if (left == LOCATION_NULL)
+        return;
 
-        window_map_transform_to_map_coords(&left, &top);
+    window_map_transform_to_map_coords(&left, &top);
 
-        right = left;
-        bottom = top;
+    right = left;
+    bottom = top;
 
-        colour = PALETTE_INDEX_20;
+    colour = PALETTE_INDEX_20;
 
-        if (sprite_get_flashing((rct_sprite*)peep)) {
-            if (peep->type == PEEP_TYPE_STAFF) {
-                if ((gWindowMapFlashingFlags & (1 << 3)) != 0) {
-                    colour = PALETTE_INDEX_138;
-                    left--;
-                    if ((gWindowMapFlashingFlags & (1 << 15)) == 0)
-                        colour = PALETTE_INDEX_10;
-                }
-            } else {
-                if ((gWindowMapFlashingFlags & (1 << 1)) != 0) {
-                    colour = PALETTE_INDEX_172;
-                    left--;
-                    if ((gWindowMapFlashingFlags & (1 << 15)) == 0)
-                        colour = PALETTE_INDEX_21;
-                }
+    if (sprite_get_flashing((rct_sprite*)peep)) {
+        if (peep->type == PEEP_TYPE_STAFF) {
+            if ((gWindowMapFlashingFlags & (1 << 3)) != 0) {
+                colour = PALETTE_INDEX_138;
+                left--;
+                if ((gWindowMapFlashingFlags & (1 << 15)) == 0)
+                    colour = PALETTE_INDEX_10;
+            }
+        } else {
+            if ((gWindowMapFlashingFlags & (1 << 1)) != 0) {
+                colour = PALETTE_INDEX_172;
+                left--;
+                if ((gWindowMapFlashingFlags & (1 << 15)) == 0)
+                    colour = PALETTE_INDEX_21;
             }
         }
-        gfx_fill_rect(dpi, left, top, right, bottom, colour);
     }
+    gfx_fill_rect(dpi, left, top, right, bottom, colour);
 }
 
 /**
  *
  *  rct2: 0x0068DBC1
  */
-static void window_map_paint_train_overlay(rct_drawpixelinfo *dpi)
+static void window_map_paint_vehicle(rct_drawpixelinfo *dpi, rct_vehicle *vehicle)
 {
-    rct_vehicle *train, *vehicle;
-    uint16 train_index, vehicle_index;
-
     sint16 left, top, right, bottom;
 
-    for (train_index = gSpriteListHead[SPRITE_LIST_TRAIN]; train_index != SPRITE_INDEX_NULL; train_index = train->next) {
-        train = GET_VEHICLE(train_index);
-        for (vehicle_index = train_index; vehicle_index != SPRITE_INDEX_NULL; vehicle_index = vehicle->next_vehicle_on_train) {
-            vehicle = GET_VEHICLE(vehicle_index);
+    left = vehicle->x;
+    top = vehicle->y;
 
-            left = vehicle->x;
-            top = vehicle->y;
+    if (left == LOCATION_NULL)
+        return;
+
+    window_map_transform_to_map_coords(&left, &top);
 
-            if (left == LOCATION_NULL)
-                continue;
+    right = left;
+    bottom = top;
 
-            window_map_transform_to_map_coords(&left, &top);
+    gfx_fill_rect(dpi, left, top, right, bottom, PALETTE_INDEX_171);
+}
 
-            right = left;
-            bottom = top;
+/**
+ * Gets the range of tiles that can appear within the given scroll area.
+ */
+static void window_map_get_visible_tile_range(const rct_drawpixelinfo *dpi, sint32 *left, sint32 *top, sint32 *right, sint32 *bottom)
+{
+    const sint32 cornersX[] = { dpi->x, dpi->x + dpi->width, dpi->x, dpi->x + dpi->width };
+    const sint32 cornersY[] = { dpi->y, dpi->y, dpi->y + dpi->height, dpi->y + dpi->height };
+
+    *left = *top = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+    *right = *bottom = 0;
+    for (sint32 i = 0; i < 4; i++) {
+        sint32 mapX, mapY;
+        map_window_screen_to_map(cornersX[i], cornersY[i], &mapX, &mapY);
+
+        // Allow for rounding in the screen to map transform
+        *left = Math::Min(*left, (mapX >> 5) - 2);
+        *top = Math::Min(*top, (mapY >> 5) - 2);
+        *right = Math::Max(*right, (mapX >> 5) + 2);
+        *bottom = Math::Max(*bottom, (mapY >> 5) + 2);
+    }
+    *left = Math::Clamp(0, *left, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    *top = Math::Clamp(0, *top, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    *right = Math::Clamp(0, *right, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+    *bottom = Math::Clamp(0, *bottom, MAXIMUM_MAP_SIZE_TECHNICAL - 1);
+}
 
-            gfx_fill_rect(dpi, left, top, right, bottom, PALETTE_INDEX_171);
+/**
+ * Draws the peeps (people tab) or vehicles (rides tab). Only the sprites on tiles within the scroll area are visited,
+ * using the sprite spatial index rather than walking the whole sprite lists.
+ */
+static void window_map_paint_sprite_overlay(rct_window *w, rct_drawpixelinfo *dpi)
+{
+    sint32 left, top, right, bottom;
+    window_map_get_visible_tile_range(dpi, &left, &top, &right, &bottom);
+
+    for (sint32 y = top; y <= bottom; y++) {
+        for (sint32 x = left; x <= right; x++) {
+            uint16 spriteIndex = sprite_get_first_in_quadrant(x * 32, y * 32);
+            while (spriteIndex != SPRITE_INDEX_NULL) {
+                rct_sprite *sprite = get_sprite(spriteIndex);
+                if (w->selected_tab == PAGE_PEEPS) {
+                    if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP)
+                        window_map_paint_peep(dpi, &sprite->peep);
+                } else {
+                    if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+                        window_map_paint_vehicle(dpi, &sprite->vehicle);
+                }
+                spriteIndex = sprite->unknown.next_in_quadrant;
+            }
         }
     }
 }
@@ -1650,70 +1683,83 @@ static uint16 map_window_get_pixel_colour_ride(sint32 x, sint32 y)
     return colour & 0xFFFF;
 }
 
-static void map_window_set_pixels(rct_window *w)
+/**
+ * Gets the position within the map image of the given tile, each tile covers two horizontal pixels.
+ */
+static LocationXY16 map_window_get_tile_image_position(sint32 tileX, sint32 tileY)
 {
-    uint16 colour = 0;
-    uint8 *destination;
-    sint32 x = 0, y = 0, dx = 0, dy = 0;
-
-    sint32 pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-    LocationXY16 destinationPosition = MakeXY16(pos % MAP_WINDOW_MAP_SIZE, pos / MAP_WINDOW_MAP_SIZE);
-    destination = &(*_mapImageData)[destinationPosition.y][destinationPosition.x];
+    // The map image is drawn in diagonal lines of tiles, with the line and index along it depending on the rotation
+    sint32 line = 0, index = 0;
     switch (get_current_rotation()) {
     case 0:
-        x = _currentLine * 32;
-        y = 0;
-        dx = 0;
-        dy = 32;
+        line = tileX;
+        index = tileY;
         break;
     case 1:
-        x = 8192 - 32;
-        y = _currentLine * 32;
-        dx = -32;
-        dy = 0;
+        line = tileY;
+        index = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) - tileX;
         break;
     case 2:
-        x = ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) - _currentLine) * 32;
-        y = 8192 - 32;
-        dx = 0;
-        dy = -32;
+        line = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) - tileX;
+        index = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) - tileY;
         break;
     case 3:
-        x = 0;
-        y = ((MAXIMUM_MAP_SIZE_TECHNICAL - 1) - _currentLine) * 32;
-        dx = 32;
-        dy = 0;
+        line = (MAXIMUM_MAP_SIZE_TECHNICAL - 1) - tileY;
+        index = tileX;
         break;
     }
+    return MakeXY16((MAXIMUM_MAP_SIZE_TECHNICAL - 1) - line + index, line + index);
+}
 
-    for (sint32 i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++) {
-        if (
-            x > 0 &&
-            y > 0 &&
-            x < gMapSizeUnits &&
-            y < gMapSizeUnits
-        ) {
-            switch (w->selected_tab) {
-            case PAGE_PEEPS:
-                colour = map_window_get_pixel_colour_peep(x, y);
-                break;
-            case PAGE_RIDES:
-                colour = map_window_get_pixel_colour_ride(x, y);
-                break;
+static void map_window_set_tile_pixels(rct_window *w, sint32 tileX, sint32 tileY)
+{
+    sint32 x = tileX * 32;
+    sint32 y = tileY * 32;
+    if (x <= 0 || y <= 0 || x >= gMapSizeUnits || y >= gMapSizeUnits)
+        return;
+
+    uint16 colour = 0;
+    switch (w->selected_tab) {
+    case PAGE_PEEPS:
+        colour = map_window_get_pixel_colour_peep(x, y);
+        break;
+    case PAGE_RIDES:
+        colour = map_window_get_pixel_colour_ride(x, y);
+        break;
+    }
+
+    LocationXY16 position = map_window_get_tile_image_position(tileX, tileY);
+    uint8 *destination = &(*_mapImageData)[position.y][position.x];
+    destination[0] = (colour >> 8) & 0xFF;
+    destination[1] = colour;
+}
+
+/**
+ * Redraws the tiles recorded in the map change journal since the last update. The whole map image is redrawn when the
+ * journal has been reset or the tab, rotation or map size has changed.
+ */
+static void map_window_update_pixels(rct_window *w)
+{
+    bool redrawAll = !map_change_journal_consume(_mapImageChangedTiles);
+    if (_mapImageNeedsRedraw || _mapImageTab != w->selected_tab || _mapImageMapSize != gMapSize)
+        redrawAll = true;
+
+    if (redrawAll) {
+        _mapImageNeedsRedraw = false;
+        _mapImageTab = w->selected_tab;
+        _mapImageMapSize = gMapSize;
+
+        memset(_mapImageData, PALETTE_INDEX_10, sizeof(*_mapImageData));
+        for (sint32 y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++) {
+            for (sint32 x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++) {
+                map_window_set_tile_pixels(w, x, y);
             }
-            destination[0] = (colour >> 8) & 0xFF;
-            destination[1] = colour;
         }
-        x += dx;
-        y += dy;
-
-        destinationPosition.x++;
-        destinationPosition.y++;
-        destination = &(*_mapImageData)[destinationPosition.y][destinationPosition.x];
+    } else {
+        for (const auto &tile : _mapImageChangedTiles) {
+            map_window_set_tile_pixels(w, tile.x, tile.y);
+        }
     }
-    _currentLine++;
-    if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
-        _currentLine = 0;
 }
 
 static void map_window_screen_to_map(sint32 screenX, sint32 screenY, sint32 *mapX, sint32 *mapY)
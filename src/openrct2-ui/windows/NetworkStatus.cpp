@@ -183,6 +183,21 @@ static void window_network_status_paint(rct_window *w, rct_drawpixelinfo *dpi)
     gfx_clip_string(buffer, w->widgets[WIDX_BACKGROUND].right - 50);
     sint32 x = w->x + (w->width / 2);
     sint32 y = w->y + (w->height / 2);
+
+    // Show how much compression is saving while the map downloads
+    NetworkTrafficStats stats;
+    network_get_traffic_stats(&stats);
+    uint64 bytesTransferred = stats.BytesSent + stats.BytesReceived;
+    if (bytesTransferred > 0)
+    {
+        uint32 args[2] = {
+            (uint32)(bytesTransferred / 1024),
+            (uint32)((stats.BytesSentUncompressed + stats.BytesReceivedUncompressed) / 1024)
+        };
+        gfx_draw_string_centred(dpi, STR_MULTIPLAYER_TRAFFIC_STATS, x, y + 6, COLOUR_BLACK, args);
+        y -= 6;
+    }
+
     x -= gfx_get_string_width(buffer) / 2;
     gfx_draw_string(dpi, buffer, COLOUR_BLACK, x, y);
 }
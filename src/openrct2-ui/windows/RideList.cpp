@@ -14,10 +14,14 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <string>
+#include <vector>
+
 #include <openrct2-ui/windows/Window.h>
 
 #include <openrct2/config/Config.h>
 #include <openrct2/Context.h>
+#include <openrct2/core/Math.hpp>
 #include <openrct2/core/Util.hpp>
 #include <openrct2/Game.h>
 #include <openrct2/interface/themes.h>
@@ -26,6 +30,7 @@
 #include <openrct2/network/network.h>
 #include <openrct2/sprites.h>
 #include <openrct2-ui/interface/Dropdown.h>
+#include <openrct2-ui/interface/ScrollListModel.h>
 #include <openrct2/windows/Intent.h>
 
 enum {
@@ -186,6 +191,7 @@ static constexpr const rct_string_id page_names[] = {
 };
 
 static sint32 _window_ride_list_information_type;
+static ScrollListModel _window_ride_list_model(SCROLLABLE_ROW_HEIGHT);
 
 static void window_ride_list_draw_tab_images(rct_drawpixelinfo *dpi, rct_window *w);
 static void window_ride_list_close_all(rct_window *w);
@@ -578,14 +584,17 @@ static void window_ride_list_paint(rct_window *w, rct_drawpixelinfo *dpi)
  */
 static void window_ride_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, sint32 scrollIndex)
 {
-    sint32 i, y, argument;
+    sint32 i, y, argument, firstRow, lastRow;
     rct_string_id format, formatSecondary;
     Ride *ride;
 
     gfx_fill_rect(dpi, dpi->x, dpi->y, dpi->x + dpi->width, dpi->y + dpi->height, ColourMapA[w->colours[1]].mid_light);
 
-    y = 0;
-    for (i = 0; i < w->no_list_items; i++) {
+    _window_ride_list_model.GetVisibleRange(dpi, 0, &firstRow, &lastRow);
+    lastRow = Math::Min(lastRow, (sint32)w->no_list_items);
+
+    y = firstRow * SCROLLABLE_ROW_HEIGHT;
+    for (i = firstRow; i < lastRow; i++) {
         format = (_quickDemolishMode ? STR_RED_STRINGID : STR_BLACK_STRING);
 
         // Background highlight
@@ -598,7 +607,7 @@ static void window_ride_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
         ride = get_ride(w->list_item_positions[i]);
 
         // Ride name
-        gfx_draw_string_left_clipped(dpi, format, &ride->name, COLOUR_BLACK, 0, y - 1, 159);
+        _window_ride_list_model.DrawText(dpi, w->list_item_positions[i], 0, format, &ride->name, 6, 0, y - 1, 159);
 
         // Ride information
         formatSecondary = 0;
@@ -714,7 +723,7 @@ static void window_ride_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
             format = STR_RED_OUTLINED_STRING;
 
         set_format_arg(0, rct_string_id, formatSecondary);
-        gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 160, y - 1, 157);
+        _window_ride_list_model.DrawText(dpi, w->list_item_positions[i], 1, format, gCommonFormatArgs, 6, 160, y - 1, 157);
         y += SCROLLABLE_ROW_HEIGHT;
     }
 }
@@ -756,9 +765,19 @@ void window_ride_list_refresh_list(rct_window *w)
 {
     sint32 i;
     Ride *ride, *otherRide;
-    char bufferA[128], bufferB[128];
+    char buffer[128];
     sint32 list_index = 0;
 
+    // Format the ride names once rather than for every comparison of the insertion sort
+    std::vector<std::string> upperCaseNames;
+    if (w->list_information_type == INFORMATION_TYPE_STATUS) {
+        upperCaseNames.resize(MAX_RIDES);
+        FOR_ALL_RIDES(i, ride) {
+            format_string_to_upper(buffer, sizeof(buffer), ride->name, &ride->name_arguments);
+            upperCaseNames[i] = buffer;
+        }
+    }
+
     FOR_ALL_RIDES(i, ride) {
         if (w->page != gRideClassifications[ride->type] || (ride->status == RIDE_STATUS_CLOSED && !ride_has_any_track_elements(i)))
             continue;
@@ -771,11 +790,9 @@ void window_ride_list_refresh_list(rct_window *w)
         sint32 current_list_position = list_index;
         switch (w->list_information_type) {
         case INFORMATION_TYPE_STATUS:
-            format_string_to_upper(bufferA, 128, ride->name, &ride->name_arguments);
             while (--current_list_position >= 0) {
-                otherRide = get_ride(w->list_item_positions[current_list_position]);
-                format_string_to_upper(bufferB, 128, otherRide->name, &otherRide->name_arguments);
-                if (strcmp(bufferA, bufferB) >= 0)
+                const std::string &otherName = upperCaseNames[w->list_item_positions[current_list_position]];
+                if (strcmp(upperCaseNames[i].c_str(), otherName.c_str()) >= 0)
                     break;
 
                 window_bubble_list_item(w, current_list_position);
@@ -914,6 +931,7 @@ void window_ride_list_refresh_list(rct_window *w)
 
     w->no_list_items = list_index;
     w->selected_list_item = -1;
+    _window_ride_list_model.SetItems(std::vector<uint16>(w->list_item_positions, w->list_item_positions + list_index));
     window_invalidate(w);
 }
 
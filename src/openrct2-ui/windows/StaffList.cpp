@@ -31,6 +31,7 @@
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Footpath.h>
 #include <openrct2-ui/interface/Dropdown.h>
+#include <openrct2-ui/interface/ScrollListModel.h>
 
 enum {
     WINDOW_STAFF_LIST_TAB_HANDYMEN,
@@ -131,8 +132,11 @@ static rct_widget window_staff_list_widgets[] = {
 static uint16 _window_staff_list_selected_type_count = 0;
 static sint32 _windowStaffListHighlightedIndex;
 static sint32 _windowStaffListSelectedTab = WINDOW_STAFF_LIST_TAB_HANDYMEN;
+static ScrollListModel _windowStaffListModel(SCROLLABLE_ROW_HEIGHT);
 
 static uint8 window_staff_list_get_random_entertainer_costume();
+static void window_staff_list_refresh_list();
+static rct_peep * window_staff_list_get_staff(sint32 index);
 
 typedef struct staff_naming_convention
 {
@@ -176,6 +180,7 @@ rct_window * window_staff_list_open()
 
     window_init_scroll_widgets(window);
     _windowStaffListHighlightedIndex = -1;
+    _windowStaffListModel.Invalidate();
     window->list_information_type = 0;
 
     window_staff_list_widgets[WIDX_STAFF_LIST_UNIFORM_COLOUR_PICKER].type = WWT_EMPTY;
@@ -276,6 +281,7 @@ static void window_staff_list_mousedown(rct_window *w, rct_widgetindex widgetInd
         if (_windowStaffListSelectedTab == newSelectedTab)
             break;
         _windowStaffListSelectedTab = (uint8)newSelectedTab;
+        _windowStaffListModel.Invalidate();
         window_invalidate(w);
         w->scrolls[0].v_top = 0;
         window_staff_list_cancel_tools(w);
@@ -402,14 +408,10 @@ void window_staff_list_toolabort(rct_window *w, rct_widgetindex widgetIndex)
 */
 void window_staff_list_scrollgetsize(rct_window *w, sint32 scrollIndex, sint32 *width, sint32 *height)
 {
-    sint32 i, spriteIndex;
-    rct_peep *peep;
+    sint32 i;
 
-    uint16 staffCount = 0;
-    FOR_ALL_STAFF(spriteIndex, peep) {
-        if (peep->staff_type == _windowStaffListSelectedTab)
-            staffCount++;
-    }
+    window_staff_list_refresh_list();
+    uint16 staffCount = (uint16)_windowStaffListModel.GetCount();
 
     _window_staff_list_selected_type_count = staffCount;
 
@@ -436,27 +438,17 @@ void window_staff_list_scrollgetsize(rct_window *w, sint32 scrollIndex, sint32 *
 */
 void window_staff_list_scrollmousedown(rct_window *w, sint32 scrollIndex, sint32 x, sint32 y)
 {
-    sint32 i, spriteIndex;
-    rct_peep *peep;
-
-    i = y / SCROLLABLE_ROW_HEIGHT;
-    FOR_ALL_STAFF(spriteIndex, peep) {
-        if (peep->staff_type != _windowStaffListSelectedTab)
-            continue;
-
-        if (i == 0) {
-            if (_quick_fire_mode)
-                game_do_command(peep->x, 1, peep->y, spriteIndex, GAME_COMMAND_FIRE_STAFF_MEMBER, 0, 0);
-            else
-            {
-                auto intent = Intent(WC_PEEP);
-                intent.putExtra(INTENT_EXTRA_PEEP, peep);
-                context_open_intent(&intent);
-            }
-            break;
+    window_staff_list_refresh_list();
+    rct_peep * peep = window_staff_list_get_staff(_windowStaffListModel.GetIndexAt(y));
+    if (peep != nullptr) {
+        if (_quick_fire_mode)
+            game_do_command(peep->x, 1, peep->y, peep->sprite_index, GAME_COMMAND_FIRE_STAFF_MEMBER, 0, 0);
+        else
+        {
+            auto intent = Intent(WC_PEEP);
+            intent.putExtra(INTENT_EXTRA_PEEP, peep);
+            context_open_intent(&intent);
         }
-
-        i--;
     }
 }
 
@@ -643,69 +635,94 @@ static constexpr const uint32 staffCostumeSprites[] = {
 */
 void window_staff_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, sint32 scrollIndex)
 {
-    sint32 spriteIndex, y, i, staffOrderIcon_x, staffOrders, staffOrderSprite;
+    sint32 y, i, firstRow, lastRow, staffOrderIcon_x, staffOrders, staffOrderSprite;
     uint32 argument_1, argument_2;
     uint8 selectedTab;
     rct_peep *peep;
 
     gfx_fill_rect(dpi, dpi->x, dpi->y, dpi->x + dpi->width - 1, dpi->y + dpi->height - 1, ColourMapA[w->colours[1]].mid_light);
 
-    y = 0;
-    i = 0;
+    window_staff_list_refresh_list();
+    _windowStaffListModel.GetVisibleRange(dpi, 0, &firstRow, &lastRow);
+
+    y = firstRow * SCROLLABLE_ROW_HEIGHT;
     selectedTab = _windowStaffListSelectedTab;
-    FOR_ALL_STAFF(spriteIndex, peep) {
-        if (peep->staff_type == selectedTab) {
-            if (y > dpi->y + dpi->height) {
-                break;
-            }
+    for (i = firstRow; i < lastRow; i++, y += SCROLLABLE_ROW_HEIGHT) {
+        peep = window_staff_list_get_staff(i);
+        if (peep == nullptr)
+            continue;
 
-            if (y + 11 >= dpi->y) {
-                sint32 format = (_quick_fire_mode ? STR_RED_STRINGID : STR_BLACK_STRING);
+        sint32 format = (_quick_fire_mode ? STR_RED_STRINGID : STR_BLACK_STRING);
 
-                if (i == _windowStaffListHighlightedIndex) {
-                    gfx_filter_rect(dpi, 0, y, 800, y + (SCROLLABLE_ROW_HEIGHT - 1), PALETTE_DARKEN_1);
-                    format = (_quick_fire_mode ? STR_LIGHTPINK_STRINGID : STR_WINDOW_COLOUR_2_STRINGID);
-                }
+        if (i == _windowStaffListHighlightedIndex) {
+            gfx_filter_rect(dpi, 0, y, 800, y + (SCROLLABLE_ROW_HEIGHT - 1), PALETTE_DARKEN_1);
+            format = (_quick_fire_mode ? STR_LIGHTPINK_STRINGID : STR_WINDOW_COLOUR_2_STRINGID);
+        }
 
-                set_format_arg(0, rct_string_id, peep->name_string_idx);
-                set_format_arg(2, uint32, peep->id);
-                gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 0, y, 107);
+        set_format_arg(0, rct_string_id, peep->name_string_idx);
+        set_format_arg(2, uint32, peep->id);
+        _windowStaffListModel.DrawText(dpi, peep->sprite_index, 0, format, gCommonFormatArgs, 6, 0, y, 107);
 
-                get_arguments_from_action(peep, &argument_1, &argument_2);
-                set_format_arg(0, uint32, argument_1);
-                set_format_arg(4, uint32, argument_2);
-                gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 175, y, 305);
+        get_arguments_from_action(peep, &argument_1, &argument_2);
+        set_format_arg(0, uint32, argument_1);
+        set_format_arg(4, uint32, argument_2);
+        _windowStaffListModel.DrawText(dpi, peep->sprite_index, 1, format, gCommonFormatArgs, 8, 175, y, 305);
 
-                // True if a patrol path is set for the worker
-                if (gStaffModes[peep->staff_id] & 2) {
-                    gfx_draw_sprite(dpi, SPR_STAFF_PATROL_PATH, 110, y, 0);
-                }
+        // True if a patrol path is set for the worker
+        if (gStaffModes[peep->staff_id] & 2) {
+            gfx_draw_sprite(dpi, SPR_STAFF_PATROL_PATH, 110, y, 0);
+        }
 
-                staffOrderIcon_x = 0x7D;
-                if (peep->staff_type != 3) {
-                    staffOrders = peep->staff_orders;
-                    staffOrderSprite = staffOrderBaseSprites[selectedTab];
-
-                    while (staffOrders != 0) {
-                        if (staffOrders & 1) {
-                            gfx_draw_sprite(dpi, staffOrderSprite, staffOrderIcon_x, y, 0);
-                        }
-                        staffOrders = staffOrders >> 1;
-                        staffOrderIcon_x += 9;
-                        // TODO: Remove sprite ID addition
-                        staffOrderSprite++;
-                    }
-                } else {
-                    gfx_draw_sprite(dpi, staffCostumeSprites[peep->sprite_type - 4], staffOrderIcon_x, y, 0);
+        staffOrderIcon_x = 0x7D;
+        if (peep->staff_type != 3) {
+            staffOrders = peep->staff_orders;
+            staffOrderSprite = staffOrderBaseSprites[selectedTab];
+
+            while (staffOrders != 0) {
+                if (staffOrders & 1) {
+                    gfx_draw_sprite(dpi, staffOrderSprite, staffOrderIcon_x, y, 0);
                 }
+                staffOrders = staffOrders >> 1;
+                staffOrderIcon_x += 9;
+                // TODO: Remove sprite ID addition
+                staffOrderSprite++;
             }
-
-            y += SCROLLABLE_ROW_HEIGHT;
-            i++;
+        } else {
+            gfx_draw_sprite(dpi, staffCostumeSprites[peep->sprite_type - 4], staffOrderIcon_x, y, 0);
         }
     }
 }
 
+/**
+ * Rebuilds the list of staff of the selected type, at most once per tick unless the list has been invalidated.
+ */
+static void window_staff_list_refresh_list()
+{
+    if (!_windowStaffListModel.NeedsRefresh())
+        return;
+
+    std::vector<uint16> staff;
+    uint16 spriteIndex;
+    rct_peep *peep;
+    FOR_ALL_STAFF(spriteIndex, peep) {
+        if (peep->staff_type == _windowStaffListSelectedTab)
+            staff.push_back(spriteIndex);
+    }
+    _windowStaffListModel.SetItems(std::move(staff));
+}
+
+static rct_peep * window_staff_list_get_staff(sint32 index)
+{
+    if (index < 0 || index >= _windowStaffListModel.GetCount())
+        return nullptr;
+
+    // The staff member may have been fired since the list was built
+    rct_sprite * sprite = get_sprite(_windowStaffListModel.GetItems()[index]);
+    if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_PEEP || sprite->peep.type != PEEP_TYPE_STAFF)
+        return nullptr;
+    return &sprite->peep;
+}
+
 static uint8 window_staff_list_get_random_entertainer_costume()
 {
     uint8 result = ENTERTAINER_COSTUME_PANDA;
@@ -17,6 +17,7 @@
 #include <cassert>
 #include <cstdarg>
 #include <cstdio>
+#include <mutex>
 #include "Diagnostic.h"
 
 #ifdef __ANDROID__
@@ -79,6 +80,9 @@ static constexpr const char * _level_strings[] = {
     "INFO"
 };
 
+// Held while writing a message, which takes several writes, so messages logged from worker threads do not interleave
+static std::mutex _logMutex;
+
 void diagnostic_log(DiagnosticLevel diagnosticLevel, const char *format, ...)
 {
     va_list args;
@@ -87,6 +91,7 @@ void diagnostic_log(DiagnosticLevel diagnosticLevel, const char *format, ...)
         return;
 
     FILE * stream = diagnostic_get_stream(diagnosticLevel);
+    std::lock_guard<std::mutex> lock(_logMutex);
 
     // Level
     fprintf(stream, "%s: ", _level_strings[diagnosticLevel]);
@@ -108,6 +113,7 @@ void diagnostic_log_with_location(DiagnosticLevel diagnosticLevel, const char *f
         return;
 
     FILE * stream = diagnostic_get_stream(diagnosticLevel);
+    std::lock_guard<std::mutex> lock(_logMutex);
 
     // Level and source code information
     if (_log_location_enabled)
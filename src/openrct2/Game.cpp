@@ -28,6 +28,7 @@
 #include "interface/Viewport.h"
 #include "interface/Widget.h"
 #include "interface/Window.h"
+#include "localisation/FormatStringCache.h"
 #include "localisation/Localisation.h"
 #include "management/Finance.h"
 #include "management/Marketing.h"
@@ -1142,6 +1143,7 @@ void game_convert_strings_to_utf8()
             utf8_remove_formatting(string, true);
         }
     }
+    format_string_cache_invalidate();
 
     // News items
     game_convert_news_items_to_utf8();
@@ -59,6 +59,7 @@ public:
         case DIRBASE::OPENRCT2:
         case DIRBASE::USER:
         case DIRBASE::CONFIG:
+        case DIRBASE::CACHE:
             directoryName = DirectoryNamesOpenRCT2[(size_t)did];
             break;
         }
@@ -191,6 +192,7 @@ const char * PlatformEnvironment::DirectoryNamesRCT2[] =
     nullptr,                // SHADER
     nullptr,                // THEME
     "Tracks",               // TRACK
+    nullptr,                // OBJECT_CACHE
 };
 
 const char * PlatformEnvironment::DirectoryNamesOpenRCT2[] =
@@ -209,6 +211,7 @@ const char * PlatformEnvironment::DirectoryNamesOpenRCT2[] =
     "shader",               // SHADER
     "themes",               // THEME
     "track",                // TRACK
+    "objectcache",          // OBJECT_CACHE
 };
 
 const char * PlatformEnvironment::FileNames[] =
@@ -51,6 +51,7 @@ namespace OpenRCT2
         SHADER,             // Contains OpenGL shaders.
         THEME,              // Contains interface themes.
         TRACK,              // Contains track designs.
+        OBJECT_CACHE,       // Contains decoded object data.
     };
 
     enum class PATHID
@@ -56,8 +56,9 @@ void * Mixer_Play_Effect(size_t id, sint32 loop, sint32 volume, float pan, doubl
             IAudioMixer * mixer = GetMixer();
             if (mixer != nullptr)
             {
-                mixer->Lock();
+                // Sounds may be loaded on demand, do that before holding up the mixer
                 IAudioSource * source = mixer->GetSoundSource((sint32)id);
+                mixer->Lock();
                 channel = mixer->Play(source, loop, deleteondone != 0, false);
                 if (channel != nullptr)
                 {
@@ -0,0 +1,55 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../core/Console.hpp"
+#include "CommandLine.hpp"
+
+static CommandLine::BenchAudioFunc _benchAudioFunc = nullptr;
+
+static exitcode_t HandleBenchAudio(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchAudioCommands[]
+{
+    // Main commands
+    DefineCommand("", "[channels] [seconds]", nullptr, HandleBenchAudio),
+    CommandTableEnd
+};
+
+void CommandLine::SetBenchAudioFunc(BenchAudioFunc func)
+{
+    _benchAudioFunc = func;
+}
+
+static exitcode_t HandleBenchAudio(CommandLineArgEnumerator *argEnumerator)
+{
+    sint32 numChannels = 64;
+    sint32 seconds = 10;
+    argEnumerator->TryPopInteger(&numChannels);
+    argEnumerator->TryPopInteger(&seconds);
+    if (numChannels <= 0 || seconds <= 0)
+    {
+        Console::Error::WriteLine("Channels and seconds must be positive.");
+        return EXITCODE_FAIL;
+    }
+
+    // The mixer lives in the UI library, headless builds have nothing to measure
+    if (_benchAudioFunc == nullptr)
+    {
+        Console::Error::WriteLine("Audio is not available in this build.");
+        return EXITCODE_FAIL;
+    }
+    return _benchAudioFunc(numChannels, seconds) ? EXITCODE_OK : EXITCODE_FAIL;
+}
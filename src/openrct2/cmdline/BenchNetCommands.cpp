@@ -0,0 +1,196 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef DISABLE_NETWORK
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../core/Console.hpp"
+#include "../network/network.h"
+#include "CommandLine.hpp"
+
+static exitcode_t HandleBenchNet(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchNetCommands[]
+{
+    // Main commands
+    DefineCommand("", "[clients] [ticks] [packets per tick] [port]", nullptr, HandleBenchNet),
+    CommandTableEnd
+};
+
+static bool bench_net_connect(std::vector<std::unique_ptr<NetworkConnection>> &servers, std::vector<std::unique_ptr<NetworkConnection>> &clients, sint32 numClients, uint16 port)
+{
+    std::unique_ptr<ITcpSocket> listener(CreateTcpSocket());
+    listener->Listen("127.0.0.1", port);
+    for (sint32 i = 0; i < numClients; i++)
+    {
+        auto client = std::make_unique<NetworkConnection>();
+        client->Socket = CreateTcpSocket();
+        client->Socket->ConnectAsync("127.0.0.1", port);
+        clients.push_back(std::move(client));
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    while (servers.size() < clients.size())
+    {
+        ITcpSocket * socket = listener->Accept();
+        if (socket != nullptr)
+        {
+            auto server = std::make_unique<NetworkConnection>();
+            server->Socket = socket;
+            server->AuthStatus = NETWORK_AUTH_OK;
+            servers.push_back(std::move(server));
+        }
+        else if (std::chrono::steady_clock::now() - startTime > std::chrono::seconds(10))
+        {
+            Console::Error::WriteLine("Timed out waiting for clients to connect.");
+            return false;
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    for (auto &client : clients)
+    {
+        while (client->Socket->GetStatus() != SOCKET_STATUS_CONNECTED)
+        {
+            if (client->Socket->GetError() != nullptr)
+            {
+                Console::Error::WriteLine("Client failed to connect: %s", client->Socket->GetError());
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return true;
+}
+
+static uint64 bench_net_receive(std::vector<std::unique_ptr<NetworkConnection>> &clients)
+{
+    uint64 received = 0;
+    for (auto &client : clients)
+    {
+        sint32 status;
+        do
+        {
+            status = client->ReadPacket();
+            if (status == NETWORK_READPACKET_SUCCESS)
+            {
+                client->InboundPacket.Clear();
+                received++;
+            }
+        }
+        while (status == NETWORK_READPACKET_SUCCESS || status == NETWORK_READPACKET_MORE_DATA);
+    }
+    return received;
+}
+
+/**
+ * Simulates a server broadcasting game commands to clients over loopback, using the same packet queueing and sending
+ * code as a real server, and reports how long the server side took.
+ */
+static exitcode_t HandleBenchNet(CommandLineArgEnumerator *argEnumerator)
+{
+    sint32 numClients = 64;
+    sint32 numTicks = 1000;
+    sint32 packetsPerTick = 16;
+    sint32 port = NETWORK_DEFAULT_PORT + 1;
+    argEnumerator->TryPopInteger(&numClients);
+    argEnumerator->TryPopInteger(&numTicks);
+    argEnumerator->TryPopInteger(&packetsPerTick);
+    argEnumerator->TryPopInteger(&port);
+    if (numClients <= 0 || numTicks <= 0 || packetsPerTick <= 0)
+    {
+        Console::Error::WriteLine("Clients, ticks and packets per tick must be positive.");
+        return EXITCODE_FAIL;
+    }
+
+    if (!InitialiseWSA())
+    {
+        return EXITCODE_FAIL;
+    }
+
+    try
+    {
+        std::vector<std::unique_ptr<NetworkConnection>> servers;
+        std::vector<std::unique_ptr<NetworkConnection>> clients;
+        if (!bench_net_connect(servers, clients, numClients, (uint16)port))
+        {
+            return EXITCODE_FAIL;
+        }
+
+        const uint64 expected = (uint64)numClients * numTicks * packetsPerTick;
+        uint64 received = 0;
+        std::chrono::duration<double, std::milli> serverTime(0);
+        for (sint32 tick = 0; tick < numTicks; tick++)
+        {
+            auto tickStart = std::chrono::high_resolution_clock::now();
+            for (sint32 i = 0; i < packetsPerTick; i++)
+            {
+                // Same size as a NETWORK_COMMAND_GAMECMD packet
+                std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+                *packet << (uint32)NETWORK_COMMAND_GAMECMD << (uint32)tick;
+                for (sint32 j = 0; j < 7; j++)
+                {
+                    *packet << (uint32)i;
+                }
+                *packet << (uint8)0 << (uint8)0;
+                for (auto &server : servers)
+                {
+                    server->QueuePacket(NetworkPacket::Duplicate(*packet));
+                }
+            }
+            for (auto &server : servers)
+            {
+                server->SendQueuedPackets();
+            }
+            serverTime += std::chrono::high_resolution_clock::now() - tickStart;
+
+            received += bench_net_receive(clients);
+        }
+
+        auto drainStart = std::chrono::steady_clock::now();
+        while (received < expected && std::chrono::steady_clock::now() - drainStart < std::chrono::seconds(10))
+        {
+            auto sendStart = std::chrono::high_resolution_clock::now();
+            for (auto &server : servers)
+            {
+                server->SendQueuedPackets();
+            }
+            serverTime += std::chrono::high_resolution_clock::now() - sendStart;
+            received += bench_net_receive(clients);
+        }
+
+        Console::WriteLine("Clients: %d, ticks: %d, packets per tick: %d", numClients, numTicks, packetsPerTick);
+        Console::WriteLine("Packets received: %llu / %llu", (unsigned long long)received, (unsigned long long)expected);
+        Console::WriteLine("Server time: %.2f ms total, %.4f ms per tick", serverTime.count(), serverTime.count() / numTicks);
+        if (received != expected)
+        {
+            return EXITCODE_FAIL;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        Console::Error::WriteLine("%s", e.what());
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#endif // DISABLE_NETWORK
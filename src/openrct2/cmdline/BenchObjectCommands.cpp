@@ -0,0 +1,129 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../Context.h"
+#include "../core/Console.hpp"
+#include "../drawing/Drawing.h"
+#include "../object/Object.h"
+#include "../object/ObjectRepository.h"
+#include "../OpenRCT2.h"
+#include "../platform/platform.h"
+#include "CommandLine.hpp"
+
+using namespace OpenRCT2;
+
+// More images than any single object has
+constexpr uint32 BENCH_MIN_FREE_IMAGES = 32768;
+
+static exitcode_t HandleBenchObjects(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchObjectCommands[]
+{
+    // Main commands
+    DefineCommand("", "[iterations count]", nullptr, HandleBenchObjects),
+    CommandTableEnd
+};
+
+/**
+ * Loads and unloads every object in the object repository in a random order, and reports how long allocating and
+ * freeing object images and strings took along with the image list statistics.
+ */
+static exitcode_t HandleBenchObjects(CommandLineArgEnumerator *argEnumerator)
+{
+    sint32 iterations = 10;
+    argEnumerator->TryPopInteger(&iterations);
+    if (iterations <= 0)
+    {
+        Console::Error::WriteLine("Iterations must be positive.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = std::unique_ptr<IContext>(CreateContext());
+    if (!context->Initialise())
+    {
+        return EXITCODE_FAIL;
+    }
+
+    // Objects are only read once, as only loading and unloading is being measured
+    IObjectRepository * objectRepository = GetObjectRepository();
+    const ObjectRepositoryItem * items = objectRepository->GetObjects();
+    std::vector<std::unique_ptr<Object>> objects;
+    for (size_t i = 0; i < objectRepository->GetNumObjects(); i++)
+    {
+        Object * object = objectRepository->LoadObject(&items[i]);
+        if (object != nullptr)
+        {
+            objects.emplace_back(object);
+        }
+    }
+    Console::WriteLine("Read %zu of %zu objects.", objects.size(), objectRepository->GetNumObjects());
+
+    std::mt19937 random(0);
+    std::vector<Object *> loadedObjects;
+    image_list_stats peakStats = { 0 };
+    std::chrono::duration<double> loadTime(0);
+    std::chrono::duration<double> unloadTime(0);
+    for (sint32 i = 0; i < iterations; i++)
+    {
+        std::shuffle(objects.begin(), objects.end(), random);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (auto &object : objects)
+        {
+            // Stop before the image list is full rather than flooding the log with allocation errors
+            image_list_stats stats;
+            gfx_object_get_image_list_stats(&stats);
+            if (stats.largest_free_range < BENCH_MIN_FREE_IMAGES)
+            {
+                break;
+            }
+            object->Load();
+            loadedObjects.push_back(object.get());
+        }
+        auto loadedTime = std::chrono::high_resolution_clock::now();
+        gfx_object_get_image_list_stats(&peakStats);
+
+        std::shuffle(loadedObjects.begin(), loadedObjects.end(), random);
+        for (auto object : loadedObjects)
+        {
+            object->Unload();
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        loadTime += loadedTime - startTime;
+        unloadTime += endTime - loadedTime;
+        if (i == iterations - 1)
+        {
+            Console::WriteLine("Loaded %zu objects per iteration.", loadedObjects.size());
+        }
+        loadedObjects.clear();
+    }
+    gfx_object_check_all_images_freed();
+
+    Console::WriteLine("Load:   %.3f ms per iteration", loadTime.count() * 1000 / iterations);
+    Console::WriteLine("Unload: %.3f ms per iteration", unloadTime.count() * 1000 / iterations);
+    Console::WriteLine("Images: %u of %u allocated in %u lists, %u free ranges, largest free range %u",
+        peakStats.allocated_images, peakStats.capacity, peakStats.allocations,
+        peakStats.free_ranges, peakStats.largest_free_range);
+    return EXITCODE_OK;
+}
@@ -98,10 +98,16 @@ constexpr char NAC = '\0';
 
 namespace CommandLine
 {
+    typedef bool (*BenchAudioFunc)(sint32 numChannels, sint32 seconds);
+
     extern const CommandLineCommand RootCommands[];
     extern const CommandLineCommand ScreenshotCommands[];
+    extern const CommandLineCommand RenderServerCommands[];
     extern const CommandLineCommand SpriteCommands[];
+    extern const CommandLineCommand BenchAudioCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
+    extern const CommandLineCommand BenchNetCommands[];
+    extern const CommandLineCommand BenchObjectCommands[];
 
     extern const CommandLineExample RootExamples[];
 
@@ -110,6 +116,11 @@ namespace CommandLine
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator * enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator * enumerator);
+
+    /**
+     * Sets the function that runs the audio mixer benchmark, the mixer is only available to UI builds.
+     */
+    void SetBenchAudioFunc(BenchAudioFunc func);
 }
 
 #endif
@@ -138,8 +138,14 @@ const CommandLineCommand CommandLine::RootCommands[]
 
     // Sub-commands
     DefineSubCommand("screenshot", CommandLine::ScreenshotCommands),
+    DefineSubCommand("renderserver", CommandLine::RenderServerCommands),
     DefineSubCommand("sprite",     CommandLine::SpriteCommands    ),
+    DefineSubCommand("benchaudio", CommandLine::BenchAudioCommands),
     DefineSubCommand("benchgfx",   CommandLine::BenchGfxCommands  ),
+#ifndef DISABLE_NETWORK
+    DefineSubCommand("benchnet",   CommandLine::BenchNetCommands  ),
+#endif
+    DefineSubCommand("benchobjects", CommandLine::BenchObjectCommands),
 
     CommandTableEnd
 };
@@ -35,6 +35,7 @@ static constexpr const CommandLineOptionDefinition ScreenshotOptionsDef[]
 };
 
 static exitcode_t HandleScreenshot(CommandLineArgEnumerator *argEnumerator);
+static exitcode_t HandleRenderServer(CommandLineArgEnumerator *argEnumerator);
 
 const CommandLineCommand CommandLine::ScreenshotCommands[]
 {
@@ -43,6 +44,13 @@ const CommandLineCommand CommandLine::ScreenshotCommands[]
     DefineCommand("", "<file> <output_image> giant <zoom> <rotation>",                      ScreenshotOptionsDef, HandleScreenshot),
     CommandTableEnd
 };
+
+const CommandLineCommand CommandLine::RenderServerCommands[]
+{
+    // Reads one screenshot job per line from stdin, using the same arguments as the screenshot command
+    DefineCommand("", "", ScreenshotOptionsDef, HandleRenderServer),
+    CommandTableEnd
+};
 // clang-format on
 
 static exitcode_t HandleScreenshot(CommandLineArgEnumerator *argEnumerator)
@@ -55,3 +63,12 @@ static exitcode_t HandleScreenshot(CommandLineArgEnumerator *argEnumerator)
     }
     return EXITCODE_OK;
 }
+
+static exitcode_t HandleRenderServer(CommandLineArgEnumerator *argEnumerator)
+{
+    sint32 result = cmdline_for_render_server(&options);
+    if (result < 0) {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
@@ -14,12 +14,16 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <mutex>
 #include "../platform/platform.h"
 
 #include "Console.hpp"
 
 namespace Console
 {
+    // Held while writing a line and its terminator, so lines written from worker threads do not interleave
+    static std::mutex _lineMutex;
+
     void Write(char c)
     {
         fputc(c, stdout);
@@ -55,6 +59,7 @@ namespace Console
     void WriteLine(const utf8 * format, ...)
     {
         va_list args;
+        std::lock_guard<std::mutex> lock(_lineMutex);
 
         va_start(args, format);
         vfprintf(stdout, format, args);
@@ -98,6 +103,7 @@ namespace Console
 
         void WriteLine_VA(const utf8 * format, va_list args)
         {
+            std::lock_guard<std::mutex> lock(_lineMutex);
             vfprintf(stdout, format, args);
             puts("");
         }
@@ -16,14 +16,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
+#include <mutex>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 #include "../common.h"
 #include "File.h"
 #include "FileScanner.h"
 #include "FileStream.hpp"
+#include "JobPool.hpp"
 #include "Path.hpp"
 
 template<typename TItem>
@@ -38,18 +43,47 @@ private:
         uint32 PathChecksum = 0;
     };
 
+    struct ScannedFile
+    {
+        std::string Path;
+        uint64 Size = 0;
+        uint64 LastModified = 0;
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<ScannedFile> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
+        ScanResult(DirectoryStats stats, std::vector<ScannedFile> files)
             : Stats(stats),
               Files(files)
         {
         }
     };
 
+    /**
+     * A record of a single indexed file. Files that failed to produce an item are still recorded so that they are not
+     * parsed again until they change.
+     */
+    struct IndexEntry
+    {
+        std::string Path;
+        uint64 Size = 0;
+        uint64 LastModified = 0;
+        bool HasItem = false;
+        TItem Item;
+    };
+
+    struct ReadIndexResult
+    {
+        // Whether the index was compatible and its entries can be reused
+        bool Loaded = false;
+        // Whether the index matched the scanned directory exactly
+        bool UpToDate = false;
+        std::vector<IndexEntry> Entries;
+    };
+
     struct FileIndexHeader
     {
         uint32          HeaderSize = sizeof(FileIndexHeader);
@@ -62,7 +96,10 @@ private:
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8 FILE_INDEX_VERSION = 4;
+    static constexpr uint8 FILE_INDEX_VERSION = 5;
+
+    // Number of files each worker loads before reporting progress
+    static constexpr size_t BUILD_BATCH_SIZE = 16;
 
     std::string const _name;
     uint32 const _magicNumber;
@@ -101,31 +138,34 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries and directories and loads the index. If the index is up to date, the items are loaded from the index
+     * and returned, otherwise only files that have been added or changed since the index was written are loaded.
      */
     std::vector<TItem> LoadOrBuild() const
     {
-        std::vector<TItem> items;
         auto scanResult = Scan();
         auto readIndexResult = ReadIndexFile(scanResult.Stats);
-        if (std::get<0>(readIndexResult))
+        if (readIndexResult.UpToDate)
+        {
+            return GetItems(readIndexResult.Entries);
+        }
+        else if (readIndexResult.Loaded)
         {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
+            return Build(scanResult, &readIndexResult.Entries);
         }
         else
         {
-            // Index was not loaded
-            items = Build(scanResult);
+            return Build(scanResult, nullptr);
         }
-        return items;
     }
 
+    /**
+     * Loads every file again, ignoring the existing index.
+     */
     std::vector<TItem> Rebuild() const
     {
         auto scanResult = Scan();
-        auto items = Build(scanResult);
+        auto items = Build(scanResult, nullptr);
         return items;
     }
 
@@ -150,7 +190,7 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats {};
-        std::vector<std::string> files;
+        std::vector<ScannedFile> files;
         for (const auto directory : SearchPaths)
         {
             log_verbose("FileIndex:Scanning for %s in '%s'", _pattern.c_str(), directory.c_str());
@@ -162,7 +202,11 @@ private:
                 auto fileInfo = scanner->GetFileInfo();
                 auto path = std::string(scanner->GetPath());
 
-                files.push_back(path);
+                ScannedFile file;
+                file.Path = path;
+                file.Size = fileInfo->Size;
+                file.LastModified = fileInfo->LastModified;
+                files.push_back(file);
 
                 stats.TotalFiles++;
                 stats.TotalFileSize += fileInfo->Size;
@@ -177,63 +221,179 @@ private:
         return ScanResult(stats, files);
     }
 
-    std::vector<TItem> Build(const ScanResult &scanResult) const
+    /**
+     * Creates the index entries for the scanned files and writes the index.
+     * @param previousEntries Entries from an existing index. Entries for files whose size and modification time are
+     *                        unchanged are reused rather than loading the file again. Can be nullptr.
+     */
+    std::vector<TItem> Build(const ScanResult &scanResult, const std::vector<IndexEntry> * previousEntries) const
     {
-        std::vector<TItem> items;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
+        const auto &files = scanResult.Files;
+        std::vector<IndexEntry> entries(files.size());
+        std::vector<size_t> pendingIndices;
+        if (previousEntries == nullptr)
+        {
+            for (size_t i = 0; i < files.size(); i++)
+            {
+                pendingIndices.push_back(i);
+            }
+            Console::WriteLine("Building %s (%zu items)", _name.c_str(), files.size());
+        }
+        else
+        {
+            std::unordered_map<std::string, const IndexEntry *> previousEntryMap;
+            for (const auto &entry : *previousEntries)
+            {
+                previousEntryMap[entry.Path] = &entry;
+            }
+            size_t numFound = 0;
+            for (size_t i = 0; i < files.size(); i++)
+            {
+                auto it = previousEntryMap.find(files[i].Path);
+                if (it == previousEntryMap.end())
+                {
+                    pendingIndices.push_back(i);
+                    continue;
+                }
+
+                numFound++;
+                if (it->second->Size == files[i].Size &&
+                    it->second->LastModified == files[i].LastModified)
+                {
+                    entries[i] = *it->second;
+                }
+                else
+                {
+                    pendingIndices.push_back(i);
+                }
+            }
+            size_t numRemoved = previousEntryMap.size() - numFound;
+            Console::WriteLine("Updating %s (%zu items, %zu added or changed, %zu removed)",
+                _name.c_str(), files.size(), pendingIndices.size(), numRemoved);
+        }
 
         auto startTime = std::chrono::high_resolution_clock::now();
-        // Start at 1, so that we can reach 100% completion status
-        size_t i = 1;
-        for (auto filePath : scanResult.Files)
+
+        // Files are indexed in batches across all hardware threads. Each batch writes into its own slice of entries,
+        // so the index file is in scan order regardless of thread timing.
+        std::exception_ptr firstException;
+        std::mutex exceptionMutex;
+        size_t numProcessed = 0;
+        if (!pendingIndices.empty())
         {
-            Console::WriteFormat("File %5d of %d, done %3d%%\r", i, scanResult.Files.size(), i * 100 / scanResult.Files.size());
-            i++;
-            log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
-            auto item = Create(filePath);
-            if (std::get<0>(item))
+            JobPool jobPool;
+            for (size_t start = 0; start < pendingIndices.size(); start += BUILD_BATCH_SIZE)
             {
-                items.push_back(std::get<1>(item));
+                size_t end = std::min(start + BUILD_BATCH_SIZE, pendingIndices.size());
+                jobPool.AddTask(
+                    [this, &files, &entries, &pendingIndices, &firstException, &exceptionMutex, start, end]()
+                    {
+                        try
+                        {
+                            for (size_t j = start; j < end; j++)
+                            {
+                                size_t index = pendingIndices[j];
+                                const auto &file = files[index];
+                                log_verbose("FileIndex:Indexing '%s'", file.Path.c_str());
+                                auto item = Create(file.Path);
+
+                                auto &entry = entries[index];
+                                entry.Path = file.Path;
+                                entry.Size = file.Size;
+                                entry.LastModified = file.LastModified;
+                                entry.HasItem = std::get<0>(item);
+                                entry.Item = std::move(std::get<1>(item));
+                            }
+                        }
+                        catch (...)
+                        {
+                            std::lock_guard<std::mutex> lock(exceptionMutex);
+                            if (firstException == nullptr)
+                            {
+                                firstException = std::current_exception();
+                            }
+                        }
+                    },
+                    [&numProcessed, start, end]()
+                    {
+                        numProcessed += end - start;
+                    });
             }
+            jobPool.Join([&numProcessed, &pendingIndices]()
+            {
+                Console::WriteFormat("File %5zu of %zu, done %3zu%%\r",
+                    numProcessed, pendingIndices.size(), numProcessed * 100 / pendingIndices.size());
+            });
+            Console::WriteLine();
         }
-        Console::WriteLine();
 
-        WriteIndexFile(scanResult.Stats, items);
+        if (firstException != nullptr)
+        {
+            std::rethrow_exception(firstException);
+        }
+
+        WriteIndexFile(scanResult.Stats, entries);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = (std::chrono::duration<float>)(endTime - startTime);
         Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
-        return items;
+        return GetItems(entries);
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(const DirectoryStats &stats) const
+    static std::vector<TItem> GetItems(const std::vector<IndexEntry> &entries)
     {
-        bool loadedItems = false;
         std::vector<TItem> items;
+        for (const auto &entry : entries)
+        {
+            if (entry.HasItem)
+            {
+                items.push_back(entry.Item);
+            }
+        }
+        return items;
+    }
+
+    ReadIndexResult ReadIndexFile(const DirectoryStats &stats) const
+    {
+        ReadIndexResult result;
         try
         {
             log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
             auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
 
-            // Read header, check if we need to re-scan
+            // Read header, check if the saved entries are still valid
             auto header = fs.ReadValue<FileIndexHeader>();
             if (header.HeaderSize == sizeof(FileIndexHeader) &&
                 header.MagicNumber == _magicNumber &&
                 header.VersionA == FILE_INDEX_VERSION &&
                 header.VersionB == _version &&
-                header.LanguageId == gCurrentLanguage &&
-                header.Stats.TotalFiles == stats.TotalFiles &&
-                header.Stats.TotalFileSize == stats.TotalFileSize &&
-                header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum &&
-                header.Stats.PathChecksum == stats.PathChecksum)
+                header.LanguageId == gCurrentLanguage)
             {
-                // Directory is the same, just read the saved items
                 for (uint32 i = 0; i < header.NumItems; i++)
                 {
-                    auto item = Deserialise(&fs);
-                    items.push_back(item);
+                    IndexEntry entry;
+                    entry.Path = fs.ReadStdString();
+                    entry.Size = fs.ReadValue<uint64>();
+                    entry.LastModified = fs.ReadValue<uint64>();
+                    entry.HasItem = fs.ReadValue<uint8>() != 0;
+                    if (entry.HasItem)
+                    {
+                        entry.Item = Deserialise(&fs);
+                    }
+                    result.Entries.push_back(std::move(entry));
+                }
+                result.Loaded = true;
+
+                // If the directory is the same, the saved entries can be used without checking each file
+                result.UpToDate =
+                    header.Stats.TotalFiles == stats.TotalFiles &&
+                    header.Stats.TotalFileSize == stats.TotalFileSize &&
+                    header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum &&
+                    header.Stats.PathChecksum == stats.PathChecksum;
+                if (!result.UpToDate)
+                {
+                    Console::WriteLine("%s out of date", _name.c_str());
                 }
-                loadedItems = true;
             }
             else
             {
@@ -244,18 +404,19 @@ private:
         {
             Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
             Console::Error::WriteLine("%s", e.what());
+            result = ReadIndexResult();
         }
-        return std::make_tuple(loadedItems, items);
+        return result;
     }
 
-    void WriteIndexFile(const DirectoryStats &stats, const std::vector<TItem> &items) const
+    void WriteIndexFile(const DirectoryStats &stats, const std::vector<IndexEntry> &entries) const
     {
         try
         {
             log_verbose("FileIndex:Writing index: '%s'", _indexPath.c_str());
             Path::CreateDirectory(Path::GetDirectory(_indexPath));
             auto fs = FileStream(_indexPath, FILE_MODE_WRITE);
-    
+
             // Write header
             FileIndexHeader header;
             header.MagicNumber = _magicNumber;
@@ -263,13 +424,20 @@ private:
             header.VersionB = _version;
             header.LanguageId = gCurrentLanguage;
             header.Stats = stats;
-            header.NumItems = (uint32)items.size();
+            header.NumItems = (uint32)entries.size();
             fs.WriteValue(header);
-    
-            // Write items
-            for (const auto item : items)
+
+            // Write entries
+            for (const auto &entry : entries)
             {
-                Serialise(&fs, item);
+                fs.WriteString(entry.Path);
+                fs.WriteValue<uint64>(entry.Size);
+                fs.WriteValue<uint64>(entry.LastModified);
+                fs.WriteValue<uint8>(entry.HasItem ? 1 : 0);
+                if (entry.HasItem)
+                {
+                    Serialise(&fs, entry.Item);
+                }
             }
         }
         catch (const std::exception &e)
@@ -37,17 +37,14 @@ utf8 * IStream::ReadString()
 
 std::string IStream::ReadStdString()
 {
-    std::vector<utf8> result;
+    std::string result;
 
     uint8 ch;
     while ((ch = ReadValue<uint8>()) != 0)
     {
         result.push_back(ch);
     }
-    result.push_back(0);
-
-    std::string resultString(result.data(), result.data() + result.size());
-    return resultString;
+    return result;
 }
 
 void IStream::WriteString(const utf8 * str)
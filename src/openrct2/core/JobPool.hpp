@@ -0,0 +1,174 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../common.h"
+
+/**
+ * A fixed set of worker threads that run queued tasks. Completion callbacks are run on the thread that calls Join, so
+ * they can update state that is not thread safe, such as progress output. An exception escaping a task is logged and
+ * the task counts as finished, so tasks that need to report failures must catch them themselves.
+ */
+class JobPool
+{
+private:
+    struct TaskData
+    {
+        std::function<void()> WorkFn;
+        std::function<void()> CompletionFn;
+    };
+
+    bool                        _shouldStop = false;
+    size_t                      _processing = 0;
+    std::vector<std::thread>    _threads;
+    std::deque<TaskData>        _pending;
+    std::deque<TaskData>        _completed;
+    std::condition_variable     _condPending;
+    std::condition_variable     _condComplete;
+    std::mutex                  _mutex;
+
+public:
+    /**
+     * Creates a pool with one thread per hardware thread, limited to maxThreads.
+     */
+    explicit JobPool(size_t maxThreads = 255)
+    {
+        size_t numThreads = std::max<size_t>(1, std::min<size_t>(maxThreads, std::thread::hardware_concurrency()));
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            _threads.emplace_back(&JobPool::ProcessQueue, this);
+        }
+    }
+
+    JobPool(const JobPool &) = delete;
+    JobPool & operator=(const JobPool &) = delete;
+
+    ~JobPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _shouldStop = true;
+            _condPending.notify_all();
+        }
+        for (auto &thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    size_t CountThreads() const
+    {
+        return _threads.size();
+    }
+
+    void AddTask(std::function<void()> workFn, std::function<void()> completionFn = nullptr)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _pending.push_back(TaskData { workFn, completionFn });
+        _condPending.notify_one();
+    }
+
+    /**
+     * Waits for every queued task to finish, running their completion callbacks on this thread.
+     * @param reportFn Called on this thread after each batch of completion callbacks.
+     */
+    void Join(std::function<void()> reportFn = nullptr)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _condComplete.wait(lock, [this]()
+            {
+                return (_pending.empty() && _processing == 0) || !_completed.empty();
+            });
+
+            bool hadCompletions = !_completed.empty();
+            while (!_completed.empty())
+            {
+                auto taskData = std::move(_completed.front());
+                _completed.pop_front();
+
+                lock.unlock();
+                taskData.CompletionFn();
+                lock.lock();
+            }
+            if (hadCompletions && reportFn != nullptr)
+            {
+                lock.unlock();
+                reportFn();
+                lock.lock();
+            }
+
+            if (_pending.empty() && _processing == 0 && _completed.empty())
+            {
+                break;
+            }
+        }
+    }
+
+private:
+    void ProcessQueue()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _condPending.wait(lock, [this]()
+            {
+                return _shouldStop || !_pending.empty();
+            });
+            if (_shouldStop)
+            {
+                break;
+            }
+
+            auto taskData = std::move(_pending.front());
+            _pending.pop_front();
+            _processing++;
+
+            lock.unlock();
+            try
+            {
+                taskData.WorkFn();
+            }
+            catch (const std::exception &ex)
+            {
+                log_error("Job failed: %s", ex.what());
+            }
+            catch (...)
+            {
+                log_error("Job failed with an unknown exception.");
+            }
+            lock.lock();
+
+            if (taskData.CompletionFn != nullptr)
+            {
+                _completed.push_back(std::move(taskData));
+            }
+            _processing--;
+            _condComplete.notify_one();
+        }
+    }
+};
@@ -0,0 +1,79 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+/**
+ * An unbounded queue for passing items from one producer thread to one consumer thread without locking.
+ * Push may only be called from the producer thread and TryPop only from the consumer thread.
+ */
+template<typename T>
+class LockFreeQueue final
+{
+private:
+    struct Node
+    {
+        std::atomic<Node *> Next { nullptr };
+        T                   Value;
+    };
+
+    // The head is a dummy node whose value has already been consumed
+    Node * _head;
+    Node * _tail;
+
+public:
+    LockFreeQueue()
+    {
+        _head = _tail = new Node();
+    }
+
+    LockFreeQueue(const LockFreeQueue &) = delete;
+    LockFreeQueue & operator=(const LockFreeQueue &) = delete;
+
+    ~LockFreeQueue()
+    {
+        while (_head != nullptr)
+        {
+            Node * next = _head->Next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+    }
+
+    void Push(T value)
+    {
+        Node * node = new Node();
+        node->Value = std::move(value);
+        _tail->Next.store(node, std::memory_order_release);
+        _tail = node;
+    }
+
+    bool TryPop(T &value)
+    {
+        Node * next = _head->Next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        value = std::move(next->Value);
+        delete _head;
+        _head = next;
+        return true;
+    }
+};
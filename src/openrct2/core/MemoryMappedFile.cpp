@@ -0,0 +1,117 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "MemoryMappedFile.h"
+#include "String.hpp"
+
+#include "../localisation/Language.h"
+
+MemoryMappedFile::MemoryMappedFile(const std::string &path)
+{
+#ifdef _WIN32
+    auto pathW = utf8_to_widechar(path.c_str());
+    HANDLE file = CreateFileW(pathW, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    free(pathW);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw IOException(String::StdFormat("Unable to get size of '%s'", path.c_str()));
+    }
+    _fileHandle = file;
+    _length = (size_t)fileSize.QuadPart;
+    if (_length != 0)
+    {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            _mappingHandle = mapping;
+            _data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        }
+        if (_data == nullptr)
+        {
+            if (_mappingHandle != nullptr)
+            {
+                CloseHandle(_mappingHandle);
+            }
+            CloseHandle(_fileHandle);
+            throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+        }
+    }
+#else
+    sint32 fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw IOException(String::StdFormat("Unable to open '%s'", path.c_str()));
+    }
+
+    struct stat statInfo;
+    if (fstat(fd, &statInfo) != 0)
+    {
+        close(fd);
+        throw IOException(String::StdFormat("Unable to get size of '%s'", path.c_str()));
+    }
+    _length = (size_t)statInfo.st_size;
+    if (_length != 0)
+    {
+        void * data = mmap(nullptr, _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw IOException(String::StdFormat("Unable to map '%s'", path.c_str()));
+        }
+        _data = data;
+    }
+
+    // The mapping keeps its own reference to the file
+    close(fd);
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#ifdef _WIN32
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle != nullptr)
+    {
+        CloseHandle(_mappingHandle);
+    }
+    CloseHandle(_fileHandle);
+#else
+    if (_data != nullptr)
+    {
+        munmap(_data, _length);
+    }
+#endif
+}
@@ -0,0 +1,60 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <string>
+#include "../common.h"
+#include "IStream.hpp"
+
+/**
+ * Maps a whole file into memory. Pages are shared with the system file cache until they are written to, writes are
+ * private to this mapping and are never saved back to the file.
+ */
+class MemoryMappedFile final
+{
+private:
+    void *  _data = nullptr;
+    size_t  _length = 0;
+#ifdef _WIN32
+    void *  _fileHandle = nullptr;
+    void *  _mappingHandle = nullptr;
+#endif
+
+public:
+    explicit MemoryMappedFile(const std::string &path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile & operator=(const MemoryMappedFile &) = delete;
+
+    void * GetData() const { return _data; }
+    size_t GetLength() const { return _length; }
+
+    /**
+     * Gets a pointer to count values of T at the given offset, throwing an IOException if they are not
+     * within the file.
+     */
+    template<typename T>
+    T * GetArray(size_t offset, size_t count) const
+    {
+        if (offset > _length || count > (_length - offset) / sizeof(T))
+        {
+            throw IOException("Attempted to read past end of file.");
+        }
+        return (T *)((uint8 *)_data + offset);
+    }
+};
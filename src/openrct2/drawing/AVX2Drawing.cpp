@@ -0,0 +1,57 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "Drawing.h"
+
+#if defined(__AVX2__) || (defined(_MSC_VER) && defined(OPENRCT2_X86))
+
+#include <immintrin.h>
+
+void palette_to_32bpp_avx2(const uint8 * RESTRICT src, uint32 * RESTRICT dst, sint32 count, const uint32 * RESTRICT palette)
+{
+    sint32 i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // Widen 16 palette indices to two vectors of 32-bit indices and gather their colours
+        const __m128i indices   = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m256i indices1  = _mm256_cvtepu8_epi32(indices);
+        const __m256i indices2  = _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8));
+        const __m256i colours1  = _mm256_i32gather_epi32((const int *)palette, indices1, 4);
+        const __m256i colours2  = _mm256_i32gather_epi32((const int *)palette, indices2, 4);
+
+        _mm256_storeu_si256((__m256i *)(dst + i), colours1);
+        _mm256_storeu_si256((__m256i *)(dst + i + 8), colours2);
+    }
+    if (i < count)
+    {
+        palette_to_32bpp_scalar(src + i, dst + i, count - i, palette);
+    }
+}
+
+#else
+
+#ifdef OPENRCT2_X86
+#error You have to compile this file with AVX2 enabled, when targetting x86!
+#endif
+
+void palette_to_32bpp_avx2(const uint8 * RESTRICT src, uint32 * RESTRICT dst, sint32 count, const uint32 * RESTRICT palette)
+{
+    openrct2_assert(false, "AVX2 function called on a CPU that doesn't support AVX2");
+}
+
+#endif // __AVX2__
@@ -0,0 +1,293 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include "../core/Math.hpp"
+#include "DirtyRegion.h"
+
+constexpr size_t DirtyRegion::MaxRects;
+
+uint64 DirtyRegion::GetArea() const
+{
+    uint64 area = 0;
+    for (const auto &rect : _rects)
+    {
+        area += rect.GetArea();
+    }
+    return area;
+}
+
+DirtyRect DirtyRegion::GetBounds() const
+{
+    if (_rects.empty())
+    {
+        return { 0, 0, 0, 0 };
+    }
+
+    DirtyRect bounds = _rects[0];
+    for (const auto &rect : _rects)
+    {
+        bounds.Left = Math::Min(bounds.Left, rect.Left);
+        bounds.Top = Math::Min(bounds.Top, rect.Top);
+        bounds.Right = Math::Max(bounds.Right, rect.Right);
+        bounds.Bottom = Math::Max(bounds.Bottom, rect.Bottom);
+    }
+    return bounds;
+}
+
+void DirtyRegion::Clear()
+{
+    _rects.clear();
+}
+
+void DirtyRegion::Union(const DirtyRect &rect)
+{
+    if (rect.IsEmpty())
+    {
+        return;
+    }
+    for (const auto &existing : _rects)
+    {
+        if (existing.Contains(rect))
+        {
+            return;
+        }
+    }
+
+    // Cut away everything already in the region, only what is left is new
+    std::vector<DirtyRect> pieces = { rect };
+    for (size_t i = 0; i < _rects.size() && !pieces.empty(); i++)
+    {
+        const DirtyRect existing = _rects[i];
+        if (!existing.Intersects(rect))
+        {
+            continue;
+        }
+        if (rect.Contains(existing))
+        {
+            // Swallowed whole, the pieces cover it once the rest is cut away
+            _rects.erase(_rects.begin() + i);
+            i--;
+            continue;
+        }
+
+        size_t numPieces = pieces.size();
+        for (size_t j = 0; j < numPieces; j++)
+        {
+            DirtyRect piece = pieces[j];
+            if (piece.Intersects(existing))
+            {
+                Subtract(piece, existing, &pieces);
+                pieces[j] = { 0, 0, 0, 0 };
+            }
+        }
+        pieces.erase(std::remove_if(pieces.begin(), pieces.end(), [](const DirtyRect &piece) -> bool
+        {
+            return piece.IsEmpty();
+        }), pieces.end());
+    }
+
+    for (const auto &piece : pieces)
+    {
+        // Adding a piece can merge rectangles into one that covers later pieces, if so cut them again
+        bool overlaps = false;
+        for (const auto &existing : _rects)
+        {
+            if (existing.Intersects(piece))
+            {
+                overlaps = true;
+                break;
+            }
+        }
+        if (overlaps)
+        {
+            Union(piece);
+        }
+        else
+        {
+            Add(piece);
+        }
+    }
+}
+
+void DirtyRegion::Union(const DirtyRegion &other)
+{
+    for (const auto &rect : other._rects)
+    {
+        Union(rect);
+    }
+}
+
+DirtyRegion DirtyRegion::Intersect(const DirtyRect &rect) const
+{
+    DirtyRegion result;
+    for (const auto &existing : _rects)
+    {
+        DirtyRect clipped =
+        {
+            Math::Max(existing.Left, rect.Left),
+            Math::Max(existing.Top, rect.Top),
+            Math::Min(existing.Right, rect.Right),
+            Math::Min(existing.Bottom, rect.Bottom),
+        };
+        if (!clipped.IsEmpty())
+        {
+            result._rects.push_back(clipped);
+        }
+    }
+    return result;
+}
+
+void DirtyRegion::Subtract(const DirtyRect &hole)
+{
+    std::vector<DirtyRect> rects;
+    rects.reserve(_rects.size());
+    for (const auto &rect : _rects)
+    {
+        if (rect.Intersects(hole))
+        {
+            Subtract(rect, hole, &rects);
+        }
+        else
+        {
+            rects.push_back(rect);
+        }
+    }
+    _rects = std::move(rects);
+}
+
+/**
+ * Adds a rectangle that does not overlap the region, joining it to a neighbour that shares a whole edge.
+ */
+void DirtyRegion::Add(DirtyRect rect)
+{
+    bool merged;
+    do
+    {
+        merged = false;
+        for (size_t i = 0; i < _rects.size(); i++)
+        {
+            const DirtyRect &existing = _rects[i];
+            bool sameRows = existing.Top == rect.Top && existing.Bottom == rect.Bottom;
+            bool sameColumns = existing.Left == rect.Left && existing.Right == rect.Right;
+            if ((sameRows && (existing.Right == rect.Left || existing.Left == rect.Right)) ||
+                (sameColumns && (existing.Bottom == rect.Top || existing.Top == rect.Bottom)))
+            {
+                rect.Left = Math::Min(rect.Left, existing.Left);
+                rect.Top = Math::Min(rect.Top, existing.Top);
+                rect.Right = Math::Max(rect.Right, existing.Right);
+                rect.Bottom = Math::Max(rect.Bottom, existing.Bottom);
+                _rects.erase(_rects.begin() + i);
+                merged = true;
+                break;
+            }
+        }
+    }
+    while (merged);
+
+    _rects.push_back(rect);
+    if (_rects.size() > MaxRects)
+    {
+        MergeClosest(_rects.size() - 1);
+    }
+}
+
+/**
+ * Replaces the rectangle at index and the one whose bounding box with it wastes the fewest pixels with that bounding
+ * box, absorbing anything else it then overlaps.
+ */
+void DirtyRegion::MergeClosest(size_t index)
+{
+    DirtyRect rect = _rects[index];
+    _rects.erase(_rects.begin() + index);
+
+    size_t closest = 0;
+    uint64 closestWaste = UINT64_MAX;
+    for (size_t i = 0; i < _rects.size(); i++)
+    {
+        const DirtyRect &existing = _rects[i];
+        DirtyRect bounds =
+        {
+            Math::Min(rect.Left, existing.Left),
+            Math::Min(rect.Top, existing.Top),
+            Math::Max(rect.Right, existing.Right),
+            Math::Max(rect.Bottom, existing.Bottom),
+        };
+        uint64 waste = bounds.GetArea() - rect.GetArea() - existing.GetArea();
+        if (waste < closestWaste)
+        {
+            closest = i;
+            closestWaste = waste;
+        }
+    }
+
+    const DirtyRect &existing = _rects[closest];
+    rect.Left = Math::Min(rect.Left, existing.Left);
+    rect.Top = Math::Min(rect.Top, existing.Top);
+    rect.Right = Math::Max(rect.Right, existing.Right);
+    rect.Bottom = Math::Max(rect.Bottom, existing.Bottom);
+    _rects.erase(_rects.begin() + closest);
+
+    // Growing can overlap other rectangles, keep growing until it no longer does
+    bool grown;
+    do
+    {
+        grown = false;
+        for (size_t i = 0; i < _rects.size(); i++)
+        {
+            const DirtyRect &other = _rects[i];
+            if (other.Intersects(rect))
+            {
+                rect.Left = Math::Min(rect.Left, other.Left);
+                rect.Top = Math::Min(rect.Top, other.Top);
+                rect.Right = Math::Max(rect.Right, other.Right);
+                rect.Bottom = Math::Max(rect.Bottom, other.Bottom);
+                _rects.erase(_rects.begin() + i);
+                grown = true;
+                break;
+            }
+        }
+    }
+    while (grown);
+
+    _rects.push_back(rect);
+}
+
+/**
+ * Appends the parts of rect outside hole to result, as up to four rectangles.
+ */
+void DirtyRegion::Subtract(const DirtyRect &rect, const DirtyRect &hole, std::vector<DirtyRect> * result)
+{
+    if (rect.Top < hole.Top)
+    {
+        result->push_back({ rect.Left, rect.Top, rect.Right, hole.Top });
+    }
+    if (hole.Bottom < rect.Bottom)
+    {
+        result->push_back({ rect.Left, hole.Bottom, rect.Right, rect.Bottom });
+    }
+
+    sint32 top = Math::Max(rect.Top, hole.Top);
+    sint32 bottom = Math::Min(rect.Bottom, hole.Bottom);
+    if (rect.Left < hole.Left)
+    {
+        result->push_back({ rect.Left, top, hole.Left, bottom });
+    }
+    if (hole.Right < rect.Right)
+    {
+        result->push_back({ hole.Right, top, rect.Right, bottom });
+    }
+}
@@ -0,0 +1,87 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <vector>
+#include "../common.h"
+
+/**
+ * A rectangle in screen pixels, right and bottom are exclusive.
+ */
+struct DirtyRect
+{
+    sint32 Left;
+    sint32 Top;
+    sint32 Right;
+    sint32 Bottom;
+
+    bool IsEmpty() const { return Left >= Right || Top >= Bottom; }
+    uint64 GetArea() const { return IsEmpty() ? 0 : (uint64)(Right - Left) * (uint64)(Bottom - Top); }
+
+    bool Intersects(const DirtyRect &other) const
+    {
+        return Left < other.Right && other.Left < Right && Top < other.Bottom && other.Top < Bottom;
+    }
+
+    bool Contains(const DirtyRect &other) const
+    {
+        return Left <= other.Left && Top <= other.Top && Right >= other.Right && Bottom >= other.Bottom;
+    }
+};
+
+/**
+ * An area of the screen held as a list of rectangles that never overlap, so that anything drawn for each rectangle
+ * touches every pixel of the area exactly once. Rectangles that share an edge are coalesced, and once there are more
+ * than MaxRects the closest ones are merged, trading a few extra pixels for fewer draws.
+ */
+class DirtyRegion final
+{
+public:
+    static constexpr size_t MaxRects = 64;
+
+private:
+    std::vector<DirtyRect> _rects;
+
+public:
+    bool IsEmpty() const { return _rects.empty(); }
+    const std::vector<DirtyRect> &GetRects() const { return _rects; }
+    uint64 GetArea() const;
+    DirtyRect GetBounds() const;
+
+    void Clear();
+    void Union(const DirtyRect &rect);
+    void Union(const DirtyRegion &other);
+
+    /**
+     * Returns the part of this region inside rect.
+     */
+    DirtyRegion Intersect(const DirtyRect &rect) const;
+
+    /**
+     * Removes hole from the region. Unlike Union this never merges, so the result is exact.
+     */
+    void Subtract(const DirtyRect &hole);
+
+private:
+    void Add(DirtyRect rect);
+    void MergeClosest(size_t index);
+    static void Subtract(const DirtyRect &rect, const DirtyRect &hole, std::vector<DirtyRect> * result);
+};
+
+#endif
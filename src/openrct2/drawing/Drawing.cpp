@@ -493,6 +493,30 @@ void mask_init()
     }
 }
 
+void palette_to_32bpp_scalar(const uint8 * RESTRICT src, uint32 * RESTRICT dst, sint32 count, const uint32 * RESTRICT palette)
+{
+    for (sint32 i = 0; i < count; i++)
+    {
+        dst[i] = palette[src[i]];
+    }
+}
+
+void (*palette_to_32bpp_fn)(const uint8 * RESTRICT src, uint32 * RESTRICT dst, sint32 count, const uint32 * RESTRICT palette) = nullptr;
+
+void palette_to_32bpp_init()
+{
+    if (avx2_available())
+    {
+        log_verbose("registering AVX2 palette conversion function");
+        palette_to_32bpp_fn = palette_to_32bpp_avx2;
+    }
+    else
+    {
+        log_verbose("registering scalar palette conversion function");
+        palette_to_32bpp_fn = palette_to_32bpp_scalar;
+    }
+}
+
 void gfx_draw_pixel(rct_drawpixelinfo *dpi, sint32 x, sint32 y, sint32 colour)
 {
     gfx_fill_rect(dpi, x, y, x, y, colour);
@@ -201,6 +201,14 @@ typedef struct rct_g1_header {
 } rct_g1_header;
 assert_struct_size(rct_g1_header, 8);
 
+typedef struct image_list_stats {
+    uint32 capacity;                // Number of image IDs available to objects
+    uint32 allocated_images;
+    uint32 allocations;             // Number of allocated image lists
+    uint32 free_ranges;
+    uint32 largest_free_range;
+} image_list_stats;
+
 typedef struct rct_gx {
     rct_g1_header header;
     rct_g1_element *elements;
@@ -310,6 +318,7 @@ bool is_csg_loaded();
 uint32 gfx_object_allocate_images(const rct_g1_element * images, uint32 count);
 void gfx_object_free_images(uint32 baseImageId, uint32 count);
 void gfx_object_check_all_images_freed();
+void gfx_object_get_image_list_stats(image_list_stats * stats);
 void FASTCALL gfx_bmp_sprite_to_buffer(const uint8* palette_pointer, uint8* unknown_pointer, uint8* source_pointer, uint8* dest_pointer, const rct_g1_element* source_image, rct_drawpixelinfo *dest_dpi, sint32 height, sint32 width, sint32 image_type);
 void FASTCALL gfx_rle_sprite_to_buffer(const uint8* RESTRICT source_bits_pointer, uint8* RESTRICT dest_bits_pointer, const uint8* RESTRICT palette_pointer, const rct_drawpixelinfo * RESTRICT dpi, sint32 image_type, sint32 source_y_start, sint32 height, sint32 source_x_start, sint32 width);
 void FASTCALL gfx_draw_sprite(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint32 tertiary_colour);
@@ -367,6 +376,12 @@ void mask_scalar(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
                  uint8 * RESTRICT dst, sint32 maskWrap, sint32 colourWrap, sint32 dstWrap);
 void mask_init();
 
+void palette_to_32bpp_avx2(const uint8 * RESTRICT src, uint32 * RESTRICT dst, sint32 count, const uint32 * RESTRICT palette);
+void palette_to_32bpp_scalar(const uint8 * RESTRICT src, uint32 * RESTRICT dst, sint32 count, const uint32 * RESTRICT palette);
+void palette_to_32bpp_init();
+
+extern void (*palette_to_32bpp_fn)(const uint8 * RESTRICT src, uint32 * RESTRICT dst, sint32 count, const uint32 * RESTRICT palette);
+
 extern void (*mask_fn)(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, const uint8 * RESTRICT colourSrc,
                        uint8 * RESTRICT dst, sint32 maskWrap, sint32 colourWrap, sint32 dstWrap);
 
@@ -42,6 +42,14 @@ enum DRAWING_ENGINE_FLAGS
 struct rct_drawpixelinfo;
 struct rct_palette_entry;
 
+struct DirtyRegionStats
+{
+    // Rectangles and pixels redrawn so far this frame
+    uint32 Rects;
+    uint64 Pixels;
+    uint64 ScreenPixels;
+};
+
 namespace OpenRCT2 { namespace Drawing
 {
     interface IDrawingContext;
@@ -70,6 +78,11 @@ namespace OpenRCT2 { namespace Drawing
         virtual DRAWING_ENGINE_FLAGS GetFlags() abstract;
 
         virtual void InvalidateImage(uint32 image) abstract;
+
+        /**
+         * Gets how much of the screen has been redrawn this frame. Returns false if the engine redraws everything.
+         */
+        virtual bool GetDirtyRegionStats(DirtyRegionStats * stats) abstract;
     };
 
     interface IRainDrawer
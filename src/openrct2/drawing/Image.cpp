@@ -14,192 +14,18 @@
  *****************************************************************************/
 #pragma endregion
 
-#include <algorithm>
-#include <list>
 #include "../core/Console.hpp"
 #include "../core/Guard.hpp"
 #include "../OpenRCT2.h"
 
 #include "Drawing.h"
+#include "ImageListAllocator.h"
 
 constexpr uint32 BASE_IMAGE_ID = 29294;
 constexpr uint32 MAX_IMAGES = 262144;
 constexpr uint32 INVALID_IMAGE_ID = UINT32_MAX;
 
-struct ImageList
-{
-    uint32 BaseId;
-    uint32 Count;
-};
-
-static bool                 _initialised = false;
-static std::list<ImageList> _freeLists;
-static uint32               _allocatedImageCount;
-
-#ifdef DEBUG
-static std::list<ImageList> _allocatedLists;
-
-#pragma warning(push)
-#pragma warning(disable : 4505)
-
-static bool AllocatedListContains(uint32 baseImageId, uint32 count)
-{
-    bool contains = std::any_of(
-        _allocatedLists.begin(),
-        _allocatedLists.end(),
-        [baseImageId, count](const ImageList &imageList) -> bool
-        {
-            return imageList.BaseId == baseImageId && imageList.Count == count;
-        });
-    return contains;
-}
-
-#pragma warning(pop)
-
-static bool AllocatedListRemove(uint32 baseImageId, uint32 count)
-{
-    auto foundItem = std::find_if(
-        _allocatedLists.begin(),
-        _allocatedLists.end(),
-        [baseImageId, count](const ImageList &imageList) -> bool
-        {
-            return imageList.BaseId == baseImageId && imageList.Count == count;
-        });
-    if (foundItem != _allocatedLists.end())
-    {
-        _allocatedLists.erase(foundItem);
-        return true;
-    }
-    return false;
-}
-#endif
-
-static uint32 GetNumFreeImagesRemaining()
-{
-    return MAX_IMAGES - _allocatedImageCount;
-}
-
-static void InitialiseImageList()
-{
-    Guard::Assert(!_initialised, GUARD_LINE);
-
-    _freeLists.clear();
-    _freeLists.push_back({ BASE_IMAGE_ID, MAX_IMAGES });
-#ifdef DEBUG
-    _allocatedLists.clear();
-#endif
-    _allocatedImageCount = 0;
-    _initialised = true;
-}
-
-/**
- * Merges all the free lists into one, a process of defragmentation.
- */
-static void MergeFreeLists()
-{
-    _freeLists.sort(
-        [](const ImageList &a, const ImageList &b) -> bool
-        {
-            return a.BaseId < b.BaseId;
-        });
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
-    {
-        bool mergeHappened;
-        do
-        {
-            mergeHappened = false;
-            auto nextIt = std::next(it);
-            if (nextIt != _freeLists.end())
-            {
-                if (it->BaseId + it->Count == nextIt->BaseId)
-                {
-                    // Merge next list into this list
-                    it->Count += nextIt->Count;
-                    _freeLists.erase(nextIt);
-                    mergeHappened = true;
-                }
-            }
-        } while (mergeHappened);
-    }
-}
-
-static uint32 TryAllocateImageList(uint32 count)
-{
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
-    {
-        ImageList imageList = *it;
-        if (imageList.Count >= count)
-        {
-            _freeLists.erase(it);
-            if (imageList.Count > count)
-            {
-                ImageList remainder = { imageList.BaseId + count,
-                                        imageList.Count - count };
-                _freeLists.push_back(remainder);
-            }
-
-#ifdef DEBUG
-            _allocatedLists.push_back({ imageList.BaseId, count });
-#endif
-            _allocatedImageCount += count;
-            return imageList.BaseId;
-        }
-    }
-    return INVALID_IMAGE_ID;
-}
-
-static uint32 AllocateImageList(uint32 count)
-{
-    Guard::Assert(count != 0, GUARD_LINE);
-
-    if (!_initialised)
-    {
-        InitialiseImageList();
-    }
-
-    uint32 baseImageId = INVALID_IMAGE_ID;
-    uint32 freeImagesRemaining = GetNumFreeImagesRemaining();
-    if (freeImagesRemaining >= count)
-    {
-        baseImageId = TryAllocateImageList(count);
-        if (baseImageId == INVALID_IMAGE_ID)
-        {
-            // Defragment and try again
-            MergeFreeLists();
-            baseImageId = TryAllocateImageList(count);
-        }
-    }
-    return baseImageId;
-}
-
-static void FreeImageList(uint32 baseImageId, uint32 count)
-{
-    Guard::Assert(_initialised, GUARD_LINE);
-    Guard::Assert(baseImageId >= BASE_IMAGE_ID, GUARD_LINE);
-
-#ifdef DEBUG
-    bool contains = AllocatedListRemove(baseImageId, count);
-    Guard::Assert(contains, GUARD_LINE);
-#endif
-    _allocatedImageCount -= count;
-
-    for (auto it = _freeLists.begin(); it != _freeLists.end(); it++)
-    {
-        if (it->BaseId + it->Count == baseImageId)
-        {
-            it->Count += count;
-            return;
-        }
-        else if (baseImageId + count == it->BaseId)
-        {
-            it->BaseId = baseImageId;
-            it->Count += count;
-            return;
-        }
-    }
-
-    _freeLists.push_back({ baseImageId, count });
-}
+static ImageListAllocator _imageListAllocator(BASE_IMAGE_ID, MAX_IMAGES);
 
 extern "C"
 {
@@ -210,7 +36,7 @@ extern "C"
             return INVALID_IMAGE_ID;
         }
 
-        uint32 baseImageId = AllocateImageList(count);
+        uint32 baseImageId = _imageListAllocator.Allocate(count);
         if (baseImageId == INVALID_IMAGE_ID)
         {
             log_error("Reached maximum image limit.");
@@ -242,19 +68,32 @@ extern "C"
                 drawing_engine_invalidate_image(imageId);
             }
 
-            FreeImageList(baseImageId, count);
+            if (!_imageListAllocator.Free(baseImageId, count))
+            {
+#ifdef DEBUG
+                Guard::Assert(false, "Image list %u (%u images) was not allocated", baseImageId, count);
+#else
+                log_error("Image list %u (%u images) was not allocated", baseImageId, count);
+#endif
+            }
         }
     }
 
     void gfx_object_check_all_images_freed()
     {
-        if (_allocatedImageCount != 0)
+        uint32 allocatedImageCount = _imageListAllocator.GetAllocatedImageCount();
+        if (allocatedImageCount != 0)
         {
 #ifdef DEBUG
-            Guard::Assert(_allocatedImageCount == 0, "%u images were not freed", _allocatedImageCount);
+            Guard::Assert(allocatedImageCount == 0, "%u images were not freed", allocatedImageCount);
 #else
-            Console::Error::WriteLine("%u images were not freed", _allocatedImageCount);
+            Console::Error::WriteLine("%u images were not freed", allocatedImageCount);
 #endif
         }
     }
+
+    void gfx_object_get_image_list_stats(image_list_stats * stats)
+    {
+        *stats = _imageListAllocator.GetStats();
+    }
 }
@@ -0,0 +1,117 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../core/Guard.hpp"
+#include "ImageListAllocator.h"
+
+constexpr uint32 ImageListAllocator::INVALID_ID;
+
+ImageListAllocator::ImageListAllocator(uint32 baseId, uint32 capacity)
+    : _baseId(baseId),
+      _capacity(capacity)
+{
+    Reset();
+}
+
+void ImageListAllocator::Reset()
+{
+    _freeRangesByPosition.clear();
+    _freeRangesBySize.clear();
+    _allocations.clear();
+    _allocatedImageCount = 0;
+    AddFreeRange(_baseId, _capacity);
+}
+
+uint32 ImageListAllocator::Allocate(uint32 count)
+{
+    Guard::Assert(count != 0, GUARD_LINE);
+
+    // Smallest free range that fits, lowest ID first when there are several of the same size
+    auto bySizeIt = _freeRangesBySize.lower_bound(std::make_pair(count, 0u));
+    if (bySizeIt == _freeRangesBySize.end())
+    {
+        return INVALID_ID;
+    }
+
+    uint32 rangeCount = bySizeIt->first;
+    uint32 baseId = bySizeIt->second;
+    RemoveFreeRange(_freeRangesByPosition.find(baseId));
+    if (rangeCount > count)
+    {
+        AddFreeRange(baseId + count, rangeCount - count);
+    }
+
+    _allocations[baseId] = count;
+    _allocatedImageCount += count;
+    return baseId;
+}
+
+bool ImageListAllocator::Free(uint32 baseId, uint32 count)
+{
+    auto allocation = _allocations.find(baseId);
+    if (allocation == _allocations.end() || allocation->second != count)
+    {
+        return false;
+    }
+    _allocations.erase(allocation);
+    _allocatedImageCount -= count;
+
+    // Merge with the free ranges either side
+    auto next = _freeRangesByPosition.lower_bound(baseId);
+    if (next != _freeRangesByPosition.begin())
+    {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == baseId)
+        {
+            baseId = prev->first;
+            count += prev->second;
+            RemoveFreeRange(prev);
+        }
+    }
+    if (next != _freeRangesByPosition.end() && baseId + count == next->first)
+    {
+        count += next->second;
+        RemoveFreeRange(next);
+    }
+    AddFreeRange(baseId, count);
+    return true;
+}
+
+image_list_stats ImageListAllocator::GetStats() const
+{
+    image_list_stats stats = { 0 };
+    stats.capacity = _capacity;
+    stats.allocated_images = _allocatedImageCount;
+    stats.allocations = (uint32)_allocations.size();
+    stats.free_ranges = (uint32)_freeRangesByPosition.size();
+    if (!_freeRangesBySize.empty())
+    {
+        stats.largest_free_range = _freeRangesBySize.rbegin()->first;
+    }
+    return stats;
+}
+
+void ImageListAllocator::AddFreeRange(uint32 baseId, uint32 count)
+{
+    _freeRangesByPosition[baseId] = count;
+    _freeRangesBySize.emplace(count, baseId);
+}
+
+void ImageListAllocator::RemoveFreeRange(std::map<uint32, uint32>::iterator it)
+{
+    _freeRangesBySize.erase(std::make_pair(it->second, it->first));
+    _freeRangesByPosition.erase(it);
+}
@@ -0,0 +1,75 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include "../common.h"
+#include "Drawing.h"
+
+/**
+ * Allocates contiguous ranges of image IDs. Free ranges are indexed by position and by size, so allocating (best fit)
+ * and freeing are O(log n) in the number of free ranges, and freed ranges are merged with their neighbours straight away.
+ */
+class ImageListAllocator final
+{
+public:
+    static constexpr uint32 INVALID_ID = UINT32_MAX;
+
+private:
+    uint32 const _baseId;
+    uint32 const _capacity;
+
+    // Base ID to count
+    std::map<uint32, uint32>                _freeRangesByPosition;
+    // Count and base ID
+    std::set<std::pair<uint32, uint32>>     _freeRangesBySize;
+    // Base ID to count
+    std::unordered_map<uint32, uint32>      _allocations;
+    uint32                                  _allocatedImageCount = 0;
+
+public:
+    ImageListAllocator(uint32 baseId, uint32 capacity);
+
+    /**
+     * Frees every allocation.
+     */
+    void Reset();
+
+    /**
+     * Allocates count contiguous image IDs and returns the first, or INVALID_ID if there is no free range large enough.
+     */
+    uint32 Allocate(uint32 count);
+
+    /**
+     * Frees a range returned by Allocate. Returns false if the range was not allocated.
+     */
+    bool Free(uint32 baseId, uint32 count);
+
+    uint32 GetAllocatedImageCount() const { return _allocatedImageCount; }
+    image_list_stats GetStats() const;
+
+private:
+    void AddFreeRange(uint32 baseId, uint32 count);
+    void RemoveFreeRange(std::map<uint32, uint32>::iterator it);
+};
+
+#endif
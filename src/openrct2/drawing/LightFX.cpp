@@ -18,8 +18,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include "../common.h"
 #include "../config/Config.h"
+#include "../core/JobPool.hpp"
 #include "../Game.h"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
@@ -29,6 +33,38 @@
 #include "Drawing.h"
 #include "LightFX.h"
 
+// Bands smaller than this are not worth handing to another thread
+#define LIGHTFX_MIN_BAND_HEIGHT 64
+
+static std::unique_ptr<JobPool> _lightfxJobPool;
+
+/**
+ * Splits the rows [0, height) into bands and calls fn(top, bottom) for each band on the light job pool.
+ */
+template<typename TFunc>
+static void lightfx_for_each_band(sint32 height, TFunc fn)
+{
+    if (_lightfxJobPool == nullptr)
+    {
+        _lightfxJobPool = std::make_unique<JobPool>();
+    }
+
+    sint32 numBands = std::min((sint32)_lightfxJobPool->CountThreads(), height / LIGHTFX_MIN_BAND_HEIGHT);
+    if (numBands <= 1)
+    {
+        fn(0, height);
+        return;
+    }
+
+    sint32 bandHeight = (height + numBands - 1) / numBands;
+    for (sint32 top = 0; top < height; top += bandHeight)
+    {
+        sint32 bottom = std::min(height, top + bandHeight);
+        _lightfxJobPool->AddTask([&fn, top, bottom]() { fn(top, bottom); });
+    }
+    _lightfxJobPool->Join();
+}
+
 extern "C"
 {
 
@@ -80,6 +116,37 @@ static uint8            _current_view_zoom_back_delay   = 0;
 
 static rct_palette gPalette_light;
 
+// A light clipped to the light buffer, ready to be added to it
+typedef struct lightfx_blit {
+    const uint8 *   src;
+    sint32          srcPitch;
+    sint32          x, y;
+    sint32          width, height;
+    uint8           intensity;
+} lightfx_blit;
+
+static std::vector<lightfx_blit> _lightBlits;
+
+/**
+ * The occlusion result of a light, which only has to be sampled again when the light or the view rotation or zoom
+ * changes.
+ */
+typedef struct lightfx_occlusion_cache_entry {
+    sint16  x, y, z;
+    uint8   rotation;
+    uint8   zoom;
+    uint32  occlusion;
+    sint32  samplePoints;
+    uint32  lastFrame;
+} lightfx_occlusion_cache_entry;
+
+static std::unordered_map<uint64, lightfx_occlusion_cache_entry> _lightOcclusionCache;
+static uint32 _lightOcclusionCacheFrame = 0;
+
+static void (*lightfx_add_light_row_fn)(uint8 * RESTRICT dst, const uint8 * RESTRICT src, sint32 count, uint8 intensity) = lightfx_add_light_row_scalar;
+static void (*lightfx_mix_row_fn)(uint32 * RESTRICT dst, const uint8 * RESTRICT bits, const uint8 * RESTRICT lightBits, sint32 count,
+                                  const uint32 * RESTRICT palette, const uint32 * RESTRICT lightPalette) = lightfx_mix_row_scalar;
+
 static uint8 calc_light_intensity_lantern(sint32 x, sint32 y) {
     double distance = (double)(x * x + y * y);
 
@@ -129,6 +196,19 @@ void lightfx_init()
     _LightListBack      = _LightListA;
     _LightListFront     = _LightListB;
 
+    if (sse41_available())
+    {
+        log_verbose("registering SSE4.1 light functions");
+        lightfx_add_light_row_fn = lightfx_add_light_row_sse4_1;
+        lightfx_mix_row_fn = lightfx_mix_row_sse4_1;
+    }
+    else
+    {
+        log_verbose("registering scalar light functions");
+        lightfx_add_light_row_fn = lightfx_add_light_row_scalar;
+        lightfx_mix_row_fn = lightfx_mix_row_scalar;
+    }
+
     memset(_bakedLightTexture_lantern_0, 0xFF, 32 * 32);
     memset(_bakedLightTexture_lantern_1, 0xFF, 64 * 64);
     memset(_bakedLightTexture_lantern_2, 0xFF, 128 * 128);
@@ -171,8 +251,205 @@ void lightfx_update_buffers(rct_drawpixelinfo *info)
 
 extern void viewport_paint_setup();
 
+static void lightfx_sample_light_occlusion(const lightlist_entry *entry, const LocationXYZ16 *coord_3d, uint32 *outOcclusion, sint32 *outSamplePoints)
+{
+    uint32 lightIntensityOccluded = 0x0;
+
+    sint32 dirVecX = 707;
+    sint32 dirVecY = 707;
+
+    switch (_current_view_rotation_front) {
+    case 0:
+        dirVecX = 707;
+        dirVecY = 707;
+        break;
+    case 1:
+        dirVecX = -707;
+        dirVecY = 707;
+        break;
+    case 2:
+        dirVecX = -707;
+        dirVecY = -707;
+        break;
+    case 3:
+        dirVecX = 707;
+        dirVecY = -707;
+        break;
+    default:
+        dirVecX = 0;
+        dirVecY = 0;
+        break;
+    }
+
+#ifdef LIGHTFX_UNKNOWN_PART_1
+    sint32 tileOffsetX = 0;
+    sint32 tileOffsetY = 0;
+    switch (_current_view_rotation_front) {
+    case 0:
+        tileOffsetX = 0;
+        tileOffsetY = 0;
+        break;
+    case 1:
+        tileOffsetX = 16;
+        tileOffsetY = 0;
+        break;
+    case 2:
+        tileOffsetX = 32;
+        tileOffsetY = 32;
+        break;
+    case 3:
+        tileOffsetX = 0;
+        tileOffsetY = 16;
+        break;
+    }
+
+    sint32 mapFrontDiv = 1 << _current_view_zoom_front;
+    static sint16 offsetPattern[26] = {     0, 0,       -4, 0,      0, -3,      4, 0,       0, 3,
+                                                        -2, -1,     -1, -1,     2, 1,       1, 1,
+                                                        -3, -2,     -3, 2,      3, -2,      3, 2    };
+#endif //LIGHTFX_UNKNOWN_PART_1
+
+    sint32 totalSamplePoints = 5;
+    sint32 startSamplePoint = 1;
+    // sint32 lastSampleCount = 0;
+
+    if ((entry->lightIDqualifier & 0xF) == LIGHTFX_LIGHT_QUALIFIER_MAP) {
+        startSamplePoint = 0;
+        totalSamplePoints = 1;
+    }
+
+    for (sint32 pat = startSamplePoint; pat < totalSamplePoints; pat++) {
+        LocationXY16 mapCoord = { 0 };
+
+        rct_tile_element *tileElement = nullptr;
+
+        sint32 interactionType = 0;
+
+        rct_window *w = window_get_main();
+        if (w != nullptr) {
+        //  get_map_coordinates_from_pos(entry->x + offsetPattern[pat*2] / mapFrontDiv, entry->y + offsetPattern[pat*2+1] / mapFrontDiv, VIEWPORT_INTERACTION_MASK_NONE, &mapCoord.x, &mapCoord.y, &interactionType, &tileElement, NULL);
+
+#ifdef LIGHTFX_UNKNOWN_PART_1
+            _unk9AC154 = ~VIEWPORT_INTERACTION_MASK_SPRITE & 0xFFFF;
+            _viewportDpi1.zoom = _current_view_zoom_front;
+            _viewportDpi1.x = entry->x + offsetPattern[0 + pat * 2] / mapFrontDiv;
+            _viewportDpi1.y = entry->y + offsetPattern[1 + pat * 2] / mapFrontDiv;
+            rct_drawpixelinfo* dpi = &_viewportDpi2;
+            dpi->x = _viewportDpi1.x;
+            dpi->y = _viewportDpi1.y;
+            dpi->zoom_level = _viewportDpi1.zoom;
+            dpi->height = 1;
+            dpi->width = 1;
+            gPaintSession.EndOfPaintStructArray = 0xF1A4CC;
+            gPaintSession.Unk140E9A8 = dpi;
+            painter_setup();
+            viewport_paint_setup();
+            paint_session_arrange(gPaintSession);
+            sub_68862C();
+
+        //  log_warning("[%i, %i]", dpi->x, dpi->y);
+
+            mapCoord.x = _interactionMapX + tileOffsetX;
+            mapCoord.y = _interactionMapY + tileOffsetY;
+            interactionType = _interactionSpriteType;
+            tileElement = RCT2_GLOBAL(0x9AC150, rct_tile_element*);
+#endif //LIGHTFX_UNKNOWN_PART_1
+
+            //RCT2_GLOBAL(0x9AC154, uint16_t) = VIEWPORT_INTERACTION_MASK_NONE;
+            //RCT2_GLOBAL(0x9AC148, uint8_t) = 0;
+            //RCT2_GLOBAL(0x9AC138 + 4, int16_t) = screenX;
+            //RCT2_GLOBAL(0x9AC138 + 6, int16_t) = screenY;
+            //if (screenX >= 0 && screenX < (sint32)myviewport->width && screenY >= 0 && screenY < (sint32)myviewport->height)
+            //{
+            //  screenX <<= myviewport->zoom;
+            //  screenY <<= myviewport->zoom;
+            //  screenX += (sint32)myviewport->view_x;
+            //  screenY += (sint32)myviewport->view_y;
+            //  RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_ZOOM, uint16_t) = myviewport->zoom;
+            //  screenX &= (0xFFFF << myviewport->zoom) & 0xFFFF;
+            //  screenY &= (0xFFFF << myviewport->zoom) & 0xFFFF;
+            //  RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_X, int16_t) = screenX;
+            //  RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_Y, int16_t) = screenY;
+            //  rct_drawpixelinfo* dpi = RCT2_ADDRESS(RCT2_ADDRESS_VIEWPORT_DPI, rct_drawpixelinfo);
+            //  dpi->y = RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_Y, int16_t);
+            //  dpi->height = 1;
+            //  dpi->zoom_level = RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_ZOOM, uint16_t);
+            //  dpi->x = RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_X, int16_t);
+            //  dpi->width = 1;
+            //  RCT2_GLOBAL(0xEE7880, uint32_t) = 0xF1A4CC;
+            //  RCT2_GLOBAL(0x140E9A8, rct_drawpixelinfo*) = dpi;
+            //  painter_setup();
+            //  viewport_paint_setup();
+            //  paint_session_arrange(gPaintSession);
+            //  sub_68862C();
+            //}
+        }
+
+        sint32 minDist = 0;
+        sint32 baseHeight = -999;
+
+        if (interactionType != VIEWPORT_INTERACTION_ITEM_SPRITE && tileElement) {
+            baseHeight = tileElement->base_height;
+        }
+
+        minDist = ((baseHeight * 8) - coord_3d->z) / 2;
+
+        sint32 deltaX = mapCoord.x - coord_3d->x;
+        sint32 deltaY = mapCoord.y - coord_3d->y;
+
+        sint32 projDot = (dirVecX * deltaX + dirVecY * deltaY) / 1000;
+
+        projDot = std::max(minDist, projDot);
+
+        if (projDot < 5) {
+            lightIntensityOccluded  += 100;
+        }
+        else {
+            lightIntensityOccluded  += std::max(0, 200 - (projDot * 20));
+        }
+
+    //  log_warning("light %i [%i, %i, %i], [%i, %i] minDist to %i: %i; projdot: %i", light, coord_3d->x, coord_3d->y, coord_3d->z, mapCoord.x, mapCoord.y, baseHeight, minDist, projDot);
+
+
+        if (pat == 0) {
+            if (lightIntensityOccluded == 100)
+                break;
+            if (_current_view_zoom_front > 2)
+                break;
+            totalSamplePoints += 4;
+        }
+        else if (pat == 4) {
+            if (_current_view_zoom_front > 1)
+                break;
+            if (lightIntensityOccluded == 0 || lightIntensityOccluded == 500)
+                break;
+            // lastSampleCount = lightIntensityOccluded / 500;
+        //  break;
+            totalSamplePoints += 4;
+        }
+        else if (pat == 8) {
+            break;
+            // if (_current_view_zoom_front > 0)
+            //  break;
+            // sint32 newSampleCount = lightIntensityOccluded / 900;
+            // if (abs(newSampleCount - lastSampleCount) < 10)
+            //  break;
+            // totalSamplePoints += 4;
+        }
+    }
+
+    totalSamplePoints -= startSamplePoint;
+
+    *outOcclusion = lightIntensityOccluded;
+    *outSamplePoints = totalSamplePoints;
+}
+
 void lightfx_prepare_light_list()
 {
+    if (++_lightOcclusionCacheFrame == 0) {
+        _lightOcclusionCacheFrame = 1;
+    }
+
     for (uint32 light = 0; light < LightListCurrentCountFront; light++) {
         lightlist_entry *entry = &_LightListFront[light];
 
@@ -210,208 +487,46 @@ void lightfx_prepare_light_list()
     //  entry->x >>= _current_view_zoom_front;
     //  entry->y >>= _current_view_zoom_front;
 
-        uint32 lightIntensityOccluded = 0x0;
-
-        sint32 dirVecX = 707;
-        sint32 dirVecY = 707;
-
-        switch (_current_view_rotation_front) {
-        case 0:
-            dirVecX = 707;
-            dirVecY = 707;
-            break;
-        case 1:
-            dirVecX = -707;
-            dirVecY = 707;
-            break;
-        case 2:
-            dirVecX = -707;
-            dirVecY = -707;
-            break;
-        case 3:
-            dirVecX = 707;
-            dirVecY = -707;
-            break;
-        default:
-            dirVecX = 0;
-            dirVecY = 0;
-            break;
+        uint32 lightIntensityOccluded;
+        sint32 totalSamplePoints;
+
+        // Sampling the occlusion is expensive, so reuse the last result while neither the light nor the view has moved
+        uint64 cacheKey = ((uint64)entry->lightID << 16) | entry->lightIDqualifier;
+        lightfx_occlusion_cache_entry *cached = &_lightOcclusionCache[cacheKey];
+        if (cached->lastFrame != 0 &&
+            cached->x == coord_3d.x &&
+            cached->y == coord_3d.y &&
+            cached->z == coord_3d.z &&
+            cached->rotation == _current_view_rotation_front &&
+            cached->zoom == _current_view_zoom_front) {
+            lightIntensityOccluded = cached->occlusion;
+            totalSamplePoints = cached->samplePoints;
         }
-
-#ifdef LIGHTFX_UNKNOWN_PART_1
-        sint32 tileOffsetX = 0;
-        sint32 tileOffsetY = 0;
-        switch (_current_view_rotation_front) {
-        case 0:
-            tileOffsetX = 0;
-            tileOffsetY = 0;
-            break;
-        case 1:
-            tileOffsetX = 16;
-            tileOffsetY = 0;
-            break;
-        case 2:
-            tileOffsetX = 32;
-            tileOffsetY = 32;
-            break;
-        case 3:
-            tileOffsetX = 0;
-            tileOffsetY = 16;
-            break;
+        else {
+            lightfx_sample_light_occlusion(entry, &coord_3d, &lightIntensityOccluded, &totalSamplePoints);
+            cached->x = coord_3d.x;
+            cached->y = coord_3d.y;
+            cached->z = coord_3d.z;
+            cached->rotation = _current_view_rotation_front;
+            cached->zoom = _current_view_zoom_front;
+            cached->occlusion = lightIntensityOccluded;
+            cached->samplePoints = totalSamplePoints;
         }
-
-        sint32 mapFrontDiv = 1 << _current_view_zoom_front;
-        static sint16 offsetPattern[26] = {     0, 0,       -4, 0,      0, -3,      4, 0,       0, 3,
-                                                            -2, -1,     -1, -1,     2, 1,       1, 1,
-                                                            -3, -2,     -3, 2,      3, -2,      3, 2    };
-#endif //LIGHTFX_UNKNOWN_PART_1
-
-        if (true) {
-            sint32 totalSamplePoints = 5;
-            sint32 startSamplePoint = 1;
-            // sint32 lastSampleCount = 0;
-
-            if ((entry->lightIDqualifier & 0xF) == LIGHTFX_LIGHT_QUALIFIER_MAP) {
-                startSamplePoint = 0;
-                totalSamplePoints = 1;
-            }
-
-            for (sint32 pat = startSamplePoint; pat < totalSamplePoints; pat++) {
-                LocationXY16 mapCoord = { 0 };
-
-                rct_tile_element *tileElement = nullptr;
-
-                sint32 interactionType = 0;
-
-                rct_window *w = window_get_main();
-                if (w != nullptr) {
-                //  get_map_coordinates_from_pos(entry->x + offsetPattern[pat*2] / mapFrontDiv, entry->y + offsetPattern[pat*2+1] / mapFrontDiv, VIEWPORT_INTERACTION_MASK_NONE, &mapCoord.x, &mapCoord.y, &interactionType, &tileElement, NULL);
-
-#ifdef LIGHTFX_UNKNOWN_PART_1
-                    _unk9AC154 = ~VIEWPORT_INTERACTION_MASK_SPRITE & 0xFFFF;
-                    _viewportDpi1.zoom = _current_view_zoom_front;
-                    _viewportDpi1.x = entry->x + offsetPattern[0 + pat * 2] / mapFrontDiv;
-                    _viewportDpi1.y = entry->y + offsetPattern[1 + pat * 2] / mapFrontDiv;
-                    rct_drawpixelinfo* dpi = &_viewportDpi2;
-                    dpi->x = _viewportDpi1.x;
-                    dpi->y = _viewportDpi1.y;
-                    dpi->zoom_level = _viewportDpi1.zoom;
-                    dpi->height = 1;
-                    dpi->width = 1;
-                    gPaintSession.EndOfPaintStructArray = 0xF1A4CC;
-                    gPaintSession.Unk140E9A8 = dpi;
-                    painter_setup();
-                    viewport_paint_setup();
-                    paint_session_arrange(gPaintSession);
-                    sub_68862C();
-
-                //  log_warning("[%i, %i]", dpi->x, dpi->y);
-
-                    mapCoord.x = _interactionMapX + tileOffsetX;
-                    mapCoord.y = _interactionMapY + tileOffsetY;
-                    interactionType = _interactionSpriteType;
-                    tileElement = RCT2_GLOBAL(0x9AC150, rct_tile_element*);
-#endif //LIGHTFX_UNKNOWN_PART_1
-
-                    //RCT2_GLOBAL(0x9AC154, uint16_t) = VIEWPORT_INTERACTION_MASK_NONE;
-                    //RCT2_GLOBAL(0x9AC148, uint8_t) = 0;
-                    //RCT2_GLOBAL(0x9AC138 + 4, int16_t) = screenX;
-                    //RCT2_GLOBAL(0x9AC138 + 6, int16_t) = screenY;
-                    //if (screenX >= 0 && screenX < (sint32)myviewport->width && screenY >= 0 && screenY < (sint32)myviewport->height)
-                    //{
-                    //  screenX <<= myviewport->zoom;
-                    //  screenY <<= myviewport->zoom;
-                    //  screenX += (sint32)myviewport->view_x;
-                    //  screenY += (sint32)myviewport->view_y;
-                    //  RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_ZOOM, uint16_t) = myviewport->zoom;
-                    //  screenX &= (0xFFFF << myviewport->zoom) & 0xFFFF;
-                    //  screenY &= (0xFFFF << myviewport->zoom) & 0xFFFF;
-                    //  RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_X, int16_t) = screenX;
-                    //  RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_Y, int16_t) = screenY;
-                    //  rct_drawpixelinfo* dpi = RCT2_ADDRESS(RCT2_ADDRESS_VIEWPORT_DPI, rct_drawpixelinfo);
-                    //  dpi->y = RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_Y, int16_t);
-                    //  dpi->height = 1;
-                    //  dpi->zoom_level = RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_ZOOM, uint16_t);
-                    //  dpi->x = RCT2_GLOBAL(RCT2_ADDRESS_VIEWPORT_PAINT_X, int16_t);
-                    //  dpi->width = 1;
-                    //  RCT2_GLOBAL(0xEE7880, uint32_t) = 0xF1A4CC;
-                    //  RCT2_GLOBAL(0x140E9A8, rct_drawpixelinfo*) = dpi;
-                    //  painter_setup();
-                    //  viewport_paint_setup();
-                    //  paint_session_arrange(gPaintSession);
-                    //  sub_68862C();
-                    //}
-                }
-
-                sint32 minDist = 0;
-                sint32 baseHeight = -999;
-
-                if (interactionType != VIEWPORT_INTERACTION_ITEM_SPRITE && tileElement) {
-                    baseHeight = tileElement->base_height;
-                }
-
-                minDist = ((baseHeight * 8) - coord_3d.z) / 2;
-
-                sint32 deltaX = mapCoord.x - coord_3d.x;
-                sint32 deltaY = mapCoord.y - coord_3d.y;
-
-                sint32 projDot = (dirVecX * deltaX + dirVecY * deltaY) / 1000;
-
-                projDot = std::max(minDist, projDot);
-
-                if (projDot < 5) {
-                    lightIntensityOccluded  += 100;
-                }
-                else {
-                    lightIntensityOccluded  += std::max(0, 200 - (projDot * 20));
-                }
-
-            //  log_warning("light %i [%i, %i, %i], [%i, %i] minDist to %i: %i; projdot: %i", light, coord_3d.x, coord_3d.y, coord_3d.z, mapCoord.x, mapCoord.y, baseHeight, minDist, projDot);
-
-
-                if (pat == 0) {
-                    if (lightIntensityOccluded == 100)
-                        break;
-                    if (_current_view_zoom_front > 2)
-                        break;
-                    totalSamplePoints += 4;
-                }
-                else if (pat == 4) {
-                    if (_current_view_zoom_front > 1)
-                        break;
-                    if (lightIntensityOccluded == 0 || lightIntensityOccluded == 500)
-                        break;
-                    // lastSampleCount = lightIntensityOccluded / 500;
-                //  break;
-                    totalSamplePoints += 4;
-                }
-                else if (pat == 8) {
-                    break;
-                    // if (_current_view_zoom_front > 0)
-                    //  break;
-                    // sint32 newSampleCount = lightIntensityOccluded / 900;
-                    // if (abs(newSampleCount - lastSampleCount) < 10)
-                    //  break;
-                    // totalSamplePoints += 4;
-                }
-            }
-
-            totalSamplePoints -= startSamplePoint;
+        cached->lastFrame = _lightOcclusionCacheFrame;
 
         //  lightIntensityOccluded = totalSamplePoints * 100;
 
         //  log_warning("sample-count: %i, occlusion: %i", totalSamplePoints, lightIntensityOccluded);
 
-            if (lightIntensityOccluded == 0) {
-                entry->lightType = LIGHTFX_LIGHT_TYPE_NONE;
-                continue;
-            }
+        if (lightIntensityOccluded == 0) {
+            entry->lightType = LIGHTFX_LIGHT_TYPE_NONE;
+            continue;
+        }
 
         //  log_warning("sample-count: %i, occlusion: %i", totalSamplePoints, lightIntensityOccluded / totalSamplePoints);
 
-            entry->lightIntensity = std::min<uint32>(0xFF, (entry->lightIntensity * lightIntensityOccluded) / (totalSamplePoints * 100));
-            entry->lightIntensity = std::max<uint32>(0x00, entry->lightIntensity - _current_view_zoom_front * 5);
-        }
+        entry->lightIntensity = std::min<uint32>(0xFF, (entry->lightIntensity * lightIntensityOccluded) / (totalSamplePoints * 100));
+        entry->lightIntensity = std::max<uint32>(0x00, entry->lightIntensity - _current_view_zoom_front * 5);
 
         if (_current_view_zoom_front > 0) {
             if ((entry->lightType & 0x3) < _current_view_zoom_front) {
@@ -422,6 +537,18 @@ void lightfx_prepare_light_list()
             entry->lightType -= _current_view_zoom_front;
         }
     }
+
+    // Forget the occlusion of lights that are no longer on screen
+    if (_lightOcclusionCache.size() > 2 * LightListCurrentCountFront + 1024) {
+        for (auto it = _lightOcclusionCache.begin(); it != _lightOcclusionCache.end();) {
+            if (it->second.lastFrame != _lightOcclusionCacheFrame) {
+                it = _lightOcclusionCache.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
 }
 
 void lightfx_swap_buffers()
@@ -469,19 +596,16 @@ void lightfx_render_lights_to_frontbuffer()
         return;
     }
 
-    memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
-
     _lightPolution_back = 0;
+    _lightBlits.clear();
 
 //  log_warning("%i lights", LightListCurrentCountFront);
 
     for (uint32 light = 0; light < LightListCurrentCountFront; light++) {
         const uint8 *bufReadBase    = nullptr;
-        uint8       *bufWriteBase   = (uint8 *)_light_rendered_buffer_front;
         uint32      bufReadWidth, bufReadHeight;
         sint32      bufWriteX, bufWriteY;
         sint32      bufWriteWidth, bufWriteHeight;
-        uint32      bufReadSkip, bufWriteSkip;
 
         lightlist_entry * entry = &_LightListFront[light];
 
@@ -549,9 +673,7 @@ void lightfx_render_lights_to_frontbuffer()
         if (bufWriteX < 0) {
             bufReadBase     += -bufWriteX;
             bufWriteWidth   += bufWriteX;
-        }
-        else {
-            bufWriteBase    += bufWriteX;
+            bufWriteX       = 0;
         }
 
         if (bufWriteWidth <= 0)
@@ -560,9 +682,7 @@ void lightfx_render_lights_to_frontbuffer()
         if (bufWriteY < 0) {
             bufReadBase     += -bufWriteY * bufReadWidth;
             bufWriteHeight  += bufWriteY;
-        }
-        else {
-            bufWriteBase    += bufWriteY * _pixelInfo.width;
+            bufWriteY       = 0;
         }
 
 
@@ -586,33 +706,41 @@ void lightfx_render_lights_to_frontbuffer()
 
         _lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
 
-        bufReadSkip     = bufReadWidth - bufWriteWidth;
-        bufWriteSkip    = _pixelInfo.width - bufWriteWidth;
-
-        if (entry->lightIntensity == 0xFF) {
-            for (sint32 y = 0; y < bufWriteHeight; y++) {
-                for (sint32 x = 0; x < bufWriteWidth; x++) {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + *bufReadBase);
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
+        lightfx_blit blit;
+        blit.src = bufReadBase;
+        blit.srcPitch = bufReadWidth;
+        blit.x = bufWriteX;
+        blit.y = bufWriteY;
+        blit.width = bufWriteWidth;
+        blit.height = bufWriteHeight;
+        blit.intensity = entry->lightIntensity;
+        _lightBlits.push_back(blit);
+    }
 
-                bufWriteBase    += bufWriteSkip;
-                bufReadBase     += bufReadSkip;
+    // Each band clears and lights its own rows, so the bands can be done in parallel
+    uint8 *lightBuffer = (uint8 *)_light_rendered_buffer_front;
+    sint32 bufferWidth = _pixelInfo.width;
+    lightfx_for_each_band(_pixelInfo.height, [lightBuffer, bufferWidth](sint32 top, sint32 bottom) {
+        memset(lightBuffer + top * bufferWidth, 0, (bottom - top) * bufferWidth);
+        for (const lightfx_blit &blit : _lightBlits) {
+            sint32 startY = std::max(top, blit.y);
+            sint32 endY = std::min(bottom, blit.y + blit.height);
+            for (sint32 y = startY; y < endY; y++) {
+                lightfx_add_light_row_fn(
+                    lightBuffer + y * bufferWidth + blit.x,
+                    blit.src + (y - blit.y) * blit.srcPitch,
+                    blit.width,
+                    blit.intensity);
             }
         }
-        else {
-            for (sint32 y = 0; y < bufWriteHeight; y++) {
-                for (sint32 x = 0; x < bufWriteWidth; x++) {
-                    *bufWriteBase = std::min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->lightIntensity)) >> 8));
-                    bufWriteBase++;
-                    bufReadBase++;
-                }
+    });
+}
 
-                bufWriteBase += bufWriteSkip;
-                bufReadBase += bufReadSkip;
-            }
-        }
+void lightfx_add_light_row_scalar(uint8 * RESTRICT dst, const uint8 * RESTRICT src, sint32 count, uint8 intensity)
+{
+    // (src * 256) >> 8 == src, so lights at full intensity are added as they are
+    for (sint32 x = 0; x < count; x++) {
+        dst[x] = std::min(0xFF, dst[x] + ((src[x] * (1 + intensity)) >> 8));
     }
 }
 
@@ -994,26 +1122,33 @@ void lightfx_render_to_texture(
         return;
     }
 
-    for (uint32 y = 0; y < height; y++) {
-        uintptr_t dstOffset = (uintptr_t)(y * dstPitch);
-        uint32 * dst = (uint32 *)((uintptr_t)dstPixels + dstOffset);
-        for (uint32 x = 0; x < width; x++) {
-            uint8 * src = &bits[y * width + x];
-            uint32 darkColour = palette[*src];
-            uint32 lightColour = lightPalette[*src];
-            uint8 lightIntensity = lightBits[y * width + x];
-
-            uint32 colour = 0;
-            if (lightIntensity == 0) {
-                colour = darkColour;
-            } else {
-                colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
-                colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
-                colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
-                colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
-            }
-            *dst++ = colour;
+    lightfx_for_each_band((sint32)height, [=](sint32 top, sint32 bottom) {
+        for (sint32 y = top; y < bottom; y++) {
+            uintptr_t dstOffset = (uintptr_t)(y * dstPitch);
+            uint32 * dst = (uint32 *)((uintptr_t)dstPixels + dstOffset);
+            lightfx_mix_row_fn(dst, &bits[y * width], &lightBits[y * width], width, palette, lightPalette);
+        }
+    });
+}
+
+void lightfx_mix_row_scalar(uint32 * RESTRICT dst, const uint8 * RESTRICT bits, const uint8 * RESTRICT lightBits, sint32 count,
+                            const uint32 * RESTRICT palette, const uint32 * RESTRICT lightPalette)
+{
+    for (sint32 x = 0; x < count; x++) {
+        uint32 darkColour = palette[bits[x]];
+        uint32 lightColour = lightPalette[bits[x]];
+        uint8 lightIntensity = lightBits[x];
+
+        uint32 colour = 0;
+        if (lightIntensity == 0) {
+            colour = darkColour;
+        } else {
+            colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
+            colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
+            colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
+            colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
         }
+        dst[x] = colour;
     }
 }
 
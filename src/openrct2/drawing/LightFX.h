@@ -82,6 +82,13 @@ void lightfx_render_to_texture(
     const uint32 * palette,
     const uint32 * lightPalette);
 
+void lightfx_add_light_row_scalar(uint8 * RESTRICT dst, const uint8 * RESTRICT src, sint32 count, uint8 intensity);
+void lightfx_add_light_row_sse4_1(uint8 * RESTRICT dst, const uint8 * RESTRICT src, sint32 count, uint8 intensity);
+void lightfx_mix_row_scalar(uint32 * RESTRICT dst, const uint8 * RESTRICT bits, const uint8 * RESTRICT lightBits, sint32 count,
+                            const uint32 * RESTRICT palette, const uint32 * RESTRICT lightPalette);
+void lightfx_mix_row_sse4_1(uint32 * RESTRICT dst, const uint8 * RESTRICT bits, const uint8 * RESTRICT lightBits, sint32 count,
+                            const uint32 * RESTRICT palette, const uint32 * RESTRICT lightPalette);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "Drawing.h"
+#include "LightFX.h"
 
 #ifdef __SSE4_1__
 
@@ -62,6 +63,56 @@ void mask_sse4_1(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     }
 }
 
+#ifdef __ENABLE_LIGHTFX__
+
+void lightfx_add_light_row_sse4_1(uint8 * RESTRICT dst, const uint8 * RESTRICT src, sint32 count, uint8 intensity)
+{
+    // (src * (1 + intensity)) >> 8 fits in 16 bits, so 8 pixels can be scaled at once
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i factor = _mm_set1_epi16(1 + intensity);
+    sint32 i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i light = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(light, zero), factor), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(light, zero), factor), 8);
+        const __m128i scaled = _mm_packus_epi16(lo, hi);
+        const __m128i current = _mm_loadu_si128((const __m128i *)(dst + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_adds_epu8(current, scaled));
+    }
+    lightfx_add_light_row_scalar(dst + i, src + i, count - i, intensity);
+}
+
+void lightfx_mix_row_sse4_1(uint32 * RESTRICT dst, const uint8 * RESTRICT bits, const uint8 * RESTRICT lightBits, sint32 count,
+                            const uint32 * RESTRICT palette, const uint32 * RESTRICT lightPalette)
+{
+    // Each channel is dark + ((light * intensity * 6) >> 8). Shifting light into the high byte lets
+    // _mm_mulhi_epu16 do the multiply and shift in one go, and packing saturates the sum to 255.
+    const __m128i zero = _mm_setzero_si128();
+    sint32 i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i dark = _mm_set_epi32(palette[bits[i + 3]], palette[bits[i + 2]], palette[bits[i + 1]], palette[bits[i]]);
+        const __m128i light = _mm_set_epi32(
+            lightPalette[bits[i + 3]], lightPalette[bits[i + 2]], lightPalette[bits[i + 1]], lightPalette[bits[i]]);
+        const sint16 k0 = lightBits[i] * 6;
+        const sint16 k1 = lightBits[i + 1] * 6;
+        const sint16 k2 = lightBits[i + 2] * 6;
+        const sint16 k3 = lightBits[i + 3] * 6;
+        const __m128i intensityLo = _mm_set_epi16(k1, k1, k1, k1, k0, k0, k0, k0);
+        const __m128i intensityHi = _mm_set_epi16(k3, k3, k3, k3, k2, k2, k2, k2);
+
+        const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(dark, zero),
+                                         _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, light), intensityLo));
+        const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(dark, zero),
+                                         _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, light), intensityHi));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    lightfx_mix_row_scalar(dst + i, bits + i, lightBits + i, count - i, palette, lightPalette);
+}
+
+#endif // __ENABLE_LIGHTFX__
+
 #else
 
 #ifdef OPENRCT2_X86
@@ -74,4 +125,19 @@ void mask_sse4_1(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
 }
 
+#ifdef __ENABLE_LIGHTFX__
+
+void lightfx_add_light_row_sse4_1(uint8 * RESTRICT dst, const uint8 * RESTRICT src, sint32 count, uint8 intensity)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+void lightfx_mix_row_sse4_1(uint32 * RESTRICT dst, const uint8 * RESTRICT bits, const uint8 * RESTRICT lightBits, sint32 count,
+                            const uint32 * RESTRICT palette, const uint32 * RESTRICT lightPalette)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#endif // __ENABLE_LIGHTFX__
+
 #endif // __SSE4_1__
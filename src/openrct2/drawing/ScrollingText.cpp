@@ -15,11 +15,17 @@
 #pragma endregion
 
 #include <algorithm>
+#include <cctype>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "../config/Config.h"
 #include "../interface/Colour.h"
+#include "../localisation/FormatStringCache.h"
 #include "../localisation/Localisation.h"
 #include "../paint/Paint.h"
 #include "../sprites.h"
+#include "../util/Util.h"
 #include "Drawing.h"
 #include "TTF.h"
 
@@ -38,13 +44,53 @@ assert_struct_size(rct_draw_scroll_text, 0xA12);
 #pragma pack(pop)
 
 #define MAX_SCROLLING_TEXT_ENTRIES 32
+#define MAX_SCROLLING_TEXT_STRIPS 1024
+
+/**
+ * The unscrolled text of a sign, one entry per pixel column. Each column has a mask of the 8 rows that are set
+ * and the colour to set them to. Scrolling the text is then just a matter of copying a window of columns.
+ */
+struct scrolling_text_strip
+{
+    struct column
+    {
+        uint8 bits;
+        uint8 colour;
+    };
+    std::vector<column> columns;
+    uint32 last_used = 0;
+};
+
+// Everything outside the text that changes how a strip is rasterised
+struct scrolling_text_strip_settings
+{
+    bool true_type = false;
+    bool hinting = false;
+    const void * font_set = nullptr;
+    const void * font = nullptr;
+    std::string font_file;
+    sint32 font_size = 0;
+    sint32 hinting_threshold = 0;
+
+    bool operator==(const scrolling_text_strip_settings &other) const
+    {
+        return true_type == other.true_type && hinting == other.hinting &&
+            font_set == other.font_set && font == other.font && font_file == other.font_file &&
+            font_size == other.font_size && hinting_threshold == other.hinting_threshold;
+    }
+};
 
 static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
 static uint8 _characterBitmaps[FONT_SPRITE_GLYPH_COUNT][8];
 static uint32 _drawSCrollNextIndex = 0;
 
-static void scrolling_text_set_bitmap_for_sprite(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
-static void scrolling_text_set_bitmap_for_ttf(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
+// Keyed by the base colour followed by the formatted text
+static std::unordered_map<std::string, scrolling_text_strip> _scrollingTextStrips;
+static scrolling_text_strip_settings _scrollingTextStripSettings;
+static uint32 _scrollingTextStripUseCounter = 0;
+
+static void scrolling_text_set_strip_for_sprite(const utf8 *text, uint8 colour, scrolling_text_strip *strip);
+static void scrolling_text_set_strip_for_ttf(const utf8 *text, uint8 colour, scrolling_text_strip *strip);
 
 extern "C"
 {
@@ -79,6 +125,8 @@ void scrolling_text_initialise_bitmaps()
         }
     }
 
+    _scrollingTextStrips.clear();
+
     for (sint32 i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++)
     {
         sint32 imageId = SPR_SCROLLING_TEXT_START + i;
@@ -148,10 +196,99 @@ static uint8 scrolling_text_get_colour(uint32 character)
 
 static void scrolling_text_format(utf8 *dst, size_t size, rct_draw_scroll_text *scrollText)
 {
+    // The text is reformatted every time the scroll position moves, so use the format cache
+    safe_strcpy(dst, format_string_cached(scrollText->string_id, &scrollText->string_args_0, nullptr), size);
     if (gConfigGeneral.upper_case_banners) {
-        format_string_to_upper(dst, size, scrollText->string_id, &scrollText->string_args_0);
+        for (utf8 *ch = dst; *ch != '\0'; ch++) {
+            *ch = toupper(*ch);
+        }
+    }
+}
+
+static void scrolling_text_evict_strips()
+{
+    // Drop the older half of the strips in one go so eviction stays amortised O(1) per insert
+    std::vector<uint32> lastUsed;
+    lastUsed.reserve(_scrollingTextStrips.size());
+    for (const auto &kvp : _scrollingTextStrips) {
+        lastUsed.push_back(kvp.second.last_used);
+    }
+    auto median = lastUsed.begin() + lastUsed.size() / 2;
+    std::nth_element(lastUsed.begin(), median, lastUsed.end());
+    uint32 threshold = *median;
+
+    for (auto it = _scrollingTextStrips.begin(); it != _scrollingTextStrips.end();) {
+        if (it->second.last_used < threshold) {
+            it = _scrollingTextStrips.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+static const scrolling_text_strip * scrolling_text_get_strip(const utf8 *text, uint8 colour)
+{
+    scrolling_text_strip_settings settings;
+    settings.true_type = gUseTrueTypeFont;
+    settings.hinting = gConfigFonts.enable_hinting;
+#ifndef NO_TTF
+    if (settings.true_type && gCurrentTTFFontSet != nullptr) {
+        // The font set changes with the language, a custom font comes from the config
+        const TTFFontDescriptor *fontDesc = ttf_get_font_from_sprite_base(FONT_SPRITE_BASE_TINY);
+        settings.font_set = gCurrentTTFFontSet;
+        settings.font = fontDesc->font;
+        settings.font_file = fontDesc->filename != nullptr ? fontDesc->filename : "";
+        settings.font_size = fontDesc->ptSize;
+        settings.hinting_threshold = fontDesc->hinting_threshold;
+    }
+#endif
+    if (!(settings == _scrollingTextStripSettings)) {
+        _scrollingTextStrips.clear();
+        _scrollingTextStripSettings = settings;
+    }
+
+    std::string key(1, (char)colour);
+    key += text;
+    auto it = _scrollingTextStrips.find(key);
+    if (it != _scrollingTextStrips.end()) {
+        it->second.last_used = ++_scrollingTextStripUseCounter;
+        return &it->second;
+    }
+
+    if (_scrollingTextStrips.size() >= MAX_SCROLLING_TEXT_STRIPS) {
+        scrolling_text_evict_strips();
+    }
+
+    scrolling_text_strip * strip = &_scrollingTextStrips[key];
+    strip->last_used = ++_scrollingTextStripUseCounter;
+    if (gUseTrueTypeFont) {
+        scrolling_text_set_strip_for_ttf(text, colour, strip);
     } else {
-        format_string(dst, size, scrollText->string_id, &scrollText->string_args_0);
+        scrolling_text_set_strip_for_sprite(text, colour, strip);
+    }
+    return strip;
+}
+
+static void scrolling_text_draw_strip(const scrolling_text_strip *strip, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets)
+{
+    size_t numColumns = strip->columns.size();
+    if (numColumns == 0) return;
+
+    // The text loops back to the start once it reaches the end
+    size_t column = scroll % numColumns;
+    for (; *scrollPositionOffsets != -1; scrollPositionOffsets++) {
+        sint16 scrollPosition = *scrollPositionOffsets;
+        if (scrollPosition > -1) {
+            uint8 *dst = &bitmap[scrollPosition];
+            uint8 colour = strip->columns[column].colour;
+            for (uint8 bits = strip->columns[column].bits; bits != 0; bits >>= 1) {
+                if (bits & 1) *dst = colour;
+
+                // Jump to next row
+                dst += 64;
+            }
+        }
+        if (++column >= numColumns) column = 0;
     }
 }
 
@@ -1461,14 +1598,9 @@ sint32 scrolling_text_setup(paint_session * session, rct_string_id stringId, uin
     utf8 scrollString[256];
     scrolling_text_format(scrollString, 256, scrollText);
 
-    const sint16* scrollingModePositions = _scrollPositions[scrollingMode];
-
+    const scrolling_text_strip * strip = scrolling_text_get_strip(scrollString, scrolling_text_get_colour(gCommonFormatArgs[7]));
     memset(scrollText->bitmap, 0, 320 * 8);
-    if (gUseTrueTypeFont) {
-        scrolling_text_set_bitmap_for_ttf(scrollString, scroll, scrollText->bitmap, scrollingModePositions);
-    } else {
-        scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions);
-    }
+    scrolling_text_draw_strip(strip, scroll, scrollText->bitmap, _scrollPositions[scrollingMode]);
 
     uint32 imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
     drawing_engine_invalidate_image(imageId);
@@ -1476,20 +1608,13 @@ sint32 scrolling_text_setup(paint_session * session, rct_string_id stringId, uin
 }
 }
 
-static void scrolling_text_set_bitmap_for_sprite(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets)
+static void scrolling_text_set_strip_for_sprite(const utf8 *text, uint8 colour, scrolling_text_strip *strip)
 {
-    uint8 characterColour = scrolling_text_get_colour(gCommonFormatArgs[7]);
-
-    utf8 *ch = text;
-    while (true) {
-        uint32 codepoint = utf8_get_next(ch, (const utf8**)&ch);
-
-        // If at the end of the string loop back to the start
-        if (codepoint == 0) {
-            ch = text;
-            continue;
-        }
+    uint8 characterColour = colour;
 
+    const utf8 *ch = text;
+    uint32 codepoint;
+    while ((codepoint = utf8_get_next(ch, &ch)) != 0) {
         // Set any change in colour
         if (codepoint <= FORMAT_COLOUR_CODE_END && codepoint >= FORMAT_COLOUR_CODE_START){
             codepoint -= FORMAT_COLOUR_CODE_START;
@@ -1507,47 +1632,31 @@ static void scrolling_text_set_bitmap_for_sprite(utf8 *text, sint32 scroll, uint
         sint32 characterWidth = font_sprite_get_codepoint_width(FONT_SPRITE_BASE_TINY, codepoint);
         uint8 *characterBitmap = font_sprite_get_codepoint_bitmap(codepoint);
         for (; characterWidth != 0; characterWidth--, characterBitmap++) {
-            // Skip any none displayed columns
-            if (scroll != 0) {
-                scroll--;
-                continue;
-            }
-
-            sint16 scrollPosition = *scrollPositionOffsets;
-            if (scrollPosition == -1) return;
-            if (scrollPosition > -1) {
-                uint8 *dst = &bitmap[scrollPosition];
-                for (uint8 char_bitmap = *characterBitmap; char_bitmap != 0; char_bitmap >>= 1){
-                    if (char_bitmap & 1) *dst = characterColour;
-
-                    // Jump to next row
-                    dst += 64;
-                }
-            }
-            scrollPositionOffsets++;
+            strip->columns.push_back({ *characterBitmap, characterColour });
         }
     }
 }
 
-static void scrolling_text_set_bitmap_for_ttf(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets)
+static void scrolling_text_set_strip_for_ttf(const utf8 *text, uint8 colour, scrolling_text_strip *strip)
 {
 #ifndef NO_TTF
     TTFFontDescriptor *fontDesc = ttf_get_font_from_sprite_base(FONT_SPRITE_BASE_TINY);
     if (fontDesc->font == nullptr) {
-        scrolling_text_set_bitmap_for_sprite(text, scroll, bitmap, scrollPositionOffsets);
+        scrolling_text_set_strip_for_sprite(text, colour, strip);
         return;
     }
 
     // Currently only supports one colour
-    uint8 colour = 0;
+    uint8 colourCode = 0;
 
-    utf8 *dstCh = text;
-    utf8 *ch = text;
+    utf8 buffer[256];
+    utf8 *dstCh = buffer;
+    const utf8 *ch = text;
     sint32 codepoint;
-    while ((codepoint = utf8_get_next(ch, (const utf8**)&ch)) != 0) {
+    while ((codepoint = utf8_get_next(ch, &ch)) != 0) {
         if (utf8_is_format_code(codepoint)) {
             if (codepoint >= FORMAT_COLOUR_CODE_START && codepoint <= FORMAT_COLOUR_CODE_END) {
-                colour = (uint8)codepoint;
+                colourCode = (uint8)codepoint;
             }
         } else {
             dstCh = utf8_write_codepoint(dstCh, codepoint);
@@ -1555,17 +1664,15 @@ static void scrolling_text_set_bitmap_for_ttf(utf8 *text, sint32 scroll, uint8 *
     }
     *dstCh = 0;
 
-    if (colour == 0) {
-        colour = scrolling_text_get_colour(gCommonFormatArgs[7]);
-    } else {
+    if (colourCode != 0) {
         const rct_g1_element * g1 = gfx_get_g1_element(SPR_TEXT_PALETTE);
         if (g1 != nullptr)
         {
-            colour = g1->offset[(colour - FORMAT_COLOUR_CODE_START) * 4];
+            colour = g1->offset[(colourCode - FORMAT_COLOUR_CODE_START) * 4];
         }
     }
 
-    TTFSurface * surface = ttf_surface_cache_get_or_add(fontDesc->font, text);
+    TTFSurface * surface = ttf_render_string(fontDesc->font, buffer);
     if (surface == nullptr) {
         return;
     }
@@ -1580,33 +1687,19 @@ static void scrolling_text_set_bitmap_for_ttf(utf8 *text, sint32 scroll, uint8 *
     src += 3 * pitch;
     height = std::min(height, 8);
 
-    sint32 x = 0;
-    while (true) {
-        // Skip any none displayed columns
-        if (scroll == 0) {
-            sint16 scrollPosition = *scrollPositionOffsets;
-            if (scrollPosition == -1) return;
-            if (scrollPosition > -1) {
-                uint8 *dst = &bitmap[scrollPosition];
-
-                for (sint32 y = 0; y < height; y++)
-                {
-                    if (src[y * pitch + x] > 92 || (src[y * pitch + x] != 0 && !gConfigFonts.enable_hinting))
-                    {
-                        *dst = colour;
-                    }
-
-                    // Jump to next row
-                    dst += 64;
-                }
+    strip->columns.resize(width);
+    for (sint32 x = 0; x < width; x++) {
+        uint8 bits = 0;
+        for (sint32 y = 0; y < height; y++)
+        {
+            if (src[y * pitch + x] > 92 || (src[y * pitch + x] != 0 && !gConfigFonts.enable_hinting))
+            {
+                bits |= 1 << y;
             }
-            scrollPositionOffsets++;
-        } else {
-            scroll--;
         }
-
-        x++;
-        if (x >= width) x = 0;
+        strip->columns[x] = { bits, colour };
     }
+#else
+    scrolling_text_set_strip_for_sprite(text, colour, strip);
 #endif // NO_TTF
 }
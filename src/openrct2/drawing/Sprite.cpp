@@ -14,13 +14,17 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 #include "../common.h"
 #include "../config/Config.h"
 #include "../Context.h"
-#include "../core/FileStream.hpp"
+#include "../core/Math.hpp"
 #include "../core/Memory.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/Path.hpp"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
@@ -72,9 +76,12 @@ static inline uint32 rctc_to_rct2_index(uint32 image)
     else throw std::runtime_error("Invalid RCTC g1.dat file");
 }
 
-static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc, rct_g1_element *elements)
+/**
+ * Converts the element headers of a graphics file. Offsets are converted as they are, the caller is responsible for
+ * adding the base address of the image data.
+ */
+static void convert_gxdat(const rct_g1_element_32bit * g1Elements32, size_t count, bool is_rctc, rct_g1_element *elements)
 {
-    auto g1Elements32 = stream->ReadArray<rct_g1_element_32bit>(count);
     if (is_rctc)
     {
         // Process RCTC's g1.dat file
@@ -151,7 +158,6 @@ static void read_and_convert_gxdat(IStream * stream, size_t count, bool is_rctc,
             elements[i].zoomed_offset = src.zoomed_offset;
         }
     }
-    Memory::Free(g1Elements32);
 }
 
 void mask_scalar(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, const uint8 * RESTRICT colourSrc,
@@ -177,9 +183,196 @@ void mask_scalar(sint32 width, sint32 height, const uint8 * RESTRICT maskSrc, co
     }
 }
 
+/**
+ * Zoomed out RLE sprites are drawn by sampling every 2nd, 4th or 8th pixel of the zoom 0 data, which a fully zoomed out
+ * view of a large park does for the same few thousand images every frame. The samples are kept here as zoom 0 RLE
+ * sprites instead, one per zoom level and first sampled row and column, so drawing them gives exactly the same pixels.
+ */
+struct zoomed_sprite
+{
+    uint8 zoom_level;
+    uint8 phase_x;
+    uint8 phase_y;
+    std::vector<uint8> data;
+};
+
+struct zoomed_sprite_set
+{
+    const uint8 * source = nullptr;
+    uint32 last_used = 0;
+    std::vector<zoomed_sprite> sprites;
+};
+
+constexpr size_t ZOOMED_SPRITE_CACHE_SIZE = 8 * 1024 * 1024;
+
+static std::unordered_map<uint32, zoomed_sprite_set> _zoomedSprites;
+static size_t _zoomedSpritesSize = 0;
+static uint32 _zoomedSpritesUseCounter = 0;
+
+static size_t zoomed_sprite_set_size(const zoomed_sprite_set &set)
+{
+    size_t size = 0;
+    for (const auto &sprite : set.sprites)
+    {
+        size += sprite.data.size();
+    }
+    return size;
+}
+
+static void zoomed_sprite_clear()
+{
+    _zoomedSprites.clear();
+    _zoomedSpritesSize = 0;
+}
+
+static void zoomed_sprite_invalidate(uint32 image)
+{
+    auto it = _zoomedSprites.find(image);
+    if (it != _zoomedSprites.end())
+    {
+        _zoomedSpritesSize -= zoomed_sprite_set_size(it->second);
+        _zoomedSprites.erase(it);
+    }
+}
+
+static void zoomed_sprite_evict()
+{
+    // Drop the older half of the images in one go so eviction stays amortised O(1) per insert
+    std::vector<uint32> lastUsed;
+    lastUsed.reserve(_zoomedSprites.size());
+    for (const auto &kvp : _zoomedSprites)
+    {
+        lastUsed.push_back(kvp.second.last_used);
+    }
+    auto median = lastUsed.begin() + lastUsed.size() / 2;
+    std::nth_element(lastUsed.begin(), median, lastUsed.end());
+    uint32 threshold = *median;
+
+    for (auto it = _zoomedSprites.begin(); it != _zoomedSprites.end();)
+    {
+        if (it->second.last_used < threshold)
+        {
+            _zoomedSpritesSize -= zoomed_sprite_set_size(it->second);
+            it = _zoomedSprites.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+/**
+ * Samples every (1 << zoom_level)th pixel of an RLE sprite, starting at row phase_y and column phase_x, into a new RLE
+ * sprite. Returns false if the result can not be addressed by 16 bit line offsets.
+ */
+static bool zoomed_sprite_build(const rct_g1_element * g1, sint32 zoom_level, sint32 phase_x, sint32 phase_y, std::vector<uint8> * data)
+{
+    sint32 zoom_amount = 1 << zoom_level;
+    sint32 height = Math::Max(0, (g1->height - phase_y + zoom_amount - 1) >> zoom_level);
+
+    data->assign(height * sizeof(uint16), 0);
+    for (sint32 row = 0; row < height; row++)
+    {
+        if (data->size() > UINT16_MAX)
+        {
+            return false;
+        }
+        uint16 lineOffset = (uint16)data->size();
+        memcpy(data->data() + row * sizeof(uint16), &lineOffset, sizeof(uint16));
+
+        const uint8 * lineData = g1->offset + ((const uint16 *)g1->offset)[phase_y + (row << zoom_level)];
+        size_t chunk = SIZE_MAX;
+        sint32 chunkEndX = 0;
+        bool isEndOfLine = false;
+        while (!isEndOfLine)
+        {
+            uint8 dataSize = *lineData++;
+            uint8 firstPixelX = *lineData++;
+            isEndOfLine = (dataSize & 0x80) != 0;
+            dataSize &= 0x7F;
+
+            for (sint32 i = 0; i < dataSize; i++)
+            {
+                sint32 x = firstPixelX + i - phase_x;
+                if (x < 0 || (x & (zoom_amount - 1)) != 0)
+                {
+                    continue;
+                }
+                x >>= zoom_level;
+
+                // Samples from neighbouring chunks can end up next to each other, keep them in one chunk
+                if (chunk == SIZE_MAX || x != chunkEndX || (*data)[chunk] == 0x7F)
+                {
+                    chunk = data->size();
+                    data->push_back(0);
+                    data->push_back((uint8)x);
+                }
+                data->push_back(lineData[i]);
+                (*data)[chunk]++;
+                chunkEndX = x + 1;
+            }
+            lineData += dataSize;
+        }
+
+        if (chunk == SIZE_MAX)
+        {
+            chunk = data->size();
+            data->push_back(0);
+            data->push_back(0);
+        }
+        (*data)[chunk] |= 0x80;
+    }
+    return true;
+}
+
+static const uint8 * zoomed_sprite_get(uint32 image, const rct_g1_element * g1, sint32 zoom_level, sint32 phase_x, sint32 phase_y)
+{
+    zoomed_sprite_set &set = _zoomedSprites[image];
+    if (set.source != g1->offset)
+    {
+        _zoomedSpritesSize -= zoomed_sprite_set_size(set);
+        set.sprites.clear();
+        set.source = g1->offset;
+    }
+    set.last_used = ++_zoomedSpritesUseCounter;
+
+    for (const auto &sprite : set.sprites)
+    {
+        if (sprite.zoom_level == zoom_level && sprite.phase_x == phase_x && sprite.phase_y == phase_y)
+        {
+            return sprite.data.data();
+        }
+    }
+
+    zoomed_sprite sprite;
+    sprite.zoom_level = (uint8)zoom_level;
+    sprite.phase_x = (uint8)phase_x;
+    sprite.phase_y = (uint8)phase_y;
+    if (!zoomed_sprite_build(g1, zoom_level, phase_x, phase_y, &sprite.data))
+    {
+        return nullptr;
+    }
+    _zoomedSpritesSize += sprite.data.size();
+    set.sprites.push_back(std::move(sprite));
+
+    // The image was just used so it is never evicted here
+    const uint8 * result = set.sprites.back().data.data();
+    if (_zoomedSpritesSize > ZOOMED_SPRITE_CACHE_SIZE)
+    {
+        zoomed_sprite_evict();
+    }
+    return result;
+}
+
+// g1.dat, g2.dat and the RCT1 csg1.dat are mapped rather than read, so image data is only paged in
+// when a sprite is drawn
+static std::unique_ptr<MemoryMappedFile> _g1File;
+static std::unique_ptr<MemoryMappedFile> _g2File;
+static std::unique_ptr<MemoryMappedFile> _csgFile;
+
 extern "C"
 {
-    static void *   _g1Buffer = nullptr;
     static rct_gx   _g2 = { 0 };
     static rct_gx   _csg = { 0 };
     static bool     _csgLoaded = false;
@@ -201,33 +394,35 @@ extern "C"
         try
         {
             auto path = Path::Combine(env->GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            rct_g1_header header = fs.ReadValue<rct_g1_header>();
+            _g1File = std::make_unique<MemoryMappedFile>(path);
+            rct_g1_header header = *_g1File->GetArray<rct_g1_header>(0, 1);
 
             if (header.num_entries < SPR_G1_END)
             {
                 throw std::runtime_error("Not enough elements in g1.dat");
             }
 
-            // Read element headers
+            // Convert element headers
+            size_t elementsOffset = sizeof(rct_g1_header);
+            auto g1Elements32 = _g1File->GetArray<rct_g1_element_32bit>(elementsOffset, header.num_entries);
             _g1ElementsCount = 324206;
             _g1Elements = Memory::AllocateArray<rct_g1_element>(_g1ElementsCount);
             bool is_rctc = header.num_entries == SPR_RCTC_G1_END;
-            read_and_convert_gxdat(&fs, header.num_entries, is_rctc, _g1Elements);
+            convert_gxdat(g1Elements32, header.num_entries, is_rctc, _g1Elements);
             gTinyFontAntiAliased = is_rctc;
 
-            // Read element data
-            _g1Buffer = fs.ReadArray<uint8>(header.total_size);
-
-            // Fix entry data offsets
+            // Point entries at the element data in the mapping
+            size_t dataOffset = elementsOffset + (header.num_entries * sizeof(rct_g1_element_32bit));
+            auto g1Data = _g1File->GetArray<uint8>(dataOffset, header.total_size);
             for (uint32 i = 0; i < header.num_entries; i++)
             {
-                _g1Elements[i].offset += (uintptr_t)_g1Buffer;
+                _g1Elements[i].offset += (uintptr_t)g1Data;
             }
             return true;
         }
         catch (const std::exception &)
         {
+            gfx_unload_g1();
             log_fatal("Unable to load g1 graphics");
             if (!gOpenRCT2Headless)
             {
@@ -240,20 +435,25 @@ extern "C"
 
     void gfx_unload_g1()
     {
-        SafeFree(_g1Buffer);
+        zoomed_sprite_clear();
         SafeFree(_g1Elements);
+        _g1File = nullptr;
     }
 
     void gfx_unload_g2()
     {
+        zoomed_sprite_clear();
         SafeFree(_g2.elements);
-        SafeFree(_g2.data);
+        _g2.data = nullptr;
+        _g2File = nullptr;
     }
 
     void gfx_unload_csg()
     {
+        zoomed_sprite_clear();
         SafeFree(_csg.elements);
-        SafeFree(_csg.data);
+        _csg.data = nullptr;
+        _csgFile = nullptr;
     }
 
     bool gfx_load_g2()
@@ -266,17 +466,18 @@ extern "C"
         safe_strcat_path(path, "g2.dat", MAX_PATH);
         try
         {
-            auto fs = FileStream(path, FILE_MODE_OPEN);
-            _g2.header = fs.ReadValue<rct_g1_header>();
+            _g2File = std::make_unique<MemoryMappedFile>(path);
+            _g2.header = *_g2File->GetArray<rct_g1_header>(0, 1);
 
-            // Read element headers
+            // Convert element headers
+            size_t elementsOffset = sizeof(rct_g1_header);
+            auto g2Elements32 = _g2File->GetArray<rct_g1_element_32bit>(elementsOffset, _g2.header.num_entries);
             _g2.elements = Memory::AllocateArray<rct_g1_element>(_g2.header.num_entries);
-            read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements);
-
-            // Read element data
-            _g2.data = fs.ReadArray<uint8>(_g2.header.total_size);
+            convert_gxdat(g2Elements32, _g2.header.num_entries, false, _g2.elements);
 
-            // Fix entry data offsets
+            // Point entries at the element data in the mapping
+            size_t dataOffset = elementsOffset + (_g2.header.num_entries * sizeof(rct_g1_element_32bit));
+            _g2.data = _g2File->GetArray<uint8>(dataOffset, _g2.header.total_size);
             for (uint32 i = 0; i < _g2.header.num_entries; i++)
             {
                 _g2.elements[i].offset += (uintptr_t)_g2.data;
@@ -285,6 +486,7 @@ extern "C"
         }
         catch (const std::exception &)
         {
+            gfx_unload_g2();
             log_fatal("Unable to load g2 graphics");
             if (!gOpenRCT2Headless)
             {
@@ -347,10 +549,10 @@ extern "C"
         auto pathDataPath = std::unique_ptr<utf8[]>(gfx_get_csg_data_path());
         try
         {
-            auto fileHeader = FileStream(pathHeaderPath.get(), FILE_MODE_OPEN);
-            auto fileData = FileStream(pathDataPath.get(), FILE_MODE_OPEN);
+            MemoryMappedFile fileHeader(pathHeaderPath.get());
+            _csgFile = std::make_unique<MemoryMappedFile>(pathDataPath.get());
             size_t fileHeaderSize = fileHeader.GetLength();
-            size_t fileDataSize = fileData.GetLength();
+            size_t fileDataSize = _csgFile->GetLength();
 
             _csg.header.num_entries = (uint32)(fileHeaderSize / sizeof(rct_g1_element_32bit));
             _csg.header.total_size = (uint32)fileDataSize;
@@ -358,15 +560,17 @@ extern "C"
             if (_csg.header.num_entries < 69917)
             {
                 log_warning("Cannot load CSG1.DAT, it has too few entries. Only CSG1.DAT from Loopy Landscapes will work.");
+                _csgFile = nullptr;
                 return false;
             }
 
-            // Read element headers
+            // Convert element headers
+            auto csgElements32 = fileHeader.GetArray<rct_g1_element_32bit>(0, _csg.header.num_entries);
             _csg.elements = Memory::AllocateArray<rct_g1_element>(_csg.header.num_entries);
-            read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements);
+            convert_gxdat(csgElements32, _csg.header.num_entries, false, _csg.elements);
 
-            // Read element data
-            _csg.data = fileData.ReadArray<uint8>(_csg.header.total_size);
+            // Point entries at the element data in the mapping
+            _csg.data = _csgFile->GetData();
 
             // Fix entry data offsets
             for (uint32 i = 0; i < _csg.header.num_entries; i++)
@@ -380,6 +584,7 @@ extern "C"
         }
         catch (const std::exception &)
         {
+            gfx_unload_csg();
             log_error("Unable to load csg graphics");
             return false;
         }
@@ -688,6 +893,20 @@ extern "C"
         dest_pointer += ((dpi->width >> zoom_level) + dpi->pitch) * dest_start_y + dest_start_x;
 
         if (g1->flags & G1_FLAG_RLE_COMPRESSION){
+            if (zoom_level != 0) {
+                // Draw the already sampled pixels at zoom 0, in units of the zoomed out destination
+                const uint8 * zoomed_pointer = zoomed_sprite_get(image_element, g1, zoom_level, source_start_x & ~zoom_mask, source_start_y & ~zoom_mask);
+                if (zoomed_pointer != nullptr) {
+                    rct_drawpixelinfo zoomed_dpi = *dpi;
+                    zoomed_dpi.width = dpi->width >> zoom_level;
+                    zoomed_dpi.zoom_level = 0;
+                    gfx_rle_sprite_to_buffer(zoomed_pointer, dest_pointer, palette_pointer, &zoomed_dpi, image_type,
+                                             source_start_y >> zoom_level, (height + ~zoom_mask) >> zoom_level,
+                                             source_start_x >> zoom_level, (width + ~zoom_mask) >> zoom_level);
+                    return;
+                }
+            }
+
             // We have to use a different method to move the source pointer for
             // rle encoded sprites so that will be handled within this function
             gfx_rle_sprite_to_buffer(g1->offset, dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width);
@@ -807,6 +1026,11 @@ extern "C"
         openrct2_assert(g1 != nullptr, "g1 was nullptr");
 #endif
 
+        if (!_zoomedSprites.empty())
+        {
+            zoomed_sprite_invalidate(imageId);
+        }
+
         if (imageId == SPR_TEMP)
         {
             _g1Temp = *g1;
@@ -18,6 +18,7 @@
 #include "../config/Config.h"
 #include "../interface/Colour.h"
 #include "../interface/Viewport.h"
+#include "../localisation/FormatStringCache.h"
 #include "../localisation/Localisation.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -222,7 +223,7 @@ void gfx_draw_string_left_centred(rct_drawpixelinfo *dpi, rct_string_id format,
 {
     gCurrentFontSpriteBase = FONT_SPRITE_BASE_MEDIUM;
     char *buffer = gCommonStringFormatBuffer;
-    format_string(buffer, 256, format, args);
+    safe_strcpy(buffer, format_string_cached(format, args, nullptr), 256);
     sint32 height = string_get_height_raw(buffer);
     gfx_draw_string(dpi, buffer, colour, x, y - (height / 2));
 }
@@ -385,7 +386,7 @@ void gfx_draw_string_centred_wrapped_partial(rct_drawpixelinfo *dpi, sint32 x, s
 
     gCurrentFontSpriteBase = FONT_SPRITE_BASE_MEDIUM;
     gfx_draw_string(dpi, (char *)"", colour, dpi->x, dpi->y);
-    format_string(buffer, 256, format, args);
+    safe_strcpy(buffer, format_string_cached(format, args, nullptr), 256);
 
 
     gCurrentFontSpriteBase = FONT_SPRITE_BASE_MEDIUM;
@@ -480,11 +481,11 @@ static void ttf_draw_string_raw_ttf(rct_drawpixelinfo *dpi, const utf8 *text, te
     }
 
     if (info->flags & TEXT_DRAW_FLAG_NO_DRAW) {
-        info->x += ttf_getwidth_cache_get_or_add(fontDesc->font, text);
+        info->x += ttf_get_text_width(fontDesc->font, text);
         return;
     } else {
         uint8 colour = info->palette[1];
-        TTFSurface * surface = ttf_surface_cache_get_or_add(fontDesc->font, text);
+        TTFSurface * surface = ttf_render_string(fontDesc->font, text);
         if (surface == nullptr)
             return;
 
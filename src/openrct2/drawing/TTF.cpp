@@ -16,6 +16,10 @@
 
 #ifndef NO_TTF
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
@@ -25,48 +29,185 @@
 #include "../platform/platform.h"
 #include "TTF.h"
 
-extern "C"
+// The atlas of a font is flushed when it grows beyond these limits (e.g. after drawing a lot of CJK text)
+#define TTF_GLYPH_ATLAS_MAX_PIXELS (4 * 1024 * 1024)
+#define TTF_GLYPH_ATLAS_MAX_KERNING_PAIRS 65536
+
+#define TTF_UNICODE_BOM_NATIVE  0xFEFF
+#define TTF_UNICODE_BOM_SWAPPED 0xFFFE
+
+struct GlyphAtlasEntry
+{
+    TTFGlyph    Glyph;
+    size_t      Offset;
+};
+
+/**
+ * Every glyph rasterised for a font along with its metrics, so that strings can be measured and composed
+ * without going back to FreeType. The glyph bitmaps are packed into a single pixel buffer.
+ */
+struct GlyphAtlas
+{
+    TTF_Font *                                  Font = nullptr;
+    TTFFontMetrics                              Metrics = { };
+    std::unordered_map<uint16, GlyphAtlasEntry> Glyphs;
+    std::unordered_map<uint64, sint32>          Kerning;
+    std::vector<uint8>                          Pixels;
+};
+
+static std::vector<GlyphAtlas> _ttfGlyphAtlases;
+static std::vector<uint8>      _ttfRenderBuffer;
+static TTFSurface              _ttfRenderSurface;
+
+static void ttf_glyph_atlas_dispose_all()
+{
+    _ttfGlyphAtlases.clear();
+    _ttfGlyphAtlases.shrink_to_fit();
+    _ttfRenderBuffer.clear();
+    _ttfRenderBuffer.shrink_to_fit();
+}
+
+static GlyphAtlas * ttf_get_glyph_atlas(TTF_Font * font)
 {
+    for (auto &atlas : _ttfGlyphAtlases)
+    {
+        if (atlas.Font == font)
+        {
+            if (atlas.Pixels.size() > TTF_GLYPH_ATLAS_MAX_PIXELS ||
+                atlas.Kerning.size() > TTF_GLYPH_ATLAS_MAX_KERNING_PAIRS)
+            {
+                log_verbose("Flushing glyph atlas of %d glyphs", (sint32)atlas.Glyphs.size());
+                atlas.Glyphs.clear();
+                atlas.Kerning.clear();
+                atlas.Pixels.clear();
+            }
+            return &atlas;
+        }
+    }
 
-static bool _ttfInitialised = false;
+    GlyphAtlas atlas;
+    atlas.Font = font;
+    TTF_GetFontMetrics(font, &atlas.Metrics);
+    _ttfGlyphAtlases.push_back(std::move(atlas));
+    return &_ttfGlyphAtlases.back();
+}
+
+static const GlyphAtlasEntry * ttf_get_glyph(GlyphAtlas * atlas, uint16 codepoint)
+{
+    auto it = atlas->Glyphs.find(codepoint);
+    if (it != atlas->Glyphs.end())
+    {
+        return &it->second;
+    }
+
+    TTFGlyph glyph;
+    if (TTF_GetGlyph(atlas->Font, codepoint, gConfigFonts.enable_hinting, &glyph) != 0)
+    {
+        return nullptr;
+    }
+
+    // Only the columns that get composed are kept, FreeType's own glyph cache is free to reuse its slot
+    sint32 width = std::max(glyph.width, 0);
+    sint32 rows = std::max(glyph.rows, 0);
+    GlyphAtlasEntry entry;
+    entry.Glyph = glyph;
+    entry.Glyph.buffer = nullptr;
+    entry.Glyph.width = width;
+    entry.Glyph.rows = rows;
+    entry.Glyph.pitch = width;
+    entry.Offset = atlas->Pixels.size();
+    if (width > 0 && rows > 0 && glyph.buffer != nullptr)
+    {
+        atlas->Pixels.resize(entry.Offset + (size_t)(width * rows));
+        for (sint32 row = 0; row < rows; row++)
+        {
+            memcpy(&atlas->Pixels[entry.Offset + row * width], glyph.buffer + row * glyph.pitch, width);
+        }
+    }
+    else
+    {
+        entry.Glyph.rows = 0;
+    }
+    return &atlas->Glyphs.emplace(codepoint, entry).first->second;
+}
+
+static sint32 ttf_get_kerning(GlyphAtlas * atlas, uint32 prevIndex, uint32 index)
+{
+    uint64 key = ((uint64)prevIndex << 32) | index;
+    auto it = atlas->Kerning.find(key);
+    if (it != atlas->Kerning.end())
+    {
+        return it->second;
+    }
 
-#define TTF_SURFACE_CACHE_SIZE 256
-#define TTF_GETWIDTH_CACHE_SIZE 1024
+    sint32 kerning = TTF_GetKerning(atlas->Font, prevIndex, index);
+    atlas->Kerning.emplace(key, kerning);
+    return kerning;
+}
 
-typedef struct ttf_cache_entry
+/**
+ * Walks the glyphs of a string the same way TTF_SizeUTF8 and the TTF_Render functions do, calling back with
+ * each glyph and its pen position.
+ */
+template<typename TFunc>
+static bool ttf_layout_string(GlyphAtlas * atlas, const utf8 * text, TFunc callback)
 {
-    TTFSurface *    surface;
-    TTF_Font *      font;
-    utf8 *          text;
-    uint32          lastUseTick;
-} ttf_cache_entry;
+    const TTFFontMetrics &metrics = atlas->Metrics;
+    uint32 prevIndex = 0;
+    sint32 x = 0;
+    codepoint_t codepoint;
+    while ((codepoint = utf8_get_next(text, &text)) != 0)
+    {
+        uint16 ch = (uint16)codepoint;
+        if (ch == TTF_UNICODE_BOM_NATIVE || ch == TTF_UNICODE_BOM_SWAPPED)
+        {
+            continue;
+        }
+
+        const GlyphAtlasEntry * entry = ttf_get_glyph(atlas, ch);
+        if (entry == nullptr)
+        {
+            return false;
+        }
 
-typedef struct ttf_getwidth_cache_entry
+        const TTFGlyph &glyph = entry->Glyph;
+        if (metrics.kerning && prevIndex != 0 && glyph.index != 0)
+        {
+            x += ttf_get_kerning(atlas, prevIndex, glyph.index);
+        }
+        callback(*entry, x);
+        x += metrics.overhang + glyph.advance;
+        prevIndex = glyph.index;
+    }
+    return true;
+}
+
+static bool ttf_measure_string(GlyphAtlas * atlas, const utf8 * text, sint32 * outWidth, sint32 * outHeight)
 {
-    uint32      width;
-    TTF_Font *  font;
-    utf8 *      text;
-    uint32      lastUseTick;
-} ttf_getwidth_cache_entry;
-
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = { nullptr };
-static sint32 _ttfSurfaceCacheCount = 0;
-static sint32 _ttfSurfaceCacheHitCount = 0;
-static sint32 _ttfSurfaceCacheMissCount = 0;
-
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = { 0 };
-static sint32 _ttfGetWidthCacheCount = 0;
-static sint32 _ttfGetWidthCacheHitCount = 0;
-static sint32 _ttfGetWidthCacheMissCount = 0;
+    sint32 overhang = atlas->Metrics.overhang;
+    sint32 minX = 0;
+    sint32 maxX = 0;
+    sint32 minY = 0;
+    bool result = ttf_layout_string(atlas, text, [&](const GlyphAtlasEntry &entry, sint32 x)
+    {
+        const TTFGlyph &glyph = entry.Glyph;
+        minX = std::min(minX, x + glyph.minx);
+        maxX = std::max(maxX, x + overhang + std::max(glyph.advance, glyph.maxx));
+        minY = std::min(minY, glyph.miny);
+    });
+
+    *outWidth = maxX - minX;
+    *outHeight = std::max(atlas->Metrics.ascent - minY, atlas->Metrics.height);
+    return result;
+}
+
+extern "C"
+{
+
+static bool _ttfInitialised = false;
 
 static TTF_Font * ttf_open_font(const utf8 * fontPath, sint32 ptSize);
 static void ttf_close_font(TTF_Font * font);
-static uint32 ttf_surface_cache_hash(TTF_Font * font, const utf8 * text);
-static void ttf_surface_cache_dispose(ttf_cache_entry * entry);
-static void ttf_surface_cache_dispose_all();
-static void ttf_getwidth_cache_dispose_all();
-static bool ttf_get_size(TTF_Font * font, const utf8 * text, sint32 * width, sint32 * height);
-static TTFSurface * ttf_render(TTF_Font * font, const utf8 * text);
 
 bool ttf_initialise()
 {
@@ -103,8 +244,7 @@ void ttf_dispose()
 {
     if (_ttfInitialised)
     {
-        ttf_surface_cache_dispose_all();
-        ttf_getwidth_cache_dispose_all();
+        ttf_glyph_atlas_dispose_all();
 
         for (sint32 i = 0; i < 4; i++) {
             TTFFontDescriptor *fontDesc = &(gCurrentTTFFontSet->size[i]);
@@ -129,35 +269,6 @@ static void ttf_close_font(TTF_Font * font)
     TTF_CloseFont(font);
 }
 
-static uint32 ttf_surface_cache_hash(TTF_Font *font, const utf8 *text)
-{
-    uint32 hash = (uint32)((((uintptr_t)font * 23) ^ 0xAAAAAAAA) & 0xFFFFFFFF);
-    for (const utf8 *ch = text; *ch != 0; ch++) {
-        hash = ror32(hash, 3) ^ (*ch * 13);
-    }
-    return hash;
-}
-
-static void ttf_surface_cache_dispose(ttf_cache_entry *entry)
-{
-    if (entry->surface != nullptr) {
-        ttf_free_surface(entry->surface);
-        free(entry->text);
-
-        entry->surface = nullptr;
-        entry->font = nullptr;
-        entry->text = nullptr;
-    }
-}
-
-static void ttf_surface_cache_dispose_all()
-{
-    for (sint32 i = 0; i < TTF_SURFACE_CACHE_SIZE; i++) {
-        ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-        _ttfSurfaceCacheCount--;
-    }
-}
-
 void ttf_toggle_hinting()
 {
     if (!gUseTrueTypeFont)
@@ -171,118 +282,80 @@ void ttf_toggle_hinting()
         TTF_SetFontHinting(fontDesc->font, gConfigFonts.enable_hinting ? 1 : 0);
     }
 
-    if (_ttfSurfaceCacheCount)
-    {
-        ttf_surface_cache_dispose_all();
-    }
+    // Glyphs are rasterised differently with hinting on or off
+    ttf_glyph_atlas_dispose_all();
 }
 
-TTFSurface * ttf_surface_cache_get_or_add(TTF_Font * font, const utf8 * text)
+/**
+ * Composes a string from the glyph atlas. The returned surface is only valid until the next call.
+ */
+TTFSurface * ttf_render_string(TTF_Font * font, const utf8 * text)
 {
-    ttf_cache_entry *entry;
-
-    uint32 hash = ttf_surface_cache_hash(font, text);
-    sint32 index = hash % TTF_SURFACE_CACHE_SIZE;
-    for (sint32 i = 0; i < TTF_SURFACE_CACHE_SIZE; i++) {
-        entry = &_ttfSurfaceCache[index];
-
-        // Check if entry is a hit
-        if (entry->surface == nullptr) break;
-        if (entry->font == font && strcmp(entry->text, text) == 0) {
-            _ttfSurfaceCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->surface;
-        }
-
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64) {
-            break;
-        }
+    GlyphAtlas * atlas = ttf_get_glyph_atlas(font);
 
-        // Check if next entry is a hit
-        if (++index >= TTF_SURFACE_CACHE_SIZE) index = 0;
-    }
-
-    // Cache miss, replace entry with new surface
-    entry = &_ttfSurfaceCache[index];
-    ttf_surface_cache_dispose(entry);
-
-    TTFSurface * surface = ttf_render(font, text);
-    if (surface == nullptr) {
+    sint32 width, height;
+    if (!ttf_measure_string(atlas, text, &width, &height) || width <= 0)
+    {
         return nullptr;
     }
 
-    _ttfSurfaceCacheMissCount++;
-    // printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-    _ttfSurfaceCacheCount++;
-    entry->surface = surface;
-    entry->font = font;
-    entry->text = _strdup(text);
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->surface;
-}
-
-static void ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry *entry)
-{
-    if (entry->text != nullptr) {
-        free(entry->text);
-
-        entry->width = 0;
-        entry->font = nullptr;
-        entry->text = nullptr;
-    }
-}
+    _ttfRenderBuffer.assign((size_t)(width * height), 0);
+    uint8 * pixels = _ttfRenderBuffer.data();
+    const uint8 * pixelsEnd = pixels + _ttfRenderBuffer.size();
 
-static void ttf_getwidth_cache_dispose_all()
-{
-    for (sint32 i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++) {
-        ttf_getwidth_cache_dispose(&_ttfGetWidthCache[i]);
-        _ttfGetWidthCacheCount--;
-    }
-}
+    // All glyphs are in the atlas after measuring, so its pixel buffer will not move while composing
+    const uint8 * atlasPixels = atlas->Pixels.data();
+    bool first = true;
+    sint32 xStart = 0;
+    ttf_layout_string(atlas, text, [&](const GlyphAtlasEntry &entry, sint32 x)
+    {
+        const TTFGlyph &glyph = entry.Glyph;
 
-uint32 ttf_getwidth_cache_get_or_add(TTF_Font * font, const utf8 * text)
-{
-    ttf_getwidth_cache_entry *entry;
-
-    uint32 hash = ttf_surface_cache_hash(font, text);
-    sint32 index = hash % TTF_GETWIDTH_CACHE_SIZE;
-    for (sint32 i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++) {
-        entry = &_ttfGetWidthCache[index];
-
-        // Check if entry is a hit
-        if (entry->text == nullptr) break;
-        if (entry->font == font && strcmp(entry->text, text) == 0) {
-            _ttfGetWidthCacheHitCount++;
-            entry->lastUseTick = gCurrentDrawCount;
-            return entry->width;
+        // Compensate for the wrap around with negative minx's
+        if (first && glyph.minx < 0)
+        {
+            xStart = -glyph.minx;
         }
+        first = false;
+
+        const uint8 * src = atlasPixels + entry.Offset;
+        for (sint32 row = 0; row < glyph.rows; row++, src += glyph.pitch)
+        {
+            sint32 y = row + glyph.yoffset;
+            if (y < 0 || y >= height)
+            {
+                continue;
+            }
 
-        // If entry hasn't been used for a while, replace it
-        if (entry->lastUseTick < gCurrentDrawCount - 64) {
-            break;
+            sint32 dstX = xStart + x + glyph.minx;
+            uint8 * dst = pixels + y * width + dstX;
+            for (sint32 col = 0; col < glyph.width && dst < pixelsEnd; col++, dst++)
+            {
+                if (dstX + col >= 0)
+                {
+                    *dst |= src[col];
+                }
+            }
         }
+    });
 
-        // Check if next entry is a hit
-        if (++index >= TTF_GETWIDTH_CACHE_SIZE) index = 0;
-    }
+    _ttfRenderSurface.pixels = pixels;
+    _ttfRenderSurface.w = width;
+    _ttfRenderSurface.h = height;
+    _ttfRenderSurface.pitch = width;
+    return &_ttfRenderSurface;
+}
 
-    // Cache miss, replace entry with new width
-    entry = &_ttfGetWidthCache[index];
-    ttf_getwidth_cache_dispose(entry);
+uint32 ttf_get_text_width(TTF_Font * font, const utf8 * text)
+{
+    GlyphAtlas * atlas = ttf_get_glyph_atlas(font);
 
     sint32 width, height;
-    ttf_get_size(font, text, &width, &height);
-
-    _ttfGetWidthCacheMissCount++;
-
-    _ttfGetWidthCacheCount++;
-    entry->width = width;
-    entry->font = font;
-    entry->text = _strdup(text);
-    entry->lastUseTick = gCurrentDrawCount;
-    return entry->width;
+    if (!ttf_measure_string(atlas, text, &width, &height))
+    {
+        return 0;
+    }
+    return (uint32)width;
 }
 
 TTFFontDescriptor * ttf_get_font_from_sprite_base(uint16 spriteBase)
@@ -295,23 +368,6 @@ bool ttf_provides_glyph(const TTF_Font * font, codepoint_t codepoint)
     return TTF_GlyphIsProvided(font, codepoint);
 }
 
-static bool ttf_get_size(TTF_Font * font, const utf8 * text, sint32 * outWidth, sint32 * outHeight)
-{
-    return TTF_SizeUTF8(font, text, outWidth, outHeight);
-}
-
-static TTFSurface * ttf_render(TTF_Font * font, const utf8 * text)
-{
-    if (gConfigFonts.enable_hinting)
-    {
-        return TTF_RenderUTF8_Shaded(font, text, 0x000000FF, 0x000000FF);
-    }
-    else
-    {
-        return TTF_RenderUTF8_Solid(font, text, 0x000000FF);
-    }
-}
-
 void ttf_free_surface(TTFSurface * surface)
 {
     free((void *)surface->pixels);
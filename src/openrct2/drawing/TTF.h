@@ -38,14 +38,35 @@ typedef struct TTFSurface {
     sint32          pitch;
 } TTFSurface;
 
+typedef struct TTFGlyph {
+    uint32          index;
+    sint32          minx;
+    sint32          maxx;
+    sint32          miny;
+    sint32          maxy;
+    sint32          yoffset;
+    sint32          advance;
+    const uint8 *   buffer;
+    sint32          width;
+    sint32          rows;
+    sint32          pitch;
+} TTFGlyph;
+
+typedef struct TTFFontMetrics {
+    sint32  height;
+    sint32  ascent;
+    sint32  overhang;
+    bool    kerning;
+} TTFFontMetrics;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 TTFFontDescriptor * ttf_get_font_from_sprite_base(uint16 spriteBase);
 void ttf_toggle_hinting();
-TTFSurface * ttf_surface_cache_get_or_add(TTF_Font * font, const utf8 * text);
-uint32 ttf_getwidth_cache_get_or_add(TTF_Font * font, const utf8 * text);
+TTFSurface * ttf_render_string(TTF_Font * font, const utf8 * text);
+uint32 ttf_get_text_width(TTF_Font * font, const utf8 * text);
 bool ttf_provides_glyph(const TTF_Font * font, codepoint_t codepoint);
 void ttf_free_surface(TTFSurface * surface);
 
@@ -54,6 +75,9 @@ int TTF_Init(void);
 TTF_Font * TTF_OpenFont(const char *file, int ptsize);
 int TTF_GlyphIsProvided(const TTF_Font *font, codepoint_t ch);
 int TTF_SizeUTF8(TTF_Font *font, const char *text, int *w, int *h);
+void TTF_GetFontMetrics(TTF_Font *font, TTFFontMetrics *metrics);
+int TTF_GetGlyph(TTF_Font *font, uint16 ch, bool shaded, TTFGlyph *glyph);
+int TTF_GetKerning(TTF_Font *font, uint32 prevIndex, uint32 index);
 TTFSurface * TTF_RenderUTF8_Solid(TTF_Font *font, const char *text, uint32 colour);
 TTFSurface * TTF_RenderUTF8_Shaded(TTF_Font *font, const char *text, uint32 fg, uint32 bg);
 void TTF_CloseFont(TTF_Font *font);
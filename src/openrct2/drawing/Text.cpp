@@ -16,11 +16,14 @@
 
 #include "Text.h"
 
+#include "../localisation/FormatStringCache.h"
 #include "../localisation/Localisation.h"
+#include "../util/Util.h"
 
 static TextPaint _legacyPaint;
 
 static void DrawText(rct_drawpixelinfo * dpi, sint32 x, sint32 y, TextPaint * paint, utf8string text);
+static void DrawText(rct_drawpixelinfo * dpi, sint32 x, sint32 y, TextPaint * paint, utf8string text, sint32 width);
 static void DrawText(rct_drawpixelinfo * dpi, sint32 x, sint32 y, TextPaint * paint, rct_string_id format, void * args);
 
 StaticLayout::StaticLayout(utf8string source, TextPaint paint, sint32 width)
@@ -84,8 +87,11 @@ sint32 StaticLayout::GetLineCount()
 
 static void DrawText(rct_drawpixelinfo * dpi, sint32 x, sint32 y, TextPaint * paint, utf8string text)
 {
-    sint32 width = gfx_get_string_width(text);
+    DrawText(dpi, x, y, paint, text, gfx_get_string_width(text));
+}
 
+static void DrawText(rct_drawpixelinfo * dpi, sint32 x, sint32 y, TextPaint * paint, utf8string text, sint32 width)
+{
     switch (paint->Alignment) {
     case TextAlignment::LEFT:
         break;
@@ -111,9 +117,11 @@ static void DrawText(rct_drawpixelinfo * dpi, sint32 x, sint32 y, TextPaint * pa
 
 static void DrawText(rct_drawpixelinfo * dpi, sint32 x, sint32 y, TextPaint * paint, rct_string_id format, void * args)
 {
+    sint32 width;
     utf8 buffer[256];
-    format_string(buffer, sizeof(buffer), format, args);
-    DrawText(dpi, x, y, paint, buffer);
+    gCurrentFontSpriteBase = paint->SpriteBase;
+    safe_strcpy(buffer, format_string_cached(format, args, &width), sizeof(buffer));
+    DrawText(dpi, x, y, paint, buffer, width);
 }
 
 static void DrawTextCompat(rct_drawpixelinfo * dpi, sint32 x, sint32 y, rct_string_id format, void * args, uint8 colour,
@@ -137,11 +145,16 @@ static void DrawTextEllipsisedCompat(rct_drawpixelinfo * dpi, sint32 x, sint32 y
     _legacyPaint.SpriteBase = FONT_SPRITE_BASE_MEDIUM;
     gCurrentFontSpriteBase = FONT_SPRITE_BASE_MEDIUM;
 
+    // Only clip when the cached width says the text does not fit
+    sint32 textWidth;
     utf8 buffer[256];
-    format_string(buffer, sizeof(buffer), format, args);
-    gfx_clip_string(buffer, width);
+    safe_strcpy(buffer, format_string_cached(format, args, &textWidth), sizeof(buffer));
+    if (width < 6 || textWidth > width)
+    {
+        textWidth = gfx_clip_string(buffer, width);
+    }
 
-    DrawText(dpi, x, y, &_legacyPaint, buffer);
+    DrawText(dpi, x, y, &_legacyPaint, buffer, textWidth);
 }
 
 extern "C"
@@ -207,7 +220,7 @@ extern "C"
     sint32 gfx_draw_string_left_wrapped(rct_drawpixelinfo * dpi, void * args, sint32 x, sint32 y, sint32 width, rct_string_id format, uint8 colour)
     {
         utf8 buffer[256];
-        format_string(buffer, sizeof(buffer), format, args);
+        safe_strcpy(buffer, format_string_cached(format, args, nullptr), sizeof(buffer));
 
         gCurrentFontSpriteBase = FONT_SPRITE_BASE_MEDIUM;
 
@@ -225,7 +238,7 @@ extern "C"
     sint32 gfx_draw_string_centred_wrapped(rct_drawpixelinfo * dpi, void * args, sint32 x, sint32 y, sint32 width, rct_string_id format, uint8 colour)
     {
         utf8 buffer[256];
-        format_string(buffer, sizeof(buffer), format, args);
+        safe_strcpy(buffer, format_string_cached(format, args, nullptr), sizeof(buffer));
 
         gCurrentFontSpriteBase = FONT_SPRITE_BASE_MEDIUM;
 
@@ -145,7 +145,6 @@ X8DrawingEngine::X8DrawingEngine(Ui::IUiContext * uiContext)
 X8DrawingEngine::~X8DrawingEngine()
 {
     delete _drawingContext;
-    delete [] _dirtyGrid.Blocks;
     delete [] _bits;
 }
 
@@ -178,28 +177,18 @@ void X8DrawingEngine::Invalidate(sint32 left, sint32 top, sint32 right, sint32 b
     if (left >= right) return;
     if (top >= bottom) return;
 
-    right--;
-    bottom--;
-
-    left >>= _dirtyGrid.BlockShiftX;
-    right >>= _dirtyGrid.BlockShiftX;
-    top >>= _dirtyGrid.BlockShiftY;
-    bottom >>= _dirtyGrid.BlockShiftY;
-
-    uint32 dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8 * screenDirtyBlocks = _dirtyGrid.Blocks;
-    for (sint16 y = top; y <= bottom; y++)
-    {
-        uint32 yOffset = y * dirtyBlockColumns;
-        for (sint16 x = left; x <= right; x++)
-        {
-            screenDirtyBlocks[yOffset + x] = 0xFF;
-        }
-    }
+    left -= left % DirtyAlignX;
+    top -= top % DirtyAlignY;
+    right = Math::Min(((right + DirtyAlignX - 1) / DirtyAlignX) * DirtyAlignX, (sint32)_width);
+    bottom = Math::Min(((bottom + DirtyAlignY - 1) / DirtyAlignY) * DirtyAlignY, (sint32)_height);
+    _dirtyRegion.Union({ left, top, right, bottom });
 }
 
 void X8DrawingEngine::BeginDraw()
 {
+    _dirtyStats = { 0 };
+    _dirtyStats.ScreenPixels = (uint64)_width * _height;
+
     if (gIntroState == INTRO_STATE_NONE)
     {
 #ifdef __ENABLE_LIGHTFX__
@@ -209,9 +198,19 @@ void X8DrawingEngine::BeginDraw()
             Resize(_width, _height);
         }
 #endif
+        // Rain is spread over the whole viewport, so present everything when it changes
+        if (!_rainDrawer.IsEmpty())
+        {
+            MarkPresentDirtyAll();
+        }
         _rainDrawer.SetDPI(&_bitsDPI);
         _rainDrawer.Restore();
     }
+    else
+    {
+        // The intro draws straight to the screen without invalidating
+        MarkPresentDirtyAll();
+    }
 }
 
 void X8DrawingEngine::EndDraw()
@@ -224,9 +223,9 @@ void X8DrawingEngine::PaintWindows()
 
     // Redraw dirty regions before updating the viewports, otherwise
     // when viewports get panned, they copy dirty pixels
-    DrawAllDirtyBlocks();
+    DrawDirtyRegion();
     window_update_all_viewports();
-    DrawAllDirtyBlocks();
+    DrawDirtyRegion();
 
     // TODO move this out from drawing
     window_update_all();
@@ -235,6 +234,10 @@ void X8DrawingEngine::PaintWindows()
 void X8DrawingEngine::PaintRain()
 {
     DrawRain(&_bitsDPI, &_rainDrawer);
+    if (!_rainDrawer.IsEmpty())
+    {
+        MarkPresentDirtyAll();
+    }
 }
 
 void X8DrawingEngine::CopyRect(sint32 x, sint32 y, sint32 width, sint32 height, sint32 dx, sint32 dy)
@@ -274,6 +277,8 @@ void X8DrawingEngine::CopyRect(sint32 x, sint32 y, sint32 width, sint32 height,
         to += stride;
         from += stride;
     }
+
+    MarkPresentDirty(x, y, x + width, y + height);
 }
 
 sint32 X8DrawingEngine::Screenshot()
@@ -302,6 +307,12 @@ void X8DrawingEngine::InvalidateImage(uint32 image)
     // Not applicable for this engine
 }
 
+bool X8DrawingEngine::GetDirtyRegionStats(DirtyRegionStats * stats)
+{
+    *stats = _dirtyStats;
+    return true;
+}
+
 rct_drawpixelinfo * X8DrawingEngine::GetDPI()
 {
     return &_bitsDPI;
@@ -356,7 +367,9 @@ void X8DrawingEngine::ConfigureBits(uint32 width, uint32 height, uint32 pitch)
     dpi->height = height;
     dpi->pitch = _pitch - width;
 
-    ConfigureDirtyGrid();
+    _dirtyRegion.Clear();
+    _presentRegion.Clear();
+    _presentAll = true;
 
 #ifdef __ENABLE_LIGHTFX__
         if (lightfx_is_available())
@@ -366,99 +379,73 @@ void X8DrawingEngine::ConfigureBits(uint32 width, uint32 height, uint32 pitch)
 #endif
 }
 
-void X8DrawingEngine::OnDrawDirtyBlock(uint32 x, uint32 y, uint32 columns, uint32 rows)
+void X8DrawingEngine::OnDrawDirtyRect(const DirtyRect &rect)
 {
 }
 
-void X8DrawingEngine::ConfigureDirtyGrid()
+void X8DrawingEngine::MarkPresentDirty(sint32 left, sint32 top, sint32 right, sint32 bottom)
 {
-    _dirtyGrid.BlockShiftX = 7;
-    _dirtyGrid.BlockShiftY = 6;
-    _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
-    _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
-    _dirtyGrid.BlockColumns = (_width >> _dirtyGrid.BlockShiftX) + 1;
-    _dirtyGrid.BlockRows = (_height >> _dirtyGrid.BlockShiftY) + 1;
-
-    delete [] _dirtyGrid.Blocks;
-    _dirtyGrid.Blocks = new uint8[_dirtyGrid.BlockColumns * _dirtyGrid.BlockRows];
-}
-
-void X8DrawingEngine::DrawAllDirtyBlocks()
-{
-    uint32  dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint32  dirtyBlockRows = _dirtyGrid.BlockRows;
-    uint8 * dirtyBlocks = _dirtyGrid.Blocks;
-
-    for (uint32 x = 0; x < dirtyBlockColumns; x++)
+    left = Math::Max(left, 0);
+    top = Math::Max(top, 0);
+    right = Math::Min(right, (sint32)_width);
+    bottom = Math::Min(bottom, (sint32)_height);
+    if (!_presentAll)
     {
-        for (uint32 y = 0; y < dirtyBlockRows; y++)
-        {
-            uint32 yOffset = y * dirtyBlockColumns;
-            if (dirtyBlocks[yOffset + x] == 0)
-            {
-                continue;
-            }
-
-            // Determine columns
-            uint32 xx;
-            for (xx = x; xx < dirtyBlockColumns; xx++)
-            {
-                if (dirtyBlocks[yOffset + xx] == 0)
-                {
-                    break;
-                }
-            }
-            uint32 columns = xx - x;
-
-            // Check rows
-            uint32 yy;
-            for (yy = y; yy < dirtyBlockRows; yy++)
-            {
-                uint32 yyOffset = yy * dirtyBlockColumns;
-                for (xx = x; xx < x + columns; xx++)
-                {
-                    if (dirtyBlocks[yyOffset + xx] == 0)
-                    {
-                        goto endRowCheck;
-                    }
-                }
-            }
-
-        endRowCheck:
-            uint32 rows = yy - y;
-            DrawDirtyBlocks(x, y, columns, rows);
-        }
+        _presentRegion.Union({ left, top, right, bottom });
     }
 }
 
-void X8DrawingEngine::DrawDirtyBlocks(uint32 x, uint32 y, uint32 columns, uint32 rows)
+void X8DrawingEngine::MarkPresentDirtyAll()
 {
-    uint32  dirtyBlockColumns = _dirtyGrid.BlockColumns;
-    uint8 * screenDirtyBlocks = _dirtyGrid.Blocks;
+    _presentAll = true;
+}
 
-    // Unset dirty blocks
-    for (uint32 top = y; top < y + (uint32)rows; top++)
+/**
+ * Gets the regions of the screen that have changed since the last call, merged into as few rectangles
+ * as possible, and resets them.
+ */
+void X8DrawingEngine::GetPresentDirtyRects(std::vector<PresentRect> * rects)
+{
+    rects->clear();
+    if (_presentAll)
     {
-        uint32 topOffset = top * dirtyBlockColumns;
-        for (uint32 left = x; left < x + (uint32)columns; left++)
+        _presentRegion.Clear();
+        _presentAll = false;
+        if (_width > 0 && _height > 0)
         {
-            screenDirtyBlocks[topOffset + left] = 0;
+            rects->push_back({ 0, 0, _width, _height });
         }
+        return;
     }
 
-    // Determine region in pixels
-    uint32 left = Math::Max<uint32>(0, x * _dirtyGrid.BlockWidth);
-    uint32 top = Math::Max<uint32>(0, y * _dirtyGrid.BlockHeight);
-    uint32 right = Math::Min(_width, left + (columns * _dirtyGrid.BlockWidth));
-    uint32 bottom = Math::Min(_height, top + (rows * _dirtyGrid.BlockHeight));
-    if (right <= left || bottom <= top)
+    // Overlays such as the console, chat and the FPS counter invalidate the area they have just drawn
+    // over, so areas still waiting to be redrawn have to be presented as well
+    _presentRegion.Union(_dirtyRegion);
+    for (const auto &rect : _presentRegion.GetRects())
     {
-        return;
+        rects->push_back({ (uint32)rect.Left, (uint32)rect.Top, (uint32)(rect.Right - rect.Left), (uint32)(rect.Bottom - rect.Top) });
     }
+    _presentRegion.Clear();
+}
+
+/**
+ * Redraws the windows over each rectangle of the dirty region. The rectangles never overlap, so no pixel is
+ * drawn twice in a pass however many invalidations covered it.
+ */
+void X8DrawingEngine::DrawDirtyRegion()
+{
+    // Take the region before drawing, anything invalidated while drawing is left for the next pass
+    DirtyRegion region;
+    std::swap(region, _dirtyRegion);
+    for (const auto &rect : region.GetRects())
+    {
+        OnDrawDirtyRect(rect);
+        MarkPresentDirty(rect.Left, rect.Top, rect.Right, rect.Bottom);
+        window_draw_all(&_bitsDPI, rect.Left, rect.Top, rect.Right, rect.Bottom);
 
-    // Draw region
-    OnDrawDirtyBlock(x, y, columns, rows);
-    window_draw_all(&_bitsDPI, left, top, right, bottom);
+        _dirtyStats.Rects++;
+        _dirtyStats.Pixels += rect.GetArea();
+    }
 }
 
 #ifdef __WARN_SUGGEST_FINAL_METHODS__
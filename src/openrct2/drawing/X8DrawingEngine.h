@@ -18,7 +18,9 @@
 
 #ifdef __cplusplus
 
+#include <vector>
 #include "../common.h"
+#include "DirtyRegion.h"
 #include "IDrawingContext.h"
 #include "IDrawingEngine.h"
 
@@ -33,15 +35,12 @@ namespace OpenRCT2
     {
         class X8DrawingContext;
 
-        struct DirtyGrid
+        struct PresentRect
         {
-            uint32  BlockShiftX;
-            uint32  BlockShiftY;
-            uint32  BlockWidth;
-            uint32  BlockHeight;
-            uint32  BlockColumns;
-            uint32  BlockRows;
-            uint8 * Blocks;
+            uint32 X;
+            uint32 Y;
+            uint32 Width;
+            uint32 Height;
         };
 
         class X8RainDrawer final : public IRainDrawer
@@ -66,6 +65,7 @@ namespace OpenRCT2
             void SetDPI(rct_drawpixelinfo * dpi);
             void Draw(sint32 x, sint32 y, sint32 width, sint32 height, sint32 xStart, sint32 yStart) override;
             void Restore();
+            bool IsEmpty() const { return _rainPixelsCount == 0; }
         };
 
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
@@ -75,13 +75,23 @@ namespace OpenRCT2
         class X8DrawingEngine : public IDrawingEngine
         {
         protected:
+            // Invalidated areas are widened to these so that nearby small sprites coalesce into one rectangle
+            static constexpr sint32 DirtyAlignX = 32;
+            static constexpr sint32 DirtyAlignY = 16;
+
             uint32  _width      = 0;
             uint32  _height     = 0;
             uint32  _pitch      = 0;
             size_t  _bitsSize   = 0;
             uint8 * _bits       = nullptr;
 
-            DirtyGrid   _dirtyGrid  = { 0 };
+            // Area waiting to be redrawn
+            DirtyRegion         _dirtyRegion;
+            DirtyRegionStats    _dirtyStats = { 0 };
+
+            // Area that has changed since the frame was last presented
+            DirtyRegion _presentRegion;
+            bool        _presentAll = true;
 
             rct_drawpixelinfo _bitsDPI  = { 0 };
 
@@ -111,18 +121,20 @@ namespace OpenRCT2
             rct_drawpixelinfo * GetDrawingPixelInfo() override;
             DRAWING_ENGINE_FLAGS GetFlags() override;
             void InvalidateImage(uint32 image) override;
+            bool GetDirtyRegionStats(DirtyRegionStats * stats) override;
 
             rct_drawpixelinfo * GetDPI();
 
         protected:
             void ConfigureBits(uint32 width, uint32 height, uint32 pitch);
-            virtual void OnDrawDirtyBlock(uint32 x, uint32 y, uint32 columns, uint32 rows);
+            virtual void OnDrawDirtyRect(const DirtyRect &rect);
+            void MarkPresentDirty(sint32 left, sint32 top, sint32 right, sint32 bottom);
+            void MarkPresentDirtyAll();
+            void GetPresentDirtyRects(std::vector<PresentRect> * rects);
 
         private:
-            void ConfigureDirtyGrid();
             static void ResetWindowVisbilities();
-            void DrawAllDirtyBlocks();
-            void DrawDirtyBlocks(uint32 x, uint32 y, uint32 columns, uint32 rows);
+            void DrawDirtyRegion();
         };
 #ifdef __WARN_SUGGEST_FINAL_TYPES__
     #pragma GCC diagnostic pop
@@ -1161,6 +1161,58 @@ int TTF_SizeUTF8(TTF_Font *font, const char *text, int *w, int *h)
     return status;
 }
 
+void TTF_GetFontMetrics(TTF_Font *font, TTFFontMetrics *metrics)
+{
+    metrics->height = font->height;
+    metrics->ascent = font->ascent;
+    metrics->overhang = TTF_HANDLE_STYLE_BOLD(font) ? font->glyph_overhang : 0;
+    metrics->kerning = FT_HAS_KERNING(font->face) && font->kerning;
+}
+
+int TTF_GetGlyph(TTF_Font *font, uint16 ch, bool shaded, TTFGlyph *glyph)
+{
+    FT_Error error;
+    c_glyph *cached;
+    FT_Bitmap *current;
+
+    error = Find_Glyph(font, ch, CACHED_METRICS | (shaded ? CACHED_PIXMAP : CACHED_BITMAP));
+    if (error) {
+        TTF_SetFTError("Couldn't find glyph", error);
+        return -1;
+    }
+    cached = font->current;
+    current = shaded ? &cached->pixmap : &cached->bitmap;
+
+    glyph->index = cached->index;
+    glyph->minx = cached->minx;
+    glyph->maxx = cached->maxx;
+    glyph->miny = cached->miny;
+    glyph->maxy = cached->maxy;
+    glyph->yoffset = cached->yoffset;
+    glyph->advance = cached->advance;
+
+    /* The buffer is only valid until the next glyph is loaded from this font */
+    glyph->buffer = current->buffer;
+    glyph->width = current->width;
+    glyph->rows = current->rows;
+    glyph->pitch = current->pitch;
+
+    /* Ensure the width of the pixmap is correct, as in the render functions */
+    if (font->outline <= 0 && glyph->width > glyph->maxx - glyph->minx) {
+        glyph->width = glyph->maxx - glyph->minx;
+    }
+    return 0;
+}
+
+int TTF_GetKerning(TTF_Font *font, uint32 prevIndex, uint32 index)
+{
+    FT_Vector delta;
+    if (FT_Get_Kerning(font->face, prevIndex, index, ft_kerning_default, &delta) != 0) {
+        return 0;
+    }
+    return delta.x >> 6;
+}
+
 TTFSurface *TTF_RenderUTF8_Solid(TTF_Font *font,
     const char *text, uint32 colour)
 {
@@ -28,6 +28,7 @@
 #include "../Game.h"
 #include "../Input.h"
 #include "../interface/themes.h"
+#include "../localisation/FormatStringCache.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/User.h"
 #include "../management/Finance.h"
@@ -1328,6 +1329,28 @@ static sint32 cc_show_limits(const utf8 ** argv, sint32 argc)
     return 0;
 }
 
+static sint32 cc_format_cache(const utf8 ** argv, sint32 argc)
+{
+    if (argc > 0 && strcmp(argv[0], "reset") == 0)
+    {
+        format_string_cache_reset_stats();
+        console_printf("Format cache statistics have been reset.");
+        return 0;
+    }
+
+    format_string_cache_stats stats;
+    format_string_cache_get_stats(&stats);
+
+    uint32 lookups = stats.hits + stats.misses + stats.uncacheable;
+    float hitRate = lookups == 0 ? 0.0f : (stats.hits * 100.0f) / lookups;
+    console_printf("Entries: %u", stats.entries);
+    console_printf("Hits: %u (%.1f%%)", stats.hits, hitRate);
+    console_printf("Misses: %u", stats.misses);
+    console_printf("Uncacheable: %u", stats.uncacheable);
+    console_printf("Evictions: %u", stats.evictions);
+    return 0;
+}
+
 static sint32 cc_for_date(const utf8 **argv, sint32 argc)
 {
     sint32 year = 0;
@@ -1463,6 +1486,7 @@ static constexpr const console_command console_command_table[] = {
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences"},
     { "show_limits", cc_show_limits, "Shows the map data counts and limits.", "show_limits" },
+    { "format_cache", cc_format_cache, "Shows the formatted string cache statistics.", "format_cache [reset]" },
     { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]."}
 };
 
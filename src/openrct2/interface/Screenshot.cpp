@@ -15,10 +15,18 @@
 #pragma endregion
 
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "../audio/audio.h"
 #include "../Context.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileStream.hpp"
+#include "../core/JobPool.hpp"
 #include "../Imaging.h"
 #include "../OpenRCT2.h"
 #include "Screenshot.h"
@@ -356,70 +364,270 @@ sint32 cmdline_for_gfxbench(const char **argv, sint32 argc)
     return 1;
 }
 
-sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOptions * options)
-{
-    // Don't include options in the count (they have been handled by CommandLine::ParseOptions already)
-    for (sint32 i = 0; i < argc; i++)
-    {
-        if (argv[i][0] == '-')
-        {
-            // Setting argc to i works, because options can only be at the end of the command
-            argc = i;
-            break;
-        }
-    }
+/**
+ * What to render for a single screenshot, as given on the command line.
+ */
+// Largest width or height of a screenshot that is not sized from the map
+constexpr sint32 SCREENSHOT_MAX_DIMENSION = 16384;
 
+struct ScreenshotJob
+{
+    const char * input_path   = nullptr;
+    const char * output_path  = nullptr;
+    sint32 width              = 0;
+    sint32 height             = 0;
+    bool custom_location      = false;
+    bool centre_map_x         = false;
+    bool centre_map_y         = false;
+    sint32 x                  = 0;
+    sint32 y                  = 0;
+    sint32 zoom               = 0;
+    sint32 rotation           = 0;
+};
+
+static bool screenshot_parse_job(const char * * argv, sint32 argc, ScreenshotJob * job)
+{
     bool giantScreenshot = (argc == 5) && _stricmp(argv[2], "giant") == 0;
     if (argc != 4 && argc != 8 && !giantScreenshot) {
-        std::printf("Usage: openrct2 screenshot <file> <ouput_image> <width> <height> [<x> <y> <zoom> <rotation>]\n");
-        std::printf("Usage: openrct2 screenshot <file> <ouput_image> giant <zoom> <rotation>\n");
-        return -1;
+        return false;
     }
 
-    core_init();
-    bool customLocation = false;
-    bool centreMapX = false;
-    bool centreMapY = false;
-    sint32 resolutionWidth, resolutionHeight, customX = 0, customY = 0, customZoom, customRotation = 0;
-
-    const char *inputPath = argv[0];
-    const char *outputPath = argv[1];
+    job->input_path = argv[0];
+    job->output_path = argv[1];
     if (giantScreenshot)
     {
-        resolutionWidth = 0;
-        resolutionHeight = 0;
-        customLocation = true;
-        centreMapX = true;
-        centreMapY = true;
-        customZoom = std::atoi(argv[3]);
-        customRotation = std::atoi(argv[4]) & 3;
+        job->width = 0;
+        job->height = 0;
+        job->custom_location = true;
+        job->centre_map_x = true;
+        job->centre_map_y = true;
+        job->zoom = std::atoi(argv[3]);
+        job->rotation = std::atoi(argv[4]) & 3;
     }
     else
     {
-        resolutionWidth = std::atoi(argv[2]);
-        resolutionHeight = std::atoi(argv[3]);
+        job->width = std::atoi(argv[2]);
+        job->height = std::atoi(argv[3]);
         if (argc == 8)
         {
-            customLocation = true;
+            job->custom_location = true;
             if (argv[4][0] == 'c')
-                centreMapX = true;
+                job->centre_map_x = true;
             else
-                customX = std::atoi(argv[4]);
+                job->x = std::atoi(argv[4]);
 
             if (argv[5][0] == 'c')
-                centreMapY = true;
+                job->centre_map_y = true;
             else
-                customY = std::atoi(argv[5]);
+                job->y = std::atoi(argv[5]);
 
-            customZoom = std::atoi(argv[6]);
-            customRotation = std::atoi(argv[7]) & 3;
+            job->zoom = std::atoi(argv[6]);
+            job->rotation = std::atoi(argv[7]) & 3;
         }
         else
         {
-            customZoom = 0;
+            job->zoom = 0;
+        }
+    }
+    return true;
+}
+
+/**
+ * Checks the values of a parsed job, as jobs given to the render server come from outside. Returns the reason the job
+ * can not be rendered, or nullptr if it can.
+ */
+static const char * screenshot_validate_job(const ScreenshotJob * job)
+{
+    // A width and height of 0 sizes the image from the map, as giant screenshots do
+    if (job->width != 0 || job->height != 0)
+    {
+        if (job->width <= 0 || job->height <= 0 ||
+            job->width > SCREENSHOT_MAX_DIMENSION || job->height > SCREENSHOT_MAX_DIMENSION)
+        {
+            return "width and height must be between 1 and 16384";
+        }
+    }
+    if (job->zoom < 0 || job->zoom > 3)
+    {
+        return "zoom must be between 0 and 3";
+    }
+    return nullptr;
+}
+
+static void screenshot_print_usage()
+{
+    std::printf("Usage: openrct2 screenshot <file> <ouput_image> <width> <height> [<x> <y> <zoom> <rotation>]\n");
+    std::printf("Usage: openrct2 screenshot <file> <ouput_image> giant <zoom> <rotation>\n");
+}
+
+static bool screenshot_check_options(const ScreenshotOptions * options)
+{
+    if (options->weather < 0 || options->weather > 6)
+    {
+        std::printf("Weather can only be set to an integer value from 1 till 6.");
+        return false;
+    }
+    return true;
+}
+
+static void screenshot_setup_viewport(const ScreenshotJob * job, rct_viewport * viewport)
+{
+    sint32 mapSize = gMapSize;
+    sint32 resolutionWidth = job->width;
+    sint32 resolutionHeight = job->height;
+    if (resolutionWidth == 0 || resolutionHeight == 0) {
+        resolutionWidth = (mapSize * 32 * 2) >> job->zoom;
+        resolutionHeight = (mapSize * 32 * 1) >> job->zoom;
+
+        resolutionWidth += 8;
+        resolutionHeight += 128;
+    }
+
+    viewport->x = 0;
+    viewport->y = 0;
+    viewport->width = resolutionWidth;
+    viewport->height = resolutionHeight;
+    viewport->view_width = viewport->width;
+    viewport->view_height = viewport->height;
+    viewport->var_11 = 0;
+    viewport->flags = 0;
+
+    if (job->custom_location) {
+        sint32 customX = job->centre_map_x ? (mapSize / 2) * 32 + 16 : job->x;
+        sint32 customY = job->centre_map_y ? (mapSize / 2) * 32 + 16 : job->y;
+
+        sint32 x = 0, y = 0;
+        sint32 z = tile_element_height(customX, customY) & 0xFFFF;
+        switch (job->rotation) {
+        case 0:
+            x = customY - customX;
+            y = ((customX + customY) / 2) - z;
+            break;
+        case 1:
+            x = -customY - customX;
+            y = ((-customX + customY) / 2) - z;
+            break;
+        case 2:
+            x = -customY + customX;
+            y = ((-customX - customY) / 2) - z;
+            break;
+        case 3:
+            x = customY + customX;
+            y = ((customX - customY) / 2) - z;
+            break;
+        }
+
+        viewport->view_x = x - ((viewport->view_width << job->zoom) / 2);
+        viewport->view_y = y - ((viewport->view_height << job->zoom) / 2);
+        viewport->zoom = job->zoom;
+        gCurrentRotation = job->rotation;
+    } else {
+        viewport->view_x = gSavedViewX - (viewport->view_width / 2);
+        viewport->view_y = gSavedViewY - (viewport->view_height / 2);
+        viewport->zoom = gSavedViewZoom;
+        gCurrentRotation = gSavedViewRotation;
+    }
+}
+
+/**
+ * Renders a job from the park that is currently loaded, returning false if the image could not be allocated. The
+ * caller is responsible for freeing the bits.
+ */
+static bool screenshot_render_job(const ScreenshotJob * job, const ScreenshotOptions * options, rct_drawpixelinfo * outDpi)
+{
+    rct_viewport viewport;
+    screenshot_setup_viewport(job, &viewport);
+
+    rct_drawpixelinfo dpi;
+    dpi.x = 0;
+    dpi.y = 0;
+    dpi.width = viewport.width;
+    dpi.height = viewport.height;
+    dpi.pitch = 0;
+    dpi.zoom_level = 0;
+    dpi.bits = (uint8 *)malloc((size_t)dpi.width * (size_t)dpi.height);
+    if (dpi.bits == nullptr)
+    {
+        return false;
+    }
+
+    if (options->weather != 0)
+    {
+        uint8 customWeather = options->weather - 1;
+        climate_force_weather(customWeather);
+    }
+
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
+
+    if (options->hide_guests)
+    {
+        viewport.flags |= VIEWPORT_FLAG_INVISIBLE_PEEPS;
+    }
+
+    if (options->hide_sprites)
+    {
+        viewport.flags |= VIEWPORT_FLAG_INVISIBLE_SPRITES;
+    }
+
+    if (options->mowed_grass)
+    {
+        game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_SETGRASSLENGTH, GRASS_LENGTH_MOWED, GAME_COMMAND_CHEAT, 0, 0);
+    }
+
+    if (options->clear_grass || options->tidy_up_park)
+    {
+        game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_SETGRASSLENGTH, GRASS_LENGTH_CLEAR_0, GAME_COMMAND_CHEAT, 0, 0);
+    }
+
+    if (options->water_plants || options->tidy_up_park)
+    {
+        game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_WATERPLANTS, 0, GAME_COMMAND_CHEAT, 0, 0);
+    }
+
+    if (options->fix_vandalism || options->tidy_up_park)
+    {
+        game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_FIXVANDALISM, 0, GAME_COMMAND_CHEAT, 0, 0);
+    }
+
+    if (options->remove_litter || options->tidy_up_park)
+    {
+        game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_REMOVELITTER, 0, GAME_COMMAND_CHEAT, 0, 0);
+    }
+
+    viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+    *outDpi = dpi;
+    return true;
+}
+
+sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOptions * options)
+{
+    // Don't include options in the count (they have been handled by CommandLine::ParseOptions already)
+    for (sint32 i = 0; i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            // Setting argc to i works, because options can only be at the end of the command
+            argc = i;
+            break;
         }
     }
 
+    ScreenshotJob job;
+    if (!screenshot_parse_job(argv, argc, &job)) {
+        screenshot_print_usage();
+        return -1;
+    }
+    const char * jobError = screenshot_validate_job(&job);
+    if (jobError != nullptr) {
+        std::printf("%s\n", jobError);
+        return -1;
+    }
+    if (!screenshot_check_options(options)) {
+        return -1;
+    }
+
+    core_init();
     gOpenRCT2Headless = true;
     auto context = CreateContext();
     if (context->Initialise())
@@ -428,7 +636,7 @@ sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOption
 
         try
         {
-            context->LoadParkFromFile(inputPath);
+            context->LoadParkFromFile(job.input_path);
         }
         catch (const std::exception &e)
         {
@@ -441,134 +649,221 @@ sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOption
         gIntroState = INTRO_STATE_NONE;
         gScreenFlags = SCREEN_FLAGS_PLAYING;
 
-        sint32 mapSize = gMapSize;
-        if (resolutionWidth == 0 || resolutionHeight == 0) {
-            resolutionWidth = (mapSize * 32 * 2) >> customZoom;
-            resolutionHeight = (mapSize * 32 * 1) >> customZoom;
-
-            resolutionWidth += 8;
-            resolutionHeight += 128;
+        rct_drawpixelinfo dpi;
+        if (!screenshot_render_job(&job, options, &dpi))
+        {
+            std::printf("Unable to allocate the image.\n");
+            drawing_engine_dispose();
+            delete context;
+            return -1;
         }
 
-        rct_viewport viewport;
-        viewport.x = 0;
-        viewport.y = 0;
-        viewport.width = resolutionWidth;
-        viewport.height = resolutionHeight;
-        viewport.view_width = viewport.width;
-        viewport.view_height = viewport.height;
-        viewport.var_11 = 0;
-        viewport.flags = 0;
+        rct_palette renderedPalette;
+        screenshot_get_rendered_palette(&renderedPalette);
 
-        if (customLocation) {
-            if (centreMapX)
-                customX = (mapSize / 2) * 32 + 16;
-            if (centreMapY)
-                customY = (mapSize / 2) * 32 + 16;
-
-            sint32 x = 0, y = 0;
-            sint32 z = tile_element_height(customX, customY) & 0xFFFF;
-            switch (customRotation) {
-            case 0:
-                x = customY - customX;
-                y = ((customX + customY) / 2) - z;
-                break;
-            case 1:
-                x = -customY - customX;
-                y = ((-customX + customY) / 2) - z;
-                break;
-            case 2:
-                x = -customY + customX;
-                y = ((-customX - customY) / 2) - z;
-                break;
-            case 3:
-                x = customY + customX;
-                y = ((customX - customY) / 2) - z;
-                break;
-            }
+        image_io_png_write(&dpi, &renderedPalette, job.output_path);
 
-            viewport.view_x = x - ((viewport.view_width << customZoom) / 2);
-            viewport.view_y = y - ((viewport.view_height << customZoom) / 2);
-            viewport.zoom = customZoom;
-            gCurrentRotation = customRotation;
-        } else {
-            viewport.view_x = gSavedViewX - (viewport.view_width / 2);
-            viewport.view_y = gSavedViewY - (viewport.view_height / 2);
-            viewport.zoom = gSavedViewZoom;
-            gCurrentRotation = gSavedViewRotation;
-        }
+        free(dpi.bits);
+        drawing_engine_dispose();
+    }
+    delete context;
+    return 1;
+}
 
-        if (options->weather != 0)
+/**
+ * Splits a job line into arguments at spaces, text in double quotes is kept together so paths can contain spaces.
+ */
+static std::vector<std::string> screenshot_split_job_line(const std::string &line)
+{
+    std::vector<std::string> args;
+    std::string arg;
+    bool inArg = false;
+    bool inQuotes = false;
+    for (char c : line)
+    {
+        if (c == '"')
         {
-            if (options->weather < 1 || options->weather > 6)
+            inQuotes = !inQuotes;
+            inArg = true;
+        }
+        else if (!inQuotes && (c == ' ' || c == '\t' || c == '\r'))
+        {
+            if (inArg)
             {
-                std::printf("Weather can only be set to an integer value from 1 till 6.");
-                drawing_engine_dispose();
-                delete context;
-                return -1;
+                args.push_back(arg);
+                arg.clear();
+                inArg = false;
             }
-
-            uint8 customWeather = options->weather - 1;
-            climate_force_weather(customWeather);
         }
+        else
+        {
+            arg.push_back(c);
+            inArg = true;
+        }
+    }
+    if (inArg)
+    {
+        args.push_back(arg);
+    }
+    return args;
+}
 
-        // Ensure sprites appear regardless of rotation
-        reset_all_sprite_quadrant_placements();
+sint32 cmdline_for_render_server(ScreenshotOptions * options)
+{
+    if (!screenshot_check_options(options)) {
+        return -1;
+    }
 
-        rct_drawpixelinfo dpi;
-        dpi.x = 0;
-        dpi.y = 0;
-        dpi.width = resolutionWidth;
-        dpi.height = resolutionHeight;
-        dpi.pitch = 0;
-        dpi.zoom_level = 0;
-        dpi.bits = (uint8 *)malloc(dpi.width * dpi.height);
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = CreateContext();
+    if (!context->Initialise())
+    {
+        delete context;
+        return -1;
+    }
+    drawing_engine_init();
 
-        if (options->hide_guests)
+    gIntroState = INTRO_STATE_NONE;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    // Results are written by the workers as soon as each image is saved, so they can come back out of order
+    std::mutex outputMutex;
+    auto writeResult = [&outputMutex](const std::string &outputPath, const char * error)
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        if (error == nullptr)
         {
-            viewport.flags |= VIEWPORT_FLAG_INVISIBLE_PEEPS;
+            Console::WriteLine("ok %s", outputPath.c_str());
         }
-
-        if (options->hide_sprites)
+        else
         {
-            viewport.flags |= VIEWPORT_FLAG_INVISIBLE_SPRITES;
+            Console::WriteLine("error %s %s", outputPath.c_str(), error);
         }
-
-        if (options->mowed_grass)
+        fflush(stdout);
+    };
+
+    // The park and everything it loaded stay in memory, so jobs for the same park skip loading entirely and jobs for
+    // other parks only load the objects the previous park did not use. Rendering has to happen on this thread, but
+    // the images are compressed and saved on the pool while the next job renders.
+    JobPool pool;
+    size_t maxPendingImages = pool.CountThreads() * 2;
+    size_t pendingImages = 0;
+    std::mutex pendingMutex;
+    std::condition_variable pendingCondition;
+    std::string loadedPath;
+    uint64 loadedSize = 0;
+    uint64 loadedLastModified = 0;
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        std::vector<std::string> args = screenshot_split_job_line(line);
+        if (args.empty())
         {
-            game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_SETGRASSLENGTH, GRASS_LENGTH_MOWED, GAME_COMMAND_CHEAT, 0, 0);
+            continue;
         }
 
-        if (options->clear_grass || options->tidy_up_park)
+        std::vector<const char *> argv;
+        for (const auto &arg : args)
         {
-            game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_SETGRASSLENGTH, GRASS_LENGTH_CLEAR_0, GAME_COMMAND_CHEAT, 0, 0);
+            argv.push_back(arg.c_str());
         }
 
-        if (options->water_plants || options->tidy_up_park)
+        ScreenshotJob job;
+        if (!screenshot_parse_job(argv.data(), (sint32)argv.size(), &job))
         {
-            game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_WATERPLANTS, 0, GAME_COMMAND_CHEAT, 0, 0);
+            writeResult(args.size() >= 2 ? args[1] : args[0], "invalid job, expected <file> <output_image> <width> <height> [<x> <y> <zoom> <rotation>]");
+            continue;
+        }
+        const char * jobError = screenshot_validate_job(&job);
+        if (jobError != nullptr)
+        {
+            writeResult(job.output_path, jobError);
+            continue;
         }
 
-        if (options->fix_vandalism || options->tidy_up_park)
+        // A park rewritten at the same path has to be loaded again, so the file has to match as well as the path
+        uint64 inputSize = 0;
+        uint64 inputLastModified = 0;
+        try
         {
-            game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_FIXVANDALISM, 0, GAME_COMMAND_CHEAT, 0, 0);
+            inputSize = FileStream(job.input_path, FILE_MODE_OPEN).GetLength();
+            inputLastModified = File::GetLastModified(job.input_path);
+        }
+        catch (const std::exception &e)
+        {
+            loadedPath.clear();
+            writeResult(job.output_path, e.what());
+            continue;
         }
 
-        if (options->remove_litter || options->tidy_up_park)
+        if (loadedPath != job.input_path || loadedSize != inputSize || loadedLastModified != inputLastModified)
         {
-            game_do_command(0, GAME_COMMAND_FLAG_APPLY, CHEAT_REMOVELITTER, 0, GAME_COMMAND_CHEAT, 0, 0);
+            // The importers report corrupt files and missing objects by returning false, so a failed load may have
+            // left a partly imported park behind
+            loadedPath.clear();
+            bool loaded;
+            try
+            {
+                loaded = context->LoadParkFromFile(job.input_path);
+            }
+            catch (const std::exception &e)
+            {
+                writeResult(job.output_path, e.what());
+                continue;
+            }
+            if (!loaded)
+            {
+                writeResult(job.output_path, "unable to load park");
+                continue;
+            }
+            loadedPath = job.input_path;
+            loadedSize = inputSize;
+            loadedLastModified = inputLastModified;
+
+            gIntroState = INTRO_STATE_NONE;
+            gScreenFlags = SCREEN_FLAGS_PLAYING;
         }
 
-        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+        // Do not let finished renders pile up faster than they can be saved, but carry on as soon as one is
+        {
+            std::unique_lock<std::mutex> lock(pendingMutex);
+            pendingCondition.wait(lock, [&pendingImages, maxPendingImages]()
+            {
+                return pendingImages < maxPendingImages;
+            });
+        }
 
+        rct_drawpixelinfo dpi;
+        if (!screenshot_render_job(&job, options, &dpi))
+        {
+            writeResult(job.output_path, "unable to allocate image");
+            continue;
+        }
         rct_palette renderedPalette;
         screenshot_get_rendered_palette(&renderedPalette);
 
-        image_io_png_write(&dpi, &renderedPalette, outputPath);
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            pendingImages++;
+        }
 
-        free(dpi.bits);
-        drawing_engine_dispose();
+        std::string outputPath = job.output_path;
+        pool.AddTask([dpi, renderedPalette, outputPath, &pendingImages, &pendingMutex, &pendingCondition, &writeResult]() -> void
+        {
+            bool saved = image_io_png_write(&dpi, &renderedPalette, outputPath.c_str());
+            free(dpi.bits);
+            writeResult(outputPath, saved ? nullptr : "unable to save image");
+            {
+                std::lock_guard<std::mutex> lock(pendingMutex);
+                pendingImages--;
+            }
+            pendingCondition.notify_one();
+        });
     }
+    pool.Join();
+
+    drawing_engine_dispose();
     delete context;
     return 1;
 }
@@ -46,6 +46,7 @@ extern "C"
 
     void screenshot_giant();
     sint32 cmdline_for_screenshot(const char * * argv, sint32 argc, ScreenshotOptions * options);
+    sint32 cmdline_for_render_server(ScreenshotOptions * options);
     sint32 cmdline_for_gfxbench(const char **argv, sint32 argc);
 #ifdef __cplusplus
 }
@@ -18,6 +18,7 @@
 #include "../config/Config.h"
 #include "../Context.h"
 #include "../core/Math.hpp"
+#include "../drawing/DirtyRegion.h"
 #include "../drawing/Drawing.h"
 #include "../Game.h"
 #include "../Input.h"
@@ -252,163 +253,96 @@ void viewport_adjust_for_map_height(sint16* x, sint16* y, sint16 *z)
     *z = height;
 }
 
-/*
-*  rct2: 0x006E7FF3
-*/
-static void viewport_redraw_after_shift(rct_drawpixelinfo *dpi, rct_window *window, rct_viewport *viewport, sint32 x, sint32 y)
+/**
+ * Returns the part of the viewport that is not covered by the windows above it. Transparent windows are left out too
+ * and invalidated, as they have to be drawn again on top of whatever the viewport shows through them.
+ */
+static DirtyRegion viewport_get_visible_region(rct_window * window, rct_viewport * viewport)
 {
-    // sub-divide by intersecting windows
-    if (window < gWindowNextSlot)
-    {
-        // skip current window and non-intersecting windows
-        if (viewport == window->viewport                                ||
-            viewport->x + viewport->width  <= window->x                 ||
-            viewport->x                    >= window->x + window->width ||
-            viewport->y + viewport->height <= window->y                 ||
-            viewport->y                    >= window->y + window->height){
-            viewport_redraw_after_shift(dpi, window + 1, viewport, x, y);
-            return;
-        }
+    DirtyRegion region;
+    region.Union({ viewport->x, viewport->y, viewport->x + viewport->width, viewport->y + viewport->height });
 
-        // save viewport
-        rct_viewport view_copy;
-        memcpy(&view_copy, viewport, sizeof(rct_viewport));
+    for (rct_window * w = window; w < gWindowNextSlot && !region.IsEmpty(); w++)
+    {
+        if (w->viewport == viewport) continue;
 
-        if (viewport->x < window->x)
+        DirtyRect windowRect = { w->x, w->y, w->x + w->width, w->y + w->height };
+        if (w->flags & WF_TRANSPARENT)
         {
-            viewport->width = window->x - viewport->x;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
-
-            viewport->x += viewport->width;
-            viewport->view_x += viewport->width << viewport->zoom;
-            viewport->width = view_copy.width - viewport->width;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
-        }
-        else if (viewport->x + viewport->width > window->x + window->width)
-        {
-            viewport->width = window->x + window->width - viewport->x;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
-
-            viewport->x += viewport->width;
-            viewport->view_x += viewport->width << viewport->zoom;
-            viewport->width = view_copy.width - viewport->width;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
-        }
-        else if (viewport->y < window->y)
-        {
-            viewport->height = window->y - viewport->y;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
-
-            viewport->y += viewport->height;
-            viewport->view_y += viewport->height << viewport->zoom;
-            viewport->height = view_copy.height - viewport->height;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
-        }
-        else if (viewport->y + viewport->height > window->y + window->height)
-        {
-            viewport->height = window->y + window->height - viewport->y;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
-
-            viewport->y += viewport->height;
-            viewport->view_y += viewport->height << viewport->zoom;
-            viewport->height = view_copy.height - viewport->height;
-            viewport->view_width = viewport->width << viewport->zoom;
-            viewport_redraw_after_shift(dpi, window, viewport, x, y);
+            for (const auto &rect : region.Intersect(windowRect).GetRects())
+            {
+                gfx_set_dirty_blocks(rect.Left, rect.Top, rect.Right, rect.Bottom);
+            }
         }
-
-        // restore viewport
-        memcpy(viewport, &view_copy, sizeof(rct_viewport));
+        region.Subtract(windowRect);
     }
-    else
-    {
-        sint16 left = viewport->x;
-        sint16 right = viewport->x + viewport->width;
-        sint16 top = viewport->y;
-        sint16 bottom = viewport->y + viewport->height;
+    return region;
+}
 
-        // if moved more than the viewport size
-        if (abs(x) < viewport->width && abs(y) < viewport->height)
-        {
-            // update whole block ?
-            drawing_engine_copy_rect(viewport->x, viewport->y, viewport->width, viewport->height, x, y);
+/**
+ *  rct2: 0x006E7FF3
+ * Scrolls a viewport by copying the pixels that stay visible and invalidating only what is newly exposed. Pixels are
+ * only ever copied from the visible part of the viewport, so this works no matter how other windows overlap it.
+ */
+static void viewport_shift_pixels(rct_window * w, rct_viewport * viewport, sint16 x_diff, sint16 y_diff)
+{
+    DirtyRegion exposed = viewport_get_visible_region(w, viewport);
+    const auto &visible = exposed.GetRects();
 
-            if (x > 0)
-            {
-                // draw left
-                sint16 _right = viewport->x + x;
-                window_draw_all(dpi, left, top, _right, bottom);
-                left += x;
-            }
-            else if (x < 0)
+    // Every visible pixel whose old position was visible too can be copied
+    std::vector<DirtyRect> pieces;
+    if (abs(x_diff) < viewport->width && abs(y_diff) < viewport->height)
+    {
+        for (const auto &dst : visible)
+        {
+            for (const auto &src : visible)
             {
-                // draw right
-                sint16 _left = viewport->x + viewport->width + x;
-                window_draw_all(dpi, _left, top, right, bottom);
-                right += x;
+                DirtyRect piece =
+                {
+                    std::max(dst.Left, src.Left + x_diff),
+                    std::max(dst.Top, src.Top + y_diff),
+                    std::min(dst.Right, src.Right + x_diff),
+                    std::min(dst.Bottom, src.Bottom + y_diff),
+                };
+                if (!piece.IsEmpty())
+                {
+                    pieces.push_back(piece);
+                }
             }
+        }
+    }
 
-            if (y > 0)
-            {
-                // draw top
-                bottom = viewport->y + y;
-                window_draw_all(dpi, left, top, right, bottom);
-            }
-            else if (y < 0)
+    // A piece can only be copied once no other piece still has to read pixels it overwrites, whatever is left in a
+    // cycle is drawn again instead
+    while (!pieces.empty())
+    {
+        auto ready = std::find_if(pieces.begin(), pieces.end(), [&pieces, x_diff, y_diff](const DirtyRect &piece) -> bool
+        {
+            for (const auto &other : pieces)
             {
-                // draw bottom
-                top = viewport->y + viewport->height + y;
-                window_draw_all(dpi, left, top, right, bottom);
+                DirtyRect source = { other.Left - x_diff, other.Top - y_diff, other.Right - x_diff, other.Bottom - y_diff };
+                if (&other != &piece && source.Intersects(piece))
+                {
+                    return false;
+                }
             }
-        }
-        else
+            return true;
+        });
+        if (ready == pieces.end())
         {
-            // redraw whole viewport
-            window_draw_all(dpi, left, top, right, bottom);
+            break;
         }
-    }
-}
-
-static void viewport_shift_pixels(rct_drawpixelinfo *dpi, rct_window* w, rct_viewport* viewport, sint16 x_diff, sint16 y_diff)
-{
-    rct_window* orignal_w = w;
-    sint32 left = 0, right = 0, top = 0, bottom = 0;
-
-    for (; w < gWindowNextSlot; w++){
-        if (!(w->flags & WF_TRANSPARENT)) continue;
-        if (w->viewport == viewport) continue;
-
-        if (viewport->x + viewport->width <= w->x)continue;
-        if (w->x + w->width <= viewport->x) continue;
 
-        if (viewport->y + viewport->height <= w->y)continue;
-        if (w->y + w->height <= viewport->y) continue;
-
-        left = w->x;
-        right = w->x + w->width;
-        top = w->y;
-        bottom = w->y + w->height;
-
-        if (left < viewport->x)left = viewport->x;
-        if (right > viewport->x + viewport->width) right = viewport->x + viewport->width;
-
-        if (top < viewport->y)top = viewport->y;
-        if (bottom > viewport->y + viewport->height) bottom = viewport->y + viewport->height;
-
-        if (left >= right) continue;
-        if (top >= bottom) continue;
-
-        window_draw_all(dpi, left, top, right, bottom);
+        DirtyRect piece = *ready;
+        pieces.erase(ready);
+        drawing_engine_copy_rect(piece.Left, piece.Top, piece.Right - piece.Left, piece.Bottom - piece.Top, x_diff, y_diff);
+        exposed.Subtract(piece);
     }
 
-    w = orignal_w;
-    viewport_redraw_after_shift(dpi, w, viewport, x_diff, y_diff);
+    for (const auto &rect : exposed.GetRects())
+    {
+        gfx_set_dirty_blocks(rect.Left, rect.Top, rect.Right, rect.Bottom);
+    }
 }
 
 static void viewport_move(sint16 x, sint16 y, rct_window* w, rct_viewport* viewport)
@@ -483,8 +417,7 @@ static void viewport_move(sint16 x, sint16 y, rct_window* w, rct_viewport* viewp
     }
 
     if (drawing_engine_has_dirty_optimisations()) {
-        rct_drawpixelinfo *dpi = drawing_engine_get_dpi();
-        viewport_shift_pixels(dpi, w, viewport, x_diff, y_diff);
+        viewport_shift_pixels(w, viewport, x_diff, y_diff);
     }
 
     memcpy(viewport, &view_copy, sizeof(rct_viewport));
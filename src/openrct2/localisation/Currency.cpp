@@ -17,6 +17,7 @@
 #include "../config/Config.h"
 #include "../util/Util.h"
 #include "Currency.h"
+#include "FormatStringCache.h"
 #include "StringIds.h"
 
 // clang-format off
@@ -49,4 +50,5 @@ void currency_load_custom_currency_config()
     {
         safe_strcpy(CurrencyDescriptors[CURRENCY_CUSTOM].symbol_unicode, gConfigGeneral.custom_currency_symbol, CURRENCY_SYMBOL_MAX_SIZE);
     }
+    format_string_cache_invalidate();
 }
@@ -0,0 +1,239 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../config/Config.h"
+#include "../drawing/Drawing.h"
+#include "FormatStringCache.h"
+#include "Localisation.h"
+
+namespace
+{
+    constexpr size_t MAX_ENTRIES = 2048;
+    constexpr size_t MAX_ARGS_SIZE = 64;
+    constexpr size_t MAX_ARGS_SIZES_PER_FORMAT = 8;
+
+    struct CacheEntry
+    {
+        rct_string_id   Format = STR_NONE;
+        uint8           ArgsSize = 0;
+        uint8           Args[MAX_ARGS_SIZE] = {};
+        sint32          Width = -1;
+        sint16          WidthFontSpriteBase = 0;
+        uint32          LastUsed = 0;
+        std::string     Text;
+    };
+
+    // Everything outside the arguments that changes the formatted text
+    struct CacheSettings
+    {
+        sint32 Language = LANGUAGE_UNDEFINED;
+        sint32 CurrencyFormat = -1;
+        sint32 MeasurementFormat = -1;
+
+        bool operator==(const CacheSettings &other) const
+        {
+            return Language == other.Language &&
+                   CurrencyFormat == other.CurrencyFormat &&
+                   MeasurementFormat == other.MeasurementFormat;
+        }
+    };
+}
+
+static std::unordered_map<uint64, CacheEntry> _entries;
+// The argument sizes seen so far for each string id, usually just one
+static std::unordered_map<rct_string_id, std::vector<uint8>> _argsSizes;
+static CacheSettings _settings;
+static uint32 _useCounter;
+static format_string_cache_stats _stats;
+static utf8 _uncachedBuffer[256];
+
+static uint64 GetKey(rct_string_id format, const uint8 * args, size_t argsSize)
+{
+    // FNV-1a
+    uint64 hash = 0xCBF29CE484222325ULL;
+    auto mix = [&hash](uint8 value)
+    {
+        hash ^= value;
+        hash *= 0x100000001B3ULL;
+    };
+    mix(format & 0xFF);
+    mix(format >> 8);
+    mix((uint8)argsSize);
+    for (size_t i = 0; i < argsSize; i++)
+    {
+        mix(args[i]);
+    }
+    return hash;
+}
+
+static void CheckSettings()
+{
+    CacheSettings settings;
+    settings.Language = gCurrentLanguage;
+    settings.CurrencyFormat = gConfigGeneral.currency_format;
+    settings.MeasurementFormat = gConfigGeneral.measurement_format;
+    if (!(settings == _settings))
+    {
+        format_string_cache_invalidate();
+        _settings = settings;
+    }
+}
+
+static void EvictLeastRecentlyUsed()
+{
+    // Drop the older half of the entries in one go so eviction stays amortised O(1) per insert
+    std::vector<uint32> lastUsed;
+    lastUsed.reserve(_entries.size());
+    for (const auto &kvp : _entries)
+    {
+        lastUsed.push_back(kvp.second.LastUsed);
+    }
+    auto median = lastUsed.begin() + lastUsed.size() / 2;
+    std::nth_element(lastUsed.begin(), median, lastUsed.end());
+    uint32 threshold = *median;
+
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->second.LastUsed < threshold)
+        {
+            it = _entries.erase(it);
+            _stats.evictions++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+static CacheEntry * FindEntry(rct_string_id format, const uint8 * args)
+{
+    auto sizesIt = _argsSizes.find(format);
+    if (sizesIt == _argsSizes.end())
+    {
+        return nullptr;
+    }
+    for (uint8 argsSize : sizesIt->second)
+    {
+        auto it = _entries.find(GetKey(format, args, argsSize));
+        if (it != _entries.end())
+        {
+            CacheEntry * entry = &it->second;
+            if (entry->Format == format &&
+                entry->ArgsSize == argsSize &&
+                std::memcmp(entry->Args, args, argsSize) == 0)
+            {
+                return entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+static CacheEntry * GetEntry(rct_string_id format, const void * args)
+{
+    CheckSettings();
+
+    auto argsBytes = (const uint8 *)args;
+    CacheEntry * entry = FindEntry(format, argsBytes);
+    if (entry != nullptr)
+    {
+        _stats.hits++;
+        entry->LastUsed = ++_useCounter;
+        return entry;
+    }
+
+    size_t argsSize;
+    bool readPointer;
+    format_string_tracked(_uncachedBuffer, sizeof(_uncachedBuffer), format, (void *)args, &argsSize, &readPointer);
+
+    // Text built from a {STRING} pointer can change without the arguments changing
+    auto &argsSizes = _argsSizes[format];
+    bool knownSize = std::find(argsSizes.begin(), argsSizes.end(), (uint8)argsSize) != argsSizes.end();
+    if (readPointer || argsSize > MAX_ARGS_SIZE || (!knownSize && argsSizes.size() >= MAX_ARGS_SIZES_PER_FORMAT))
+    {
+        _stats.uncacheable++;
+        return nullptr;
+    }
+    _stats.misses++;
+
+    if (!knownSize)
+    {
+        argsSizes.push_back((uint8)argsSize);
+    }
+    if (_entries.size() >= MAX_ENTRIES)
+    {
+        EvictLeastRecentlyUsed();
+    }
+
+    entry = &_entries[GetKey(format, argsBytes, argsSize)];
+    entry->Format = format;
+    entry->ArgsSize = (uint8)argsSize;
+    std::memcpy(entry->Args, argsBytes, argsSize);
+    entry->Width = -1;
+    entry->LastUsed = ++_useCounter;
+    entry->Text = _uncachedBuffer;
+    return entry;
+}
+
+extern "C"
+{
+    const utf8 * format_string_cached(rct_string_id format, const void * args, sint32 * outWidth)
+    {
+        CacheEntry * entry = GetEntry(format, args);
+        if (entry == nullptr)
+        {
+            if (outWidth != nullptr)
+            {
+                *outWidth = gfx_get_string_width(_uncachedBuffer);
+            }
+            return _uncachedBuffer;
+        }
+
+        if (outWidth != nullptr)
+        {
+            if (entry->Width == -1 || entry->WidthFontSpriteBase != gCurrentFontSpriteBase)
+            {
+                entry->Width = gfx_get_string_width(entry->Text.c_str());
+                entry->WidthFontSpriteBase = gCurrentFontSpriteBase;
+            }
+            *outWidth = entry->Width;
+        }
+        return entry->Text.c_str();
+    }
+
+    void format_string_cache_invalidate()
+    {
+        _entries.clear();
+        _argsSizes.clear();
+    }
+
+    void format_string_cache_get_stats(format_string_cache_stats * stats)
+    {
+        *stats = _stats;
+        stats->entries = (uint32)_entries.size();
+    }
+
+    void format_string_cache_reset_stats()
+    {
+        _stats = {};
+    }
+}
@@ -0,0 +1,46 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include "../common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct format_string_cache_stats {
+    uint32 hits;
+    uint32 misses;
+    uint32 uncacheable;
+    uint32 evictions;
+    uint32 entries;
+} format_string_cache_stats;
+
+/**
+ * Returns the formatted text for the given string id and arguments, formatting it only if it is not
+ * already cached. If outWidth is not null, it receives the width of the text in the current font.
+ * The returned string is only valid until the next call into the cache.
+ */
+const utf8 * format_string_cached(rct_string_id format, const void * args, sint32 * outWidth);
+
+void format_string_cache_invalidate();
+void format_string_cache_get_stats(format_string_cache_stats * stats);
+void format_string_cache_reset_stats();
+
+#ifdef __cplusplus
+}
+#endif
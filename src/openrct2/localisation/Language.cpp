@@ -24,6 +24,7 @@
 #include "LanguagePack.h"
 
 #include "../platform/platform.h"
+#include "FormatStringCache.h"
 #include "Localisation.h"
 
 // clang-format off
@@ -143,6 +144,7 @@ bool language_open(sint32 id)
     {
         gCurrentLanguage = id;
         TryLoadFonts();
+        format_string_cache_invalidate();
 
         // Objects and their localised strings need to be refreshed
         GetObjectManager()->ResetObjects();
@@ -258,6 +260,9 @@ void language_free_object_string(rct_string_id stringId)
             _languageCurrent->RemoveString(stringId);
         }
         _availableObjectStringIds.push(stringId);
+
+        // The id will be given to another object, so text cached for it is about to be wrong
+        format_string_cache_invalidate();
     }
 }
 
@@ -286,5 +291,6 @@ rct_string_id language_allocate_object_string(const std::string &target)
     rct_string_id stringId = _availableObjectStringIds.top();
     _availableObjectStringIds.pop();
     _languageCurrent->SetString(stringId, target);
+    format_string_cache_invalidate();
     return stringId;
 }
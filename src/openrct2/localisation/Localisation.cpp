@@ -343,6 +343,17 @@ const rct_string_id DateGameShortMonthNames[MONTH_COUNT] = {
 static void format_string_part_from_raw(char **dest, size_t *size, const char *src, char **args);
 static void format_string_part(char **dest, size_t *size, rct_string_id format, char **args);
 
+// Furthest argument read by the current format_string call and whether a {STRING} pointer was followed
+static const char * _formatArgsEnd;
+static bool _formatReadStringPointer;
+
+static void format_track_args(const char * args)
+{
+    if (args > _formatArgsEnd) {
+        _formatArgsEnd = args;
+    }
+}
+
 static void format_append_string(char **dest, size_t *size, const utf8 *string) {
     if ((*size) == 0) return;
     size_t length = strlen(string);
@@ -973,6 +984,7 @@ static void format_string_code(uint32 format_code, char **dest, size_t *size, ch
         value = *((uintptr_t*)*args);
         *args += sizeof(uintptr_t);
 
+        _formatReadStringPointer = true;
         if (value != 0)
             format_append_string(dest, size, (char*)value);
         break;
@@ -1076,6 +1088,7 @@ static void format_string_part_from_raw(utf8 **dest, size_t *size, const utf8 *s
             format_push_char(code);
         } else if (code < FORMAT_COLOUR_CODE_START || code == FORMAT_COMMA1DP16) {
             format_string_code(code, dest, size, args);
+            format_track_args(*args);
         } else {
             size_t codepointLength = (size_t)utf8_get_codepoint_length(code);
             format_handle_overflow(codepointLength);
@@ -1104,6 +1117,7 @@ static void format_string_part(utf8 **dest, size_t *size, rct_string_id format,
         // Bits 10, 11 represent number of bytes to pop off arguments
         *args += (format & 0xC00) >> 9;
         format &= ~0xC00;
+        format_track_args(*args);
 
         format_append_string_n(dest, size, gUserStrings[format], USER_STRING_MAX_LENGTH);
         if ((*size) > 0) *(*dest) = '\0';
@@ -1119,6 +1133,7 @@ static void format_string_part(utf8 **dest, size_t *size, rct_string_id format,
         *(*dest) = '\0';
 
         *args += 4;
+        format_track_args(*args);
     } else {
         // ?
         log_error("Localisation CALLPROC reached. Please contact a dev");
@@ -1163,6 +1178,21 @@ void format_string(utf8 *dest, size_t size, rct_string_id format, void *args)
 #endif
 }
 
+/**
+ * Writes a formatted string to a buffer like format_string, also returning how many bytes of args were read and
+ * whether the result depends on anything other than those bytes (a {STRING} pointer argument).
+ */
+void format_string_tracked(utf8 *dest, size_t size, rct_string_id format, void *args, size_t *outArgsSize, bool *outReadPointer)
+{
+    _formatArgsEnd = (const char *)args;
+    _formatReadStringPointer = false;
+
+    format_string(dest, size, format, args);
+
+    *outArgsSize = (size_t)(_formatArgsEnd - (const char *)args);
+    *outReadPointer = _formatReadStringPointer;
+}
+
 void format_string_raw(utf8 *dest, size_t size, utf8 *src, void *args)
 {
 #ifdef DEBUG
@@ -35,6 +35,7 @@ sint32 utf8_get_format_code_arg_length(sint32 codepoint);
 void utf8_remove_formatting(utf8* string, bool allowColours);
 
 void format_string(char *dest, size_t size, rct_string_id format, void *args);
+void format_string_tracked(char *dest, size_t size, rct_string_id format, void *args, size_t *outArgsSize, bool *outReadPointer);
 void format_string_raw(char *dest, size_t size, char *src, void *args);
 void format_string_to_upper(char *dest, size_t size, rct_string_id format, void *args);
 void generate_string_file();
@@ -3870,6 +3870,8 @@ enum {
     STR_TILE_INSPECTOR_TERRAIN_EDGE_SKYSCRAPER_A = 6213,
     STR_TILE_INSPECTOR_TERRAIN_EDGE_SKYSCRAPER_B = 6214,
 
+    STR_MULTIPLAYER_TRAFFIC_STATS = 6215,
+
     // Have to include resource strings (from scenarios and objects) for the time being now that language is partially working
     STR_COUNT = 32768
 };
@@ -17,6 +17,7 @@
 #include "../Game.h"
 #include "../ride/Ride.h"
 #include "../util/Util.h"
+#include "FormatStringCache.h"
 #include "Localisation.h"
 #include "User.h"
 
@@ -31,6 +32,7 @@ static bool user_string_exists(const utf8 *text);
 void user_string_clear_all()
 {
     memset(gUserStrings, 0, MAX_USER_STRINGS * USER_STRING_MAX_LENGTH);
+    format_string_cache_invalidate();
 }
 
 /**
@@ -55,6 +57,7 @@ rct_string_id user_string_allocate(sint32 base, const utf8 *text)
             continue;
 
         safe_strcpy(userString, text, USER_STRING_MAX_LENGTH);
+        format_string_cache_invalidate();
         return USER_STRING_START + (i | highBits);
     }
     gGameCommandErrorText = STR_TOO_MANY_NAMES_DEFINED;
@@ -72,6 +75,7 @@ void user_string_free(rct_string_id id)
 
     id %= MAX_USER_STRINGS;
     gUserStrings[id][0] = 0;
+    format_string_cache_invalidate();
 }
 
 static bool user_string_exists(const utf8 *text)
@@ -100,6 +104,7 @@ void reset_user_strings()
     {
         gUserStrings[i][0] = 0;
     }
+    format_string_cache_invalidate();
 
     ride_reset_all_names();
 }
@@ -38,6 +38,7 @@ static sint32 _pickup_peep_old_x = LOCATION_NULL;
 #include <cmath>
 #include <cerrno>
 #include <algorithm>
+#include <future>
 #include <set>
 #include <string>
 
@@ -112,6 +113,7 @@ Network::Network()
     client_command_handlers[NETWORK_COMMAND_GAMEINFO] = &Network::Client_Handle_GAMEINFO;
     client_command_handlers[NETWORK_COMMAND_TOKEN] = &Network::Client_Handle_TOKEN;
     client_command_handlers[NETWORK_COMMAND_OBJECTS] = &Network::Client_Handle_OBJECTS;
+    client_command_handlers[NETWORK_COMMAND_CHECKSUMS] = &Network::Client_Handle_CHECKSUMS;
     server_command_handlers.resize(NETWORK_COMMAND_MAX, nullptr);
     server_command_handlers[NETWORK_COMMAND_AUTH] = &Network::Server_Handle_AUTH;
     server_command_handlers[NETWORK_COMMAND_CHAT] = &Network::Server_Handle_CHAT;
@@ -121,6 +123,7 @@ Network::Network()
     server_command_handlers[NETWORK_COMMAND_GAMEINFO] = &Network::Server_Handle_GAMEINFO;
     server_command_handlers[NETWORK_COMMAND_TOKEN] = &Network::Server_Handle_TOKEN;
     server_command_handlers[NETWORK_COMMAND_OBJECTS] = &Network::Server_Handle_OBJECTS;
+    server_command_handlers[NETWORK_COMMAND_CHECKSUMS] = &Network::Server_Handle_CHECKSUMS;
     OpenSSL_add_all_algorithms();
 
     _chat_log_fs << std::unitbuf;
@@ -185,6 +188,9 @@ void Network::Close()
     CloseChatLog();
     CloseServerLog();
 
+    // Stop the network thread before the connections it reads from are destroyed
+    _receiver = nullptr;
+
     mode = NETWORK_MODE_NONE;
     status = NETWORK_STATUS_NONE;
     _lastConnectStatus = SOCKET_STATUS_CLOSED;
@@ -194,6 +200,12 @@ void Network::Close()
     SafeDelete(server_connection);
 
     client_connection_list.clear();
+    _disconnectedTrafficStats = {};
+    _mapPayloads.clear();
+    _checksumHistory.clear();
+    _checksumTracker.Reset();
+    _localChecksums = nullptr;
+    _localDesyncSprites.clear();
     game_command_queue.clear();
     player_list.clear();
     group_list.clear();
@@ -320,6 +332,12 @@ bool Network::BeginServer(uint16 port, const char* address)
         return false;
     }
 
+    // Dedicated servers read from clients on a separate thread so the game thread only deals with whole packets
+    if (gOpenRCT2Headless)
+    {
+        _receiver = NetworkReceiver::Create();
+    }
+
     ServerName = String::ToStd(gConfigNetwork.server_name);
     ServerDescription = String::ToStd(gConfigNetwork.server_description);
     ServerGreeting = String::ToStd(gConfigNetwork.server_greeting);
@@ -389,6 +407,27 @@ uint32 Network::GetServerTick()
     return server_tick;
 }
 
+NetworkTrafficStats Network::GetTrafficStats()
+{
+    NetworkTrafficStats stats = _disconnectedTrafficStats;
+    auto addConnection = [&stats](const NetworkConnection &connection) -> void
+    {
+        NetworkTrafficStats connectionStats = connection.GetTrafficStats();
+        stats.BytesSent += connectionStats.BytesSent;
+        stats.BytesSentUncompressed += connectionStats.BytesSentUncompressed;
+        stats.BytesReceived += connectionStats.BytesReceived;
+        stats.BytesReceivedUncompressed += connectionStats.BytesReceivedUncompressed;
+    };
+    if (GetMode() == NETWORK_MODE_CLIENT) {
+        addConnection(*server_connection);
+    } else {
+        for (auto &connection : client_connection_list) {
+            addConnection(*connection);
+        }
+    }
+    return stats;
+}
+
 uint8 Network::GetPlayerID()
 {
     return player_id;
@@ -422,9 +461,10 @@ void Network::Flush()
     }
     else
     {
+        NetworkCompressionCache compressionCache;
         for (auto& it : client_connection_list)
         {
-            it->SendQueuedPackets();
+            it->SendQueuedPackets(&compressionCache);
         }
     }
 }
@@ -441,6 +481,8 @@ void Network::UpdateServer()
         }
     }
 
+    UpdateMapPayloads();
+
     uint32 ticks = platform_get_ticks();
     if (ticks > last_ping_sent_time + 3000) {
         Server_Send_PING();
@@ -649,14 +691,35 @@ bool Network::CheckSRAND(uint32 tick, uint32 srand0)
     if (tick == server_srand0_tick)
     {
         server_srand0_tick = 0;
-        // Check that the server and client sprite hashes match
-        const char *client_sprite_hash = sprite_checksum();
-        const bool sprites_mismatch = server_sprite_hash[0] != '\0' && strcmp(client_sprite_hash, server_sprite_hash);
-        // Check PRNG values and sprite hashes, if exist
-        if ((srand0 != server_srand0) || sprites_mismatch) {
+        // Check that the server and client checksums match
+        bool checksums_mismatch = false;
+        const NetworkChecksumTree * checksums = nullptr;
+        if (server_checksums_valid)
+        {
+            checksums = &_checksumTracker.Update(tick);
+            checksums_mismatch = checksums->Summary != server_checksums;
+        }
+        // Check PRNG values and checksums, if exist
+        if ((srand0 != server_srand0) || checksums_mismatch) {
 #ifdef DEBUG_DESYNC
-            dbg_report_desync(tick, srand0, server_srand0, client_sprite_hash, server_sprite_hash);
+            std::string client_hash = checksums_mismatch ? String::StdFormat("%08x", checksums->Summary.Root) : std::string();
+            std::string server_hash = server_checksums_valid ? String::StdFormat("%08x", server_checksums.Root) : std::string();
+            dbg_report_desync(tick, srand0, server_srand0, client_hash.c_str(), server_hash.c_str());
 #endif
+            if (checksums_mismatch)
+            {
+                // The answer arrives ticks later, keep the checksums and sprites as they are now to describe the ones
+                // that differ
+                _localChecksums = std::make_unique<NetworkChecksumTree>(*checksums);
+                _localDesyncSprites.resize(MAX_SPRITES);
+                for (size_t i = 0; i < MAX_SPRITES; i++)
+                {
+                    _localDesyncSprites[i] = *get_sprite(i);
+                }
+
+                // Ask the server for the branches that differ so we can tell what diverged
+                Client_Send_CHECKSUMS(*_localChecksums);
+            }
             return false;
         }
     }
@@ -1025,6 +1088,7 @@ void Network::Client_Send_AUTH(const char* name, const char* password, const cha
     assert(sigsize <= (size_t)UINT32_MAX);
     *packet << (uint32)sigsize;
     packet->Write((const uint8 *)sig, sigsize);
+    *packet << (uint8)NETWORK_CAPABILITY_COMPRESSION;
     server_connection->AuthStatus = NETWORK_AUTH_REQUESTED;
     server_connection->QueuePacket(std::move(packet));
 }
@@ -1073,6 +1137,8 @@ void Network::Server_Send_AUTH(NetworkConnection& connection)
     *packet << (uint32)NETWORK_COMMAND_AUTH << (uint32)connection.AuthStatus << (uint8)new_playerid;
     if (connection.AuthStatus == NETWORK_AUTH_BADVERSION) {
         packet->WriteString(NETWORK_STREAM_ID);
+    } else if (connection.AuthStatus == NETWORK_AUTH_OK) {
+        *packet << (uint8)(connection.CompressionEnabled ? NETWORK_CAPABILITY_COMPRESSION : 0);
     }
     connection.QueuePacket(std::move(packet));
     if (connection.AuthStatus != NETWORK_AUTH_OK && connection.AuthStatus != NETWORK_AUTH_REQUIREPASSWORD) {
@@ -1083,82 +1149,169 @@ void Network::Server_Send_AUTH(NetworkConnection& connection)
 
 void Network::Server_Send_MAP(NetworkConnection* connection)
 {
-    std::vector<const ObjectRepositoryItem *> objects;
-    if (connection) {
-        objects = connection->RequestedObjects;
-    } else {
+    if (connection == nullptr)
+    {
         // This will send all custom objects to connected clients
         // TODO: fix it so custom objects negotiation is performed even in this case.
         IObjectManager * objManager = GetObjectManager();
-        objects = objManager->GetPackableObjects();
-    }
+        auto objects = objManager->GetPackableObjects();
 
-    size_t out_size;
-    uint8 * header = save_for_network(out_size, objects);
-    if (header == nullptr) {
-        if (connection) {
-            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-            connection->Socket->Disconnect();
+        // Everyone is about to receive the new map, so anything still being encoded is stale
+        for (auto &payload : _mapPayloads)
+        {
+            for (auto recipient : payload.Recipients)
+            {
+                recipient->ReleaseHeldPackets();
+            }
+            payload.Recipients.clear();
+            payload.Shareable = false;
         }
+
+        std::vector<uint8> sv6;
+        if (!save_for_network(sv6, objects))
+        {
+            return;
+        }
+        Server_Send_MAP_Chunks(nullptr, encode_for_network(std::move(sv6)));
         return;
     }
+
+    MapPayload * payload = GetOrCreateMapPayload(connection->RequestedObjects);
+    if (payload == nullptr)
+    {
+        connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+        connection->Socket->Disconnect();
+        return;
+    }
+    connection->HoldPackets();
+    payload->Recipients.push_back(connection);
+    UpdateMapPayloads();
+}
+
+void Network::Server_Send_MAP_Chunks(NetworkConnection* connection, const std::vector<uint8> &data)
+{
+    size_t out_size = data.size();
     size_t chunksize = 65000;
     for (size_t i = 0; i < out_size; i += chunksize) {
         size_t datasize = Math::Min(chunksize, out_size - i);
         std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
         *packet << (uint32)NETWORK_COMMAND_MAP << (uint32)out_size << (uint32)i;
-        packet->Write(&header[i], datasize);
+        packet->Write(&data[i], datasize);
         if (connection) {
             connection->QueuePacket(std::move(packet));
         } else {
             SendPacketToClients(*packet);
         }
     }
-    free(header);
 }
 
-uint8 * Network::save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const
+Network::MapPayload * Network::GetOrCreateMapPayload(const std::vector<const ObjectRepositoryItem *> &objects)
+{
+    // Joiners arriving in the same tick with the same object set can share one encoded map, as long
+    // as no game command has run since it was exported.
+    for (auto &payload : _mapPayloads)
+    {
+        if (payload.Shareable && payload.Tick == gCurrentTicks && payload.Objects == objects)
+        {
+            log_verbose("Reusing map encoded at tick %u", payload.Tick);
+            return &payload;
+        }
+    }
+
+    // Exporting reads the game state so it has to happen here, but compression can be done off the
+    // game thread.
+    std::vector<uint8> sv6;
+    if (!save_for_network(sv6, objects))
+    {
+        return nullptr;
+    }
+
+    _mapPayloads.emplace_back();
+    MapPayload &payload = _mapPayloads.back();
+    payload.Tick = gCurrentTicks;
+    payload.Objects = objects;
+    payload.Data = std::async(std::launch::async, [](std::vector<uint8> data) -> std::vector<uint8>
+    {
+        return encode_for_network(std::move(data));
+    }, std::move(sv6));
+    return &payload;
+}
+
+void Network::UpdateMapPayloads()
+{
+    auto it = _mapPayloads.begin();
+    while (it != _mapPayloads.end())
+    {
+        MapPayload &payload = *it;
+        bool ready = payload.Data.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        if (ready)
+        {
+            const std::vector<uint8> &data = payload.Data.get();
+            for (auto recipient : payload.Recipients)
+            {
+                Server_Send_MAP_Chunks(recipient, data);
+                recipient->ReleaseHeldPackets();
+            }
+            payload.Recipients.clear();
+        }
+
+        // Dropping the last reference to a future from std::async waits for it, so keep the payload until the
+        // compression has finished even if everyone waiting for it has left
+        if (ready && payload.Recipients.empty() && (!payload.Shareable || payload.Tick != gCurrentTicks))
+        {
+            it = _mapPayloads.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void Network::InvalidateMapPayloads()
+{
+    for (auto &payload : _mapPayloads)
+    {
+        payload.Shareable = false;
+    }
+}
+
+bool Network::save_for_network(std::vector<uint8> &out, const std::vector<const ObjectRepositoryItem *> &objects) const
 {
-    uint8 * header = nullptr;
-    out_size = 0;
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
     auto ms = MemoryStream();
-    if (!SaveMap(&ms, objects)) {
+    bool result = SaveMap(&ms, objects);
+    gUseRLE = RLEState;
+    if (!result) {
         log_warning("Failed to export map.");
-        return nullptr;
+        return false;
     }
-    gUseRLE = RLEState;
 
-    const void * data = ms.GetData();
-    sint32 size = ms.GetLength();
+    const uint8 * data = (const uint8 *)ms.GetData();
+    out.assign(data, data + ms.GetLength());
+    return true;
+}
 
-    uint8 *compressed = util_zlib_deflate((const uint8 *)data, size, &out_size);
-    if (compressed != nullptr)
+std::vector<uint8> Network::encode_for_network(std::vector<uint8> sv6)
+{
+    size_t out_size = 0;
+    uint8 *compressed = util_zlib_deflate(sv6.data(), sv6.size(), &out_size);
+    if (compressed == nullptr)
     {
-        header = (uint8 *)_strdup("open2_sv6_zlib");
-        size_t header_len = strlen((char *)header) + 1; // account for null terminator
-        header = (uint8 *)realloc(header, header_len + out_size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
-        } else {
-            memcpy(&header[header_len], compressed, out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
-        }
-        free(compressed);
-    } else {
         log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = (uint8 *)malloc(size);
-        if (header == nullptr) {
-            log_error("Failed to allocate %u bytes.", size);
-        } else {
-            out_size = size;
-            memcpy(header, data, size);
-        }
+        return sv6;
     }
-    return header;
+
+    static constexpr char header[] = "open2_sv6_zlib";
+    std::vector<uint8> result;
+    result.reserve(sizeof(header) + out_size); // sizeof accounts for null terminator
+    result.insert(result.end(), (const uint8 *)header, (const uint8 *)header + sizeof(header));
+    result.insert(result.end(), compressed, compressed + out_size);
+    free(compressed);
+    log_verbose("Sending map of size %zu bytes, compressed to %zu bytes", sv6.size(), result.size());
+    return result;
 }
 
 void Network::Client_Send_CHAT(const char* text)
@@ -1191,6 +1344,7 @@ void Network::Server_Send_GAMECMD(uint32 eax, uint32 ebx, uint32 ecx, uint32 edx
     *packet << (uint32)NETWORK_COMMAND_GAMECMD << (uint32)gCurrentTicks << eax << (ebx | GAME_COMMAND_FLAG_NETWORKED)
             << ecx << edx << esi << edi << ebp << playerid << callback;
     SendPacketToClients(*packet, false, true);
+    InvalidateMapPayloads();
 }
 
 void Network::Client_Send_GAME_ACTION(const GameAction *action)
@@ -1225,6 +1379,7 @@ void Network::Server_Send_GAME_ACTION(const GameAction *action)
     *packet << (uint32)NETWORK_COMMAND_GAME_ACTION << (uint32)gCurrentTicks << action->GetType() << stream;
 
     SendPacketToClients(*packet);
+    InvalidateMapPayloads();
 }
 
 void Network::Server_Send_TICK()
@@ -1239,25 +1394,69 @@ void Network::Server_Send_TICK()
 
     std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
     *packet << (uint32)NETWORK_COMMAND_TICK << (uint32)gCurrentTicks << (uint32)gScenarioSrand0;
-    uint32 flags = 0;
-    // Simple counter which limits how often a sprite checksum gets sent.
-    // This can get somewhat expensive, so we don't want to push it every tick in release,
-    // but debug version can check more often.
-    static sint32 checksum_counter = 0;
-    checksum_counter++;
-    if (checksum_counter >= 100) {
-        checksum_counter = 0;
-        flags |= NETWORK_TICK_FLAG_CHECKSUMS;
-    }
+    // The checksum tree only hashes again what changed since the last tick, so it is sent with every tick. The trees
+    // of the last ticks are kept so that clients which report a mismatch can be told which parts of it differ.
+    uint32 flags = NETWORK_TICK_FLAG_CHECKSUMS;
+
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     *packet << flags;
-    if (flags & NETWORK_TICK_FLAG_CHECKSUMS) {
-        packet->WriteString(sprite_checksum());
+
+    std::unique_ptr<NetworkChecksumTree> checksums;
+    if (_checksumHistory.size() >= NETWORK_CHECKSUM_HISTORY_SIZE)
+    {
+        checksums = std::move(_checksumHistory.front());
+        _checksumHistory.pop_front();
+    }
+    else
+    {
+        checksums = std::make_unique<NetworkChecksumTree>();
     }
+    *checksums = _checksumTracker.Update(gCurrentTicks);
+    checksums->Summary.Write(*packet);
+    _checksumHistory.push_back(std::move(checksums));
     SendPacketToClients(*packet);
 }
 
+void Network::Client_Send_CHECKSUMS(const NetworkChecksumTree &checksums)
+{
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << (uint32)NETWORK_COMMAND_CHECKSUMS << checksums.Tick;
+    for (auto blockHash : checksums.SpriteBlocks)
+    {
+        *packet << blockHash;
+    }
+    for (auto blockHash : checksums.TileBlocks)
+    {
+        *packet << blockHash;
+    }
+    server_connection->QueuePacket(std::move(packet));
+}
+
+void Network::Server_Send_CHECKSUMS(NetworkConnection& connection, uint32 tick, const NetworkChecksumTree * checksums, const std::vector<uint16> &spriteBlocks, const std::vector<uint16> &tileBlocks)
+{
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    *packet << (uint32)NETWORK_COMMAND_CHECKSUMS << tick << (uint8)(checksums != nullptr);
+    if (checksums != nullptr)
+    {
+        *packet << (uint16)spriteBlocks.size();
+        for (auto block : spriteBlocks)
+        {
+            *packet << block;
+            for (size_t i = 0; i < NetworkChecksum::SPRITE_BLOCK_SIZE; i++)
+            {
+                *packet << checksums->Sprites[block * NetworkChecksum::SPRITE_BLOCK_SIZE + i];
+            }
+        }
+        *packet << (uint16)tileBlocks.size();
+        for (auto block : tileBlocks)
+        {
+            *packet << block;
+        }
+    }
+    connection.QueuePacket(std::move(packet));
+}
+
 void Network::Server_Send_PLAYERLIST()
 {
     std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
@@ -1370,6 +1569,39 @@ void Network::Server_Send_EVENT_PLAYER_DISCONNECTED(const char *playerName, cons
 }
 
 bool Network::ProcessConnection(NetworkConnection& connection)
+{
+    if (_receiver != nullptr) {
+        // Check for the connection closing first so every packet received before it is still processed
+        bool closed = connection.IsReceiveClosed();
+        std::unique_ptr<NetworkPacket> packet;
+        while (connection.PopReceivedPacket(packet)) {
+            ProcessPacket(connection, *packet);
+            if (connection.Socket == nullptr) {
+                return false;
+            }
+        }
+        if (closed) {
+            if (!connection.GetLastDisconnectReason()) {
+                connection.SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+            }
+            return false;
+        }
+    } else {
+        if (!ReadPackets(connection)) {
+            return false;
+        }
+    }
+    connection.SendQueuedPackets();
+    if (!connection.ReceivedPacketRecently()) {
+        if (!connection.GetLastDisconnectReason()) {
+            connection.SetLastDisconnectReason(STR_MULTIPLAYER_NO_DATA);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool Network::ReadPackets(NetworkConnection& connection)
 {
     sint32 packetStatus;
     do {
@@ -1397,13 +1629,6 @@ bool Network::ProcessConnection(NetworkConnection& connection)
             break;
         }
     } while (packetStatus == NETWORK_READPACKET_MORE_DATA || packetStatus == NETWORK_READPACKET_SUCCESS);
-    connection.SendQueuedPackets();
-    if (!connection.ReceivedPacketRecently()) {
-        if (!connection.GetLastDisconnectReason()) {
-            connection.SetLastDisconnectReason(STR_MULTIPLAYER_NO_DATA);
-        }
-        return false;
-    }
     return true;
 }
 
@@ -1541,6 +1766,9 @@ void Network::AddClient(ITcpSocket * socket)
     char addr[128];
     snprintf(addr, sizeof(addr), "Client joined from %s", socket->GetHostName());
     AppendServerLog(addr);
+    if (_receiver != nullptr) {
+        _receiver->AddConnection(connection.get());
+    }
     client_connection_list.push_back(std::move(connection));
 }
 
@@ -1573,6 +1801,19 @@ void Network::RemoveClient(std::unique_ptr<NetworkConnection>& connection)
     player_list.erase(std::remove_if(player_list.begin(), player_list.end(), [connection_player](std::unique_ptr<NetworkPlayer>& player){
                           return player.get() == connection_player;
                       }), player_list.end());
+    for (auto &payload : _mapPayloads)
+    {
+        auto &recipients = payload.Recipients;
+        recipients.erase(std::remove(recipients.begin(), recipients.end(), connection.get()), recipients.end());
+    }
+    if (_receiver != nullptr) {
+        _receiver->RemoveConnection(connection.get());
+    }
+    NetworkTrafficStats connectionStats = connection->GetTrafficStats();
+    _disconnectedTrafficStats.BytesSent += connectionStats.BytesSent;
+    _disconnectedTrafficStats.BytesSentUncompressed += connectionStats.BytesSentUncompressed;
+    _disconnectedTrafficStats.BytesReceived += connectionStats.BytesReceived;
+    _disconnectedTrafficStats.BytesReceivedUncompressed += connectionStats.BytesReceivedUncompressed;
     client_connection_list.remove(connection);
     if (gConfigNetwork.pause_server_if_no_clients && game_is_not_paused() && client_connection_list.size() == 0)
     {
@@ -1726,8 +1967,13 @@ void Network::Client_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
     connection.AuthStatus = (NETWORK_AUTH)auth_status;
     switch(connection.AuthStatus) {
     case NETWORK_AUTH_OK:
+    {
+        uint8 capabilities;
+        packet >> capabilities;
+        connection.CompressionEnabled = (capabilities & NETWORK_CAPABILITY_COMPRESSION) != 0;
         Client_Send_GAMEINFO();
         break;
+    }
     case NETWORK_AUTH_BADNAME:
         connection.SetLastDisconnectReason(STR_MULTIPLAYER_BAD_PLAYER_NAME);
         connection.Socket->Disconnect();
@@ -1880,6 +2126,7 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
         const char *pubkey = (const char *)packet.ReadString();
         uint32 sigsize;
         packet >> sigsize;
+        uint8 capabilities = 0;
         if (pubkey == nullptr) {
             connection.AuthStatus = NETWORK_AUTH_VERIFICATIONFAILURE;
         } else {
@@ -1890,6 +2137,7 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
                 {
                     throw std::runtime_error("Failed to read packet.");
                 }
+                packet >> capabilities;
 
                 auto ms = MemoryStream(pubkey, strlen(pubkey));
                 if (!connection.Key.LoadPublic(&ms))
@@ -1950,6 +2198,7 @@ void Network::Server_Handle_AUTH(NetworkConnection& connection, NetworkPacket& p
         } else
         if (connection.AuthStatus == NETWORK_AUTH_VERIFIED) {
             connection.AuthStatus = NETWORK_AUTH_OK;
+            connection.CompressionEnabled = (capabilities & NETWORK_CAPABILITY_COMPRESSION) != 0;
             const std::string hash = connection.Key.PublicKeyHash();
             Server_Client_Joined(name, hash, connection);
         } else
@@ -2350,17 +2599,116 @@ void Network::Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& p
     if (server_srand0_tick == 0) {
         server_srand0 = srand0;
         server_srand0_tick = server_tick;
-        server_sprite_hash[0] = '\0';
-        if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+        server_checksums_valid = (flags & NETWORK_TICK_FLAG_CHECKSUMS) != 0;
+        if (server_checksums_valid)
         {
-            const char* text = packet.ReadString();
-            if (text != nullptr)
+            server_checksums.Read(packet);
+        }
+    }
+    game_commands_processed_this_tick = 0;
+}
+
+void Network::Server_Handle_CHECKSUMS(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32 tick;
+    packet >> tick;
+
+    std::string playerName = "(unknown)";
+    if (connection.Player)
+    {
+        playerName = connection.Player->Name;
+    }
+
+    auto it = std::find_if(_checksumHistory.begin(), _checksumHistory.end(), [tick](const std::unique_ptr<NetworkChecksumTree> &checksums)
+    {
+        return checksums->Tick == tick;
+    });
+    if (it == _checksumHistory.end())
+    {
+        AppendServerLog(String::StdFormat("Player %s desynchronised at tick %u, checksums are no longer available", playerName.c_str(), tick));
+        Server_Send_CHECKSUMS(connection, tick, nullptr, {}, {});
+        return;
+    }
+
+    const NetworkChecksumTree &checksums = **it;
+    std::vector<uint16> spriteBlocks;
+    std::vector<uint16> tileBlocks;
+    for (size_t i = 0; i < checksums.SpriteBlocks.size(); i++)
+    {
+        uint32 blockHash;
+        packet >> blockHash;
+        if (blockHash != checksums.SpriteBlocks[i])
+        {
+            spriteBlocks.push_back((uint16)i);
+        }
+    }
+    for (size_t i = 0; i < checksums.TileBlocks.size(); i++)
+    {
+        uint32 blockHash;
+        packet >> blockHash;
+        if (blockHash != checksums.TileBlocks[i])
+        {
+            tileBlocks.push_back((uint16)i);
+        }
+    }
+
+    std::string text = String::StdFormat("Player %s desynchronised at tick %u: %u sprite block(s) and %u tile block(s) differ",
+        playerName.c_str(), tick, (uint32)spriteBlocks.size(), (uint32)tileBlocks.size());
+    for (auto block : tileBlocks)
+    {
+        text += "\n  " + NetworkChecksumTree::DescribeTileBlock(block);
+    }
+    AppendServerLog(text);
+    Server_Send_CHECKSUMS(connection, tick, &checksums, spriteBlocks, tileBlocks);
+}
+
+void Network::Client_Handle_CHECKSUMS(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32 tick;
+    uint8 available;
+    packet >> tick >> available;
+    if (_localChecksums == nullptr || _localChecksums->Tick != tick)
+    {
+        return;
+    }
+
+    std::string text = String::StdFormat("Desynchronised at tick %u", tick);
+    if (!available)
+    {
+        text += ", the server no longer has checksums for this tick";
+    }
+    else
+    {
+        uint16 count;
+        packet >> count;
+        for (uint16 i = 0; i < count; i++)
+        {
+            uint16 block;
+            packet >> block;
+            for (size_t j = 0; j < NetworkChecksum::SPRITE_BLOCK_SIZE; j++)
+            {
+                uint32 spriteHash;
+                packet >> spriteHash;
+                size_t index = block * NetworkChecksum::SPRITE_BLOCK_SIZE + j;
+                if (index < MAX_SPRITES && spriteHash != _localChecksums->Sprites[index] && index < _localDesyncSprites.size())
+                {
+                    text += "\n  " + NetworkChecksumTree::DescribeSprite(index, &_localDesyncSprites[index]);
+                }
+            }
+        }
+        packet >> count;
+        for (uint16 i = 0; i < count; i++)
+        {
+            uint16 block;
+            packet >> block;
+            if (block < NetworkChecksum::TILE_BLOCK_COUNT)
             {
-                safe_strcpy(server_sprite_hash, text, sizeof(server_sprite_hash));
+                text += "\n  " + NetworkChecksumTree::DescribeTileBlock(block);
             }
         }
     }
-    game_commands_processed_this_tick = 0;
+    log_warning("%s", text.c_str());
+    AppendServerLog(text);
 }
 
 void Network::Client_Handle_PLAYERLIST(NetworkConnection& connection, NetworkPacket& packet)
@@ -2596,6 +2944,11 @@ uint32 network_get_server_tick()
     return gNetwork.GetServerTick();
 }
 
+void network_get_traffic_stats(NetworkTrafficStats * stats)
+{
+    *stats = gNetwork.GetTrafficStats();
+}
+
 uint8 network_get_current_player_id()
 {
     return gNetwork.GetPlayerID();
@@ -3243,6 +3596,7 @@ sint32 network_get_mode() { return NETWORK_MODE_NONE; }
 sint32 network_get_status() { return NETWORK_STATUS_NONE; }
 sint32 network_get_authstatus() { return NETWORK_AUTH_NONE; }
 uint32 network_get_server_tick() { return gCurrentTicks; }
+void network_get_traffic_stats(NetworkTrafficStats * stats) { *stats = {}; }
 void network_flush() {}
 void network_send_tick() {}
 void network_check_desynchronization() {}
@@ -0,0 +1,363 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef DISABLE_NETWORK
+
+#include <algorithm>
+#include <cstring>
+#include "../core/String.hpp"
+#include "NetworkChecksum.h"
+#include "NetworkPacket.h"
+
+using namespace NetworkChecksum;
+
+constexpr uint32 ELEMENT_TILE_NONE = UINT32_MAX;
+
+// Number of tile pointers or tile elements compared at once, most of them do not change from one tick to the next
+constexpr size_t COMPARE_CHUNK_SIZE = 64;
+static_assert(TILE_COUNT % COMPARE_CHUNK_SIZE == 0, "Tile pointers are compared in whole chunks");
+static_assert(TILE_ELEMENT_COUNT % COMPARE_CHUNK_SIZE == 0, "Tile elements are compared in whole chunks");
+
+// Sprite and tile element contents are mixed a 32-bit word at a time, which is far cheaper than the SHA1 of the
+// whole sprite pool it replaces.
+static uint32 checksum_mix(uint32 hash, uint32 value)
+{
+    value *= 0xCC9E2D51;
+    value = rol32(value, 15);
+    value *= 0x1B873593;
+    hash ^= value;
+    hash = rol32(hash, 13);
+    return hash * 5 + 0xE6546B64;
+}
+
+static uint32 checksum_finalise(uint32 hash, uint32 length)
+{
+    hash ^= length;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static bool sprite_is_checksummed(const rct_sprite * sprite)
+{
+    uint8 identifier = sprite->unknown.sprite_identifier;
+    return identifier != SPRITE_IDENTIFIER_NULL && identifier != SPRITE_IDENTIFIER_MISC;
+}
+
+static uint32 checksum_sprite(const rct_sprite * sprite)
+{
+    rct_sprite copy = *sprite;
+    copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
+
+    if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
+        // We set this to 0 because as soon the client selects a guest the window will remove the
+        // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
+        copy.peep.window_invalidate_flags = 0;
+    }
+
+    static_assert(sizeof(rct_sprite) % sizeof(uint32) == 0, "Sprites are checksummed as words");
+    const uint32 * words = (const uint32 *)&copy;
+    uint32 hash = 0;
+    for (size_t i = 0; i < sizeof(rct_sprite) / sizeof(uint32); i++)
+    {
+        hash = checksum_mix(hash, words[i]);
+    }
+    return checksum_finalise(hash, sizeof(rct_sprite));
+}
+
+void NetworkChecksumSummary::Read(NetworkPacket &packet)
+{
+    packet >> Root;
+    for (auto &spriteType : SpriteTypes)
+    {
+        packet >> spriteType;
+    }
+    packet >> Tiles;
+}
+
+void NetworkChecksumSummary::Write(NetworkPacket &packet) const
+{
+    packet << Root;
+    for (auto spriteType : SpriteTypes)
+    {
+        packet << spriteType;
+    }
+    packet << Tiles;
+}
+
+bool NetworkChecksumSummary::operator==(const NetworkChecksumSummary &other) const
+{
+    return Root == other.Root && SpriteTypes == other.SpriteTypes && Tiles == other.Tiles;
+}
+
+std::string NetworkChecksumTree::DescribeSprite(size_t index, const rct_sprite * sprite)
+{
+    const char * typeName = nullptr;
+    switch (sprite->unknown.sprite_identifier) {
+    case SPRITE_IDENTIFIER_VEHICLE: typeName = "vehicle"; break;
+    case SPRITE_IDENTIFIER_PEEP:    typeName = "peep"; break;
+    case SPRITE_IDENTIFIER_LITTER:  typeName = "litter"; break;
+    }
+    if (typeName == nullptr)
+    {
+        return String::StdFormat("sprite %u (unused)", (uint32)index);
+    }
+    return String::StdFormat("sprite %u (%s at %d,%d,%d)", (uint32)index, typeName,
+        sprite->unknown.x, sprite->unknown.y, sprite->unknown.z);
+}
+
+std::string NetworkChecksumTree::DescribeTileBlock(size_t index)
+{
+    uint32 x = (uint32)((index % TILE_BLOCKS_PER_ROW) * TILE_BLOCK_SIZE);
+    uint32 y = (uint32)((index / TILE_BLOCKS_PER_ROW) * TILE_BLOCK_SIZE);
+    return String::StdFormat("tiles %u,%u to %u,%u", x, y, x + (uint32)TILE_BLOCK_SIZE - 1, y + (uint32)TILE_BLOCK_SIZE - 1);
+}
+
+void NetworkChecksumTracker::Reset()
+{
+    _valid = false;
+}
+
+const NetworkChecksumTree & NetworkChecksumTracker::Update(uint32 tick)
+{
+    bool all = !_valid;
+    if (all)
+    {
+        Initialise();
+    }
+
+    _tree.Tick = tick;
+    UpdateSprites(all);
+    UpdateTiles(all);
+
+    uint32 rootHash = 0;
+    for (auto typeHash : _tree.Summary.SpriteTypes)
+    {
+        rootHash = checksum_mix(rootHash, typeHash);
+    }
+    rootHash = checksum_mix(rootHash, _tree.Summary.Tiles);
+    _tree.Summary.Root = checksum_finalise(rootHash, SPRITE_TYPE_COUNT + 1);
+
+    _valid = true;
+    return _tree;
+}
+
+void NetworkChecksumTracker::Initialise()
+{
+    _sprites.resize(MAX_SPRITES);
+    _spriteTypes.assign(MAX_SPRITES, SPRITE_IDENTIFIER_NULL);
+    _tilePointers.resize(TILE_COUNT);
+    _tileElements.resize(TILE_ELEMENT_COUNT);
+    _tiles.assign(TILE_COUNT, 0);
+    _elementTiles.assign(TILE_ELEMENT_COUNT, ELEMENT_TILE_NONE);
+    _dirtyTiles.assign(TILE_COUNT, false);
+    _dirtyTileList.clear();
+    _dirtyBlocks.assign(std::max(SPRITE_BLOCK_COUNT, TILE_BLOCK_COUNT), false);
+}
+
+void NetworkChecksumTracker::UpdateSprites(bool all)
+{
+    std::fill(_dirtyBlocks.begin(), _dirtyBlocks.end(), false);
+    for (size_t i = 0; i < MAX_SPRITES; i++)
+    {
+        const rct_sprite * sprite = get_sprite(i);
+        if (!all && std::memcmp(sprite, &_sprites[i], sizeof(rct_sprite)) == 0)
+        {
+            continue;
+        }
+
+        _sprites[i] = *sprite;
+        if (sprite_is_checksummed(sprite))
+        {
+            _tree.Sprites[i] = checksum_sprite(sprite);
+            _spriteTypes[i] = sprite->unknown.sprite_identifier;
+        }
+        else
+        {
+            _tree.Sprites[i] = 0;
+            _spriteTypes[i] = SPRITE_IDENTIFIER_NULL;
+        }
+        _dirtyBlocks[i / SPRITE_BLOCK_SIZE] = true;
+    }
+
+    for (size_t block = 0; block < SPRITE_BLOCK_COUNT; block++)
+    {
+        if (_dirtyBlocks[block])
+        {
+            uint32 blockHash = 0;
+            for (size_t i = block * SPRITE_BLOCK_SIZE; i < (block + 1) * SPRITE_BLOCK_SIZE; i++)
+            {
+                blockHash = checksum_mix(blockHash, _tree.Sprites[i]);
+            }
+            _tree.SpriteBlocks[block] = checksum_finalise(blockHash, SPRITE_BLOCK_SIZE);
+        }
+    }
+
+    // The hash of each type covers every sprite of that type in slot order, combining it from the slot hashes does
+    // not touch the sprites themselves
+    std::array<uint32, SPRITE_TYPE_COUNT> typeHashes = {};
+    std::array<uint32, SPRITE_TYPE_COUNT> typeLengths = {};
+    for (size_t i = 0; i < MAX_SPRITES; i++)
+    {
+        uint8 type = _spriteTypes[i];
+        if (type < SPRITE_TYPE_COUNT)
+        {
+            typeHashes[type] = checksum_mix(checksum_mix(typeHashes[type], (uint32)i), _tree.Sprites[i]);
+            typeLengths[type]++;
+        }
+    }
+    for (size_t type = 0; type < SPRITE_TYPE_COUNT; type++)
+    {
+        _tree.Summary.SpriteTypes[type] = checksum_finalise(typeHashes[type], typeLengths[type]);
+    }
+}
+
+void NetworkChecksumTracker::UpdateTiles(bool all)
+{
+    if (all)
+    {
+        std::copy(gTileElementTilePointers, gTileElementTilePointers + TILE_COUNT, _tilePointers.begin());
+        std::copy(gTileElements, gTileElements + TILE_ELEMENT_COUNT, _tileElements.begin());
+        for (size_t tileIndex = 0; tileIndex < TILE_COUNT; tileIndex++)
+        {
+            MarkTileDirty(tileIndex);
+        }
+    }
+    else
+    {
+        // Inserting an element moves the whole tile to the end of the element pool
+        for (size_t start = 0; start < TILE_COUNT; start += COMPARE_CHUNK_SIZE)
+        {
+            if (std::memcmp(&gTileElementTilePointers[start], &_tilePointers[start], COMPARE_CHUNK_SIZE * sizeof(rct_tile_element *)) == 0)
+            {
+                continue;
+            }
+            for (size_t tileIndex = start; tileIndex < start + COMPARE_CHUNK_SIZE; tileIndex++)
+            {
+                if (gTileElementTilePointers[tileIndex] != _tilePointers[tileIndex])
+                {
+                    _tilePointers[tileIndex] = gTileElementTilePointers[tileIndex];
+                    MarkTileDirty(tileIndex);
+                }
+            }
+        }
+
+        // Any other change is written to an element in place, which is hashed again as part of the tile it belonged
+        // to. A tile can only grow into the next element by clearing the last tile flag of its current last element.
+        for (size_t start = 0; start < TILE_ELEMENT_COUNT; start += COMPARE_CHUNK_SIZE)
+        {
+            if (std::memcmp(&gTileElements[start], &_tileElements[start], COMPARE_CHUNK_SIZE * sizeof(rct_tile_element)) == 0)
+            {
+                continue;
+            }
+            for (size_t elementIndex = start; elementIndex < start + COMPARE_CHUNK_SIZE; elementIndex++)
+            {
+                if (std::memcmp(&gTileElements[elementIndex], &_tileElements[elementIndex], sizeof(rct_tile_element)) != 0)
+                {
+                    _tileElements[elementIndex] = gTileElements[elementIndex];
+                    if (_elementTiles[elementIndex] != ELEMENT_TILE_NONE)
+                    {
+                        MarkTileDirty(_elementTiles[elementIndex]);
+                    }
+                }
+            }
+        }
+    }
+
+    std::fill(_dirtyBlocks.begin(), _dirtyBlocks.end(), false);
+    for (size_t tileIndex : _dirtyTileList)
+    {
+        _tiles[tileIndex] = HashTile(tileIndex);
+        _dirtyTiles[tileIndex] = false;
+
+        size_t x = tileIndex % MAXIMUM_MAP_SIZE_TECHNICAL;
+        size_t y = tileIndex / MAXIMUM_MAP_SIZE_TECHNICAL;
+        _dirtyBlocks[(x / TILE_BLOCK_SIZE) + (y / TILE_BLOCK_SIZE) * TILE_BLOCKS_PER_ROW] = true;
+    }
+    _dirtyTileList.clear();
+
+    uint32 tilesHash = 0;
+    for (size_t block = 0; block < TILE_BLOCK_COUNT; block++)
+    {
+        if (_dirtyBlocks[block])
+        {
+            size_t blockX = (block % TILE_BLOCKS_PER_ROW) * TILE_BLOCK_SIZE;
+            size_t blockY = (block / TILE_BLOCKS_PER_ROW) * TILE_BLOCK_SIZE;
+            uint32 blockHash = 0;
+            for (size_t y = blockY; y < blockY + TILE_BLOCK_SIZE; y++)
+            {
+                for (size_t x = blockX; x < blockX + TILE_BLOCK_SIZE; x++)
+                {
+                    blockHash = checksum_mix(blockHash, _tiles[x + y * MAXIMUM_MAP_SIZE_TECHNICAL]);
+                }
+            }
+            _tree.TileBlocks[block] = checksum_finalise(blockHash, TILE_BLOCK_SIZE * TILE_BLOCK_SIZE);
+        }
+        tilesHash = checksum_mix(tilesHash, _tree.TileBlocks[block]);
+    }
+    _tree.Summary.Tiles = checksum_finalise(tilesHash, TILE_BLOCK_COUNT);
+}
+
+void NetworkChecksumTracker::MarkTileDirty(size_t tileIndex)
+{
+    if (!_dirtyTiles[tileIndex])
+    {
+        _dirtyTiles[tileIndex] = true;
+        _dirtyTileList.push_back(tileIndex);
+    }
+}
+
+uint32 NetworkChecksumTracker::HashTile(size_t tileIndex)
+{
+    const rct_tile_element * tileElement = gTileElementTilePointers[tileIndex];
+    if (tileElement == TILE_UNDEFINED_TILE_ELEMENT)
+    {
+        return 0;
+    }
+
+    uint32 hash = 0;
+    uint32 length = 0;
+    do
+    {
+        // Claim the element, so that a change to it is hashed again as part of this tile
+        size_t elementIndex = (size_t)(tileElement - gTileElements);
+        if (elementIndex < TILE_ELEMENT_COUNT)
+        {
+            _elementTiles[elementIndex] = (uint32)tileIndex;
+        }
+
+        // Ghosts only exist on the client placing them, and removing one can move the last tile flag
+        if (tileElement->flags & TILE_ELEMENT_FLAG_GHOST)
+        {
+            continue;
+        }
+        rct_tile_element copy = *tileElement;
+        copy.type &= ~TILE_ELEMENT_TYPE_FLAG_HIGHLIGHT;
+        copy.flags &= ~TILE_ELEMENT_FLAG_LAST_TILE;
+
+        const uint32 * words = (const uint32 *)&copy;
+        hash = checksum_mix(hash, words[0]);
+        hash = checksum_mix(hash, words[1]);
+        length += sizeof(rct_tile_element);
+    }
+    while (!tile_element_is_last_for_tile(tileElement++));
+    return checksum_finalise(hash, length);
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,128 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#ifndef DISABLE_NETWORK
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "../common.h"
+#include "../world/Map.h"
+#include "../world/Sprite.h"
+
+class NetworkPacket;
+
+namespace NetworkChecksum
+{
+    constexpr size_t SPRITE_BLOCK_SIZE      = 100;
+    constexpr size_t SPRITE_BLOCK_COUNT     = MAX_SPRITES / SPRITE_BLOCK_SIZE;
+    constexpr size_t SPRITE_TYPE_COUNT      = SPRITE_IDENTIFIER_LITTER + 1;
+    constexpr size_t TILE_BLOCK_SIZE        = 8;
+    constexpr size_t TILE_BLOCKS_PER_ROW    = MAXIMUM_MAP_SIZE_TECHNICAL / TILE_BLOCK_SIZE;
+    constexpr size_t TILE_BLOCK_COUNT       = TILE_BLOCKS_PER_ROW * TILE_BLOCKS_PER_ROW;
+    constexpr size_t TILE_COUNT             = MAX_TILE_TILE_ELEMENT_POINTERS;
+    // Length of gTileElements
+    constexpr size_t TILE_ELEMENT_COUNT     = MAX_TILE_TILE_ELEMENT_POINTERS * 3;
+}
+
+/**
+ * The top of the checksum tree, small enough to be sent with every tick.
+ */
+struct NetworkChecksumSummary
+{
+    uint32                                                  Root = 0;
+    std::array<uint32, NetworkChecksum::SPRITE_TYPE_COUNT>  SpriteTypes = {};
+    uint32                                                  Tiles = 0;
+
+    void Read(NetworkPacket &packet);
+    void Write(NetworkPacket &packet) const;
+
+    bool operator==(const NetworkChecksumSummary &other) const;
+    bool operator!=(const NetworkChecksumSummary &other) const { return !(*this == other); }
+};
+
+/**
+ * Checksums of the game state for a single tick. The sprite slots are hashed individually and combined per block of
+ * slots and per sprite type, the tiles are hashed individually and combined per block of tiles. When the summaries of
+ * the server and a client differ, the blocks and then the individual sprites are compared to find out what diverged.
+ */
+class NetworkChecksumTree final
+{
+public:
+    uint32                                                      Tick = 0;
+    NetworkChecksumSummary                                      Summary;
+    std::array<uint32, NetworkChecksum::SPRITE_BLOCK_COUNT>     SpriteBlocks = {};
+    std::array<uint32, MAX_SPRITES>                             Sprites = {};
+    std::array<uint32, NetworkChecksum::TILE_BLOCK_COUNT>       TileBlocks = {};
+
+    static std::string DescribeSprite(size_t index, const rct_sprite * sprite);
+    static std::string DescribeTileBlock(size_t index);
+};
+
+/**
+ * Keeps a checksum tree up to date from one tick to the next. Sprites and tile elements are written directly all over
+ * the game, so rather than relying on every writer to report its changes, they are compared with a copy taken at the
+ * previous update and only the sprite slots and tiles that changed are hashed again. Only the blocks containing them
+ * are combined again, the per type and root hashes are then combined from the block and slot hashes.
+ */
+class NetworkChecksumTracker final
+{
+private:
+    NetworkChecksumTree                 _tree;
+    bool                                _valid = false;
+
+    // Game state as it was at the previous update
+    std::vector<rct_sprite>             _sprites;
+    std::vector<rct_tile_element *>     _tilePointers;
+    std::vector<rct_tile_element>       _tileElements;
+
+    // Checksummed sprite type of each slot, or SPRITE_IDENTIFIER_NULL
+    std::vector<uint8>                  _spriteTypes;
+    std::vector<uint32>                 _tiles;
+    // The tile each element belonged to when that tile was last hashed
+    std::vector<uint32>                 _elementTiles;
+
+    std::vector<bool>                   _dirtyTiles;
+    std::vector<size_t>                 _dirtyTileList;
+    std::vector<bool>                   _dirtyBlocks;
+
+public:
+    /**
+     * Hashes the whole game state again on the next update, for when it has been replaced.
+     */
+    void Reset();
+
+    /**
+     * Brings the tree up to date with the current game state.
+     */
+    const NetworkChecksumTree & Update(uint32 tick);
+
+private:
+    void Initialise();
+    void UpdateSprites(bool all);
+    void UpdateTiles(bool all);
+    void MarkTileDirty(size_t tileIndex);
+    uint32 HashTile(size_t tileIndex);
+};
+
+#endif // DISABLE_NETWORK
+
+#endif // __cplusplus
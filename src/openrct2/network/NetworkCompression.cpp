@@ -0,0 +1,146 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef DISABLE_NETWORK
+
+#include "zlib.h"
+#include "../core/Guard.hpp"
+#include "../Game.h"
+#include "NetworkCompression.h"
+#include "NetworkTypes.h"
+
+// Raw deflate, so batches carry no zlib header or checksum; TCP already guarantees integrity
+constexpr sint32 NETWORK_COMPRESSION_WINDOW_BITS = -15;
+
+/**
+ * Builds the dictionary both ends prime every batch with. It is made of packets as they appear in a batch: a size
+ * followed by a command and the mostly zero arguments that follow it. Game commands come last as deflate finds the
+ * end of the dictionary cheapest to refer to.
+ */
+static std::vector<uint8> CreateDictionary()
+{
+    std::vector<uint8> dictionary;
+    auto writeUInt32 = [&dictionary](uint32 value) -> void
+    {
+        for (sint32 shift = 24; shift >= 0; shift -= 8)
+        {
+            dictionary.push_back((value >> shift) & 0xFF);
+        }
+    };
+    auto writePacket = [&dictionary, &writeUInt32](uint32 command, const std::vector<uint32> &arguments, size_t extraBytes) -> void
+    {
+        uint16 size = (uint16)(sizeof(uint32) + (arguments.size() * sizeof(uint32)) + extraBytes);
+        dictionary.push_back(size >> 8);
+        dictionary.push_back(size & 0xFF);
+        writeUInt32(command);
+        for (uint32 value : arguments)
+        {
+            writeUInt32(value);
+        }
+        dictionary.insert(dictionary.end(), extraBytes, 0);
+    };
+
+    for (uint32 command = 0; command < NETWORK_COMMAND_MAX; command++)
+    {
+        writePacket(command, { 0, 0 }, 8);
+    }
+    writePacket(NETWORK_COMMAND_TICK, { 0, 0, 0 }, 0);
+    writePacket(NETWORK_COMMAND_GAME_ACTION, { 0, 0 }, 16);
+    writePacket(NETWORK_COMMAND_GAMECMD, { 0, 0, GAME_COMMAND_FLAG_NETWORKED, 0, 0, 0, 0, 0 }, 2);
+    writePacket(NETWORK_COMMAND_GAMECMD, { 0, 0, GAME_COMMAND_FLAG_NETWORKED | GAME_COMMAND_FLAG_APPLY, 0, 0, 0, 0, 0 }, 2);
+    return dictionary;
+}
+
+static const std::vector<uint8> &GetDictionary()
+{
+    // Used from both the game and network threads, so relies on thread safe initialisation of statics
+    static const std::vector<uint8> dictionary = CreateDictionary();
+    return dictionary;
+}
+
+NetworkCompressor::NetworkCompressor()
+{
+    _stream = new z_stream();
+    sint32 result = deflateInit2(_stream, Z_BEST_SPEED, Z_DEFLATED, NETWORK_COMPRESSION_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY);
+    Guard::Assert(result == Z_OK, "deflateInit2 failed: %d", result);
+}
+
+NetworkCompressor::~NetworkCompressor()
+{
+    deflateEnd(_stream);
+    delete _stream;
+}
+
+bool NetworkCompressor::Compress(const uint8 * data, size_t size, std::vector<uint8> &output)
+{
+    const auto &dictionary = GetDictionary();
+    if (deflateReset(_stream) != Z_OK ||
+        deflateSetDictionary(_stream, dictionary.data(), (uInt)dictionary.size()) != Z_OK)
+    {
+        return false;
+    }
+
+    // Anything that does not fit in the input size is no smaller than the input, so not worth sending
+    output.resize(size);
+    _stream->next_in = (Bytef *)data;
+    _stream->avail_in = (uInt)size;
+    _stream->next_out = output.data();
+    _stream->avail_out = (uInt)output.size();
+    if (deflate(_stream, Z_FINISH) != Z_STREAM_END)
+    {
+        return false;
+    }
+    output.resize(output.size() - _stream->avail_out);
+    return true;
+}
+
+NetworkDecompressor::NetworkDecompressor()
+{
+    _stream = new z_stream();
+    sint32 result = inflateInit2(_stream, NETWORK_COMPRESSION_WINDOW_BITS);
+    Guard::Assert(result == Z_OK, "inflateInit2 failed: %d", result);
+}
+
+NetworkDecompressor::~NetworkDecompressor()
+{
+    inflateEnd(_stream);
+    delete _stream;
+}
+
+bool NetworkDecompressor::Decompress(const uint8 * data, size_t size, size_t uncompressedSize, std::vector<uint8> &output)
+{
+    if (uncompressedSize > NETWORK_COMPRESSION_MAX_BATCH_SIZE)
+    {
+        return false;
+    }
+
+    // Raw inflate takes the dictionary up front rather than asking for it
+    const auto &dictionary = GetDictionary();
+    if (inflateReset(_stream) != Z_OK ||
+        inflateSetDictionary(_stream, dictionary.data(), (uInt)dictionary.size()) != Z_OK)
+    {
+        return false;
+    }
+
+    output.resize(uncompressedSize);
+    _stream->next_in = (Bytef *)data;
+    _stream->avail_in = (uInt)size;
+    _stream->next_out = output.data();
+    _stream->avail_out = (uInt)output.size();
+    return inflate(_stream, Z_FINISH) == Z_STREAM_END && _stream->avail_out == 0 && _stream->avail_in == 0;
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,66 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#include <vector>
+#include "../common.h"
+
+typedef struct z_stream_s z_stream;
+
+// Batches of queued packets smaller than this are not worth compressing
+constexpr size_t NETWORK_COMPRESSION_THRESHOLD = 128;
+
+// Upper limit on the uncompressed size of a batch, so compressed packets always fit and cannot inflate to anything huge
+constexpr size_t NETWORK_COMPRESSION_MAX_BATCH_SIZE = 32 * 1024;
+
+/**
+ * Compresses batches of packets for a single connection. Every batch is an independent raw deflate stream primed with
+ * a dictionary known to both ends, so even short bursts of game commands compress well.
+ */
+class NetworkCompressor final
+{
+private:
+    z_stream * _stream = nullptr;
+
+public:
+    NetworkCompressor();
+    ~NetworkCompressor();
+
+    /**
+     * Compresses the given data, returning false if it fails or would not get any smaller.
+     */
+    bool Compress(const uint8 * data, size_t size, std::vector<uint8> &output);
+};
+
+/**
+ * Decompresses batches written by NetworkCompressor.
+ */
+class NetworkDecompressor final
+{
+private:
+    z_stream * _stream = nullptr;
+
+public:
+    NetworkDecompressor();
+    ~NetworkDecompressor();
+
+    bool Decompress(const uint8 * data, size_t size, size_t uncompressedSize, std::vector<uint8> &output);
+};
+
+#endif // DISABLE_NETWORK
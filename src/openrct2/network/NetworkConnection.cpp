@@ -16,6 +16,8 @@
 
 #ifndef DISABLE_NETWORK
 
+#include <algorithm>
+#include <cstring>
 #include "network.h"
 #include "NetworkConnection.h"
 #include "../core/String.hpp"
@@ -24,6 +26,14 @@
 #include "../platform/platform.h"
 
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
+constexpr size_t NETWORK_RECEIVE_BUFFER_SIZE = 16 * 1024;
+
+static uint32 ReadUInt32(const uint8 * data)
+{
+    uint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
 
 NetworkConnection::NetworkConnection()
 {
@@ -38,70 +48,160 @@ NetworkConnection::~NetworkConnection()
 
 sint32 NetworkConnection::ReadPacket()
 {
-    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Size))
+    if (IsReceiveClosed())
+    {
+        return NETWORK_READPACKET_DISCONNECTED;
+    }
+
+    // Packets already in the receive buffer are handed out before the socket is read again, so a single read can
+    // deliver many packets
+    sint32 status = ParsePacket(InboundPacket);
+    if (status == NETWORK_READPACKET_MORE_DATA)
     {
-        // read packet size
-        void * buffer = &((char*)&InboundPacket.Size)[InboundPacket.BytesTransferred];
-        size_t bufferLength = sizeof(InboundPacket.Size) - InboundPacket.BytesTransferred;
-        size_t readBytes;
-        NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
-        if (status != NETWORK_READPACKET_SUCCESS)
+        status = ReceiveData();
+        if (status == NETWORK_READPACKET_SUCCESS)
         {
-            return status;
+            status = ParsePacket(InboundPacket);
         }
+    }
+    if (status == NETWORK_READPACKET_SUCCESS)
+    {
+        _lastPacketTime = platform_get_ticks();
+    }
+    return status;
+}
+
+void NetworkConnection::ReceivePackets()
+{
+    if (_receiveClosed.load(std::memory_order_relaxed))
+    {
+        return;
+    }
 
-        InboundPacket.BytesTransferred += readBytes;
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size))
+    sint32 status = ReceiveData();
+    std::unique_ptr<NetworkPacket> packet;
+    while (status == NETWORK_READPACKET_SUCCESS)
+    {
+        if (packet == nullptr)
         {
-            InboundPacket.Size = Convert::NetworkToHost(InboundPacket.Size);
-            if (InboundPacket.Size == 0) // Can't have a size 0 packet
-            {
-                return NETWORK_READPACKET_DISCONNECTED;
-            }
-            InboundPacket.Data->resize(InboundPacket.Size);
+            packet = NetworkPacket::Allocate();
+        }
+        status = ParsePacket(*packet);
+        if (status == NETWORK_READPACKET_SUCCESS)
+        {
+            _receivedPackets.Push(std::move(packet));
         }
     }
-    else
+    if (status == NETWORK_READPACKET_DISCONNECTED)
     {
-        // read packet data
-        if (InboundPacket.Data->capacity() > 0)
-        {
-            void * buffer = &InboundPacket.GetData()[InboundPacket.BytesTransferred - sizeof(InboundPacket.Size)];
-            size_t bufferLength = sizeof(InboundPacket.Size) + InboundPacket.Size - InboundPacket.BytesTransferred;
-            size_t readBytes;
-            NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
-            if (status != NETWORK_READPACKET_SUCCESS)
-            {
-                return status;
-            }
+        _receiveClosed.store(true, std::memory_order_release);
+    }
+}
 
-            InboundPacket.BytesTransferred += readBytes;
-        }
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size) + InboundPacket.Size)
+bool NetworkConnection::PopReceivedPacket(std::unique_ptr<NetworkPacket> &packet)
+{
+    if (_receivedPackets.TryPop(packet))
+    {
+        _lastPacketTime = platform_get_ticks();
+        return true;
+    }
+    return false;
+}
+
+bool NetworkConnection::IsReceiveClosed() const
+{
+    return _receiveClosed.load(std::memory_order_acquire);
+}
+
+void NetworkConnection::CloseReceive()
+{
+    _receiveClosed.store(true, std::memory_order_release);
+}
+
+sint32 NetworkConnection::ReceiveData()
+{
+    // Move the incomplete packet at the end of the buffer to the front, and make sure the whole of it fits
+    size_t pending = _receiveBufferEnd - _receiveBufferStart;
+    if (_receiveBufferStart > 0)
+    {
+        if (pending > 0)
         {
-            _lastPacketTime = platform_get_ticks();
-            return NETWORK_READPACKET_SUCCESS;
+            std::memmove(_receiveBuffer.data(), &_receiveBuffer[_receiveBufferStart], pending);
         }
+        _decompressedEnd = _decompressedEnd > _receiveBufferStart ? _decompressedEnd - _receiveBufferStart : 0;
+        _receiveBufferStart = 0;
+        _receiveBufferEnd = pending;
+    }
+    size_t requiredSize = NETWORK_RECEIVE_BUFFER_SIZE;
+    if (pending >= sizeof(uint16))
+    {
+        uint16 packetSize;
+        std::memcpy(&packetSize, _receiveBuffer.data(), sizeof(packetSize));
+        requiredSize = std::max(requiredSize, sizeof(packetSize) + Convert::NetworkToHost(packetSize));
+    }
+    if (_receiveBuffer.size() < requiredSize)
+    {
+        _receiveBuffer.resize(requiredSize);
+    }
+
+    size_t readBytes;
+    NETWORK_READPACKET status = Socket->ReceiveData(
+        &_receiveBuffer[_receiveBufferEnd], _receiveBuffer.size() - _receiveBufferEnd, &readBytes);
+    if (status == NETWORK_READPACKET_SUCCESS)
+    {
+        _receiveBufferEnd += readBytes;
     }
-    return NETWORK_READPACKET_MORE_DATA;
+    return status;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+sint32 NetworkConnection::ParsePacket(NetworkPacket &packet)
 {
-    uint16 sizen = Convert::HostToNetwork(packet.Size);
-    std::vector<uint8> tosend;
-    tosend.reserve(sizeof(sizen) + packet.Size);
-    tosend.insert(tosend.end(), (uint8*)&sizen, (uint8*)&sizen + sizeof(sizen));
-    tosend.insert(tosend.end(), packet.Data->begin(), packet.Data->end());
+    size_t pending = _receiveBufferEnd - _receiveBufferStart;
+    uint16 packetSize;
+    if (pending < sizeof(packetSize))
+    {
+        return NETWORK_READPACKET_MORE_DATA;
+    }
+    std::memcpy(&packetSize, &_receiveBuffer[_receiveBufferStart], sizeof(packetSize));
+    packetSize = Convert::NetworkToHost(packetSize);
+    if (packetSize == 0) // Can't have a size 0 packet
+    {
+        return NETWORK_READPACKET_DISCONNECTED;
+    }
+    bool fromBatch = _receiveBufferStart < _decompressedEnd;
+    if (fromBatch && _receiveBufferStart + sizeof(packetSize) + packetSize > _decompressedEnd)
+    {
+        // The last packet of a batch can not run on into whatever was received after it
+        return NETWORK_READPACKET_DISCONNECTED;
+    }
+    if (pending < sizeof(packetSize) + packetSize)
+    {
+        return NETWORK_READPACKET_MORE_DATA;
+    }
 
-    const void * buffer = &tosend[packet.BytesTransferred];
-    size_t bufferSize = tosend.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer, bufferSize);
-    if (sent > 0)
+    // Packets unpacked from a compressed batch were already counted as part of it
+    const uint8 * data = &_receiveBuffer[_receiveBufferStart + sizeof(packetSize)];
+    if (!fromBatch)
+    {
+        _bytesReceived.fetch_add(sizeof(packetSize) + packetSize, std::memory_order_relaxed);
+    }
+    if (packetSize >= sizeof(uint32) && ByteSwapBE(ReadUInt32(data)) == NETWORK_COMMAND_COMPRESSED)
     {
-        packet.BytesTransferred += sent;
+        // Batches can not be nested, and are only accepted once compression has been agreed
+        if (fromBatch || !CompressionEnabled || !DecompressPacket(data, packetSize))
+        {
+            return NETWORK_READPACKET_DISCONNECTED;
+        }
+        return ParsePacket(packet);
     }
-    return packet.BytesTransferred == tosend.size();
+    _bytesReceivedUncompressed.fetch_add(sizeof(packetSize) + packetSize, std::memory_order_relaxed);
+
+    packet.Size = packetSize;
+    packet.Data->assign(data, data + packetSize);
+    packet.BytesTransferred = sizeof(packetSize) + packetSize;
+    packet.BytesRead = 0;
+    _receiveBufferStart += sizeof(packetSize) + packetSize;
+    return NETWORK_READPACKET_SUCCESS;
 }
 
 void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front)
@@ -109,14 +209,16 @@ void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool
     if (AuthStatus == NETWORK_AUTH_OK || !packet->CommandRequiresAuth())
     {
         packet->Size = (uint16)packet->Data->size();
-        if (front)
+        if (_holdPackets && packet->GetCommand() != NETWORK_COMMAND_MAP)
+        {
+            _heldPackets.push_back(std::move(packet));
+        }
+        else if (front)
         {
             // If the first packet was already partially sent add new packet to second position
             if (!_outboundPackets.empty() && _outboundPackets.front()->BytesTransferred > 0)
             {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(_outboundPackets.begin() + 1, std::move(packet));
             }
             else
             {
@@ -130,12 +232,289 @@ void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool
     }
 }
 
-void NetworkConnection::SendQueuedPackets()
+bool NetworkConnection::DecompressPacket(const uint8 * data, size_t size)
+{
+    // A compressed packet holds the uncompressed size and the deflated batch, which is a run of packets each
+    // preceded by its size. The batch takes the place of the packet in the receive buffer, so they are read as
+    // though they had arrived uncompressed.
+    if (size < sizeof(uint32) * 2)
+    {
+        return false;
+    }
+    uint32 uncompressedSize = ByteSwapBE(ReadUInt32(data + sizeof(uint32)));
+    if (_decompressor == nullptr)
+    {
+        _decompressor = std::make_unique<NetworkDecompressor>();
+    }
+    if (!_decompressor->Decompress(data + sizeof(uint32) * 2, size - sizeof(uint32) * 2, uncompressedSize, _decompressionBuffer))
+    {
+        log_warning("Received a compressed packet that could not be decompressed.");
+        return false;
+    }
+
+    size_t packetEnd = _receiveBufferStart + sizeof(uint16) + size;
+    size_t remaining = _receiveBufferEnd - packetEnd;
+    size_t newEnd = _receiveBufferStart + uncompressedSize + remaining;
+    if (_receiveBuffer.size() < newEnd)
+    {
+        _receiveBuffer.resize(newEnd);
+    }
+    std::memmove(&_receiveBuffer[_receiveBufferStart + uncompressedSize], &_receiveBuffer[packetEnd], remaining);
+    std::memcpy(&_receiveBuffer[_receiveBufferStart], _decompressionBuffer.data(), uncompressedSize);
+    _receiveBufferEnd = newEnd;
+    _decompressedEnd = _receiveBufferStart + uncompressedSize;
+    return true;
+}
+
+void NetworkConnection::CompressQueuedPackets(NetworkCompressionCache * cache)
+{
+    // Replace runs of queued packets that have not started sending with a compressed batch of them. Game commands
+    // are far too small to compress one at a time, but a tick's worth of them compresses well.
+    size_t i = 0;
+    if (!_outboundPackets.empty() && _outboundPackets.front()->BytesTransferred > 0)
+    {
+        i = 1;
+    }
+    while (i < _outboundPackets.size())
+    {
+        size_t end = i;
+        size_t batchSize = 0;
+        while (end < _outboundPackets.size())
+        {
+            NetworkPacket &packet = *_outboundPackets[end];
+            uint32 command = packet.GetCommand();
+            if (command == NETWORK_COMMAND_MAP || command == NETWORK_COMMAND_COMPRESSED ||
+                batchSize + sizeof(packet.Size) + packet.Size > NETWORK_COMPRESSION_MAX_BATCH_SIZE)
+            {
+                // Map chunks are already compressed
+                break;
+            }
+            batchSize += sizeof(packet.Size) + packet.Size;
+            end++;
+        }
+        if (end == i)
+        {
+            i++;
+            continue;
+        }
+        if (batchSize < NETWORK_COMPRESSION_THRESHOLD)
+        {
+            i = end;
+            continue;
+        }
+
+        std::unique_ptr<NetworkPacket> compressed;
+        NetworkCompressionCache::Entry * entry = cache != nullptr ? cache->Find(_outboundPackets, i, end) : nullptr;
+        if (entry != nullptr)
+        {
+            if (entry->Compressed != nullptr)
+            {
+                compressed = NetworkPacket::Duplicate(*entry->Compressed);
+            }
+        }
+        else
+        {
+            compressed = CompressBatch(i, end, batchSize);
+            if (cache != nullptr)
+            {
+                cache->Add(_outboundPackets, i, end, compressed.get());
+            }
+        }
+
+        if (compressed != nullptr)
+        {
+            _outboundPackets.erase(_outboundPackets.begin() + i, _outboundPackets.begin() + end);
+            _outboundPackets.insert(_outboundPackets.begin() + i, std::move(compressed));
+            i++;
+        }
+        else
+        {
+            i = end;
+        }
+    }
+}
+
+std::unique_ptr<NetworkPacket> NetworkConnection::CompressBatch(size_t begin, size_t end, size_t batchSize)
+{
+    std::vector<uint8> batch;
+    batch.reserve(batchSize);
+    for (size_t i = begin; i < end; i++)
+    {
+        NetworkPacket &packet = *_outboundPackets[i];
+        uint16 size = Convert::HostToNetwork(packet.Size);
+        batch.insert(batch.end(), (const uint8 *)&size, (const uint8 *)&size + sizeof(size));
+        batch.insert(batch.end(), packet.GetData(), packet.GetData() + packet.Size);
+    }
+
+    if (_compressor == nullptr)
+    {
+        _compressor = std::make_unique<NetworkCompressor>();
+    }
+    if (!_compressor->Compress(batch.data(), batch.size(), _compressionBuffer) ||
+        _compressionBuffer.size() + sizeof(uint32) * 2 >= batch.size())
+    {
+        return nullptr;
+    }
+
+    auto packet = NetworkPacket::Allocate();
+    *packet << (uint32)NETWORK_COMMAND_COMPRESSED << (uint32)batch.size();
+    packet->Write(_compressionBuffer.data(), _compressionBuffer.size());
+    packet->Size = (uint16)packet->Data->size();
+    return packet;
+}
+
+NetworkCompressionCache::Entry * NetworkCompressionCache::Find(
+    const std::deque<std::unique_ptr<NetworkPacket>> &packets, size_t begin, size_t end)
+{
+    for (auto &entry : _entries)
+    {
+        if (entry.Packets.size() == end - begin &&
+            std::equal(entry.Packets.begin(), entry.Packets.end(), packets.begin() + begin,
+                [](const std::shared_ptr<std::vector<uint8>> &data, const std::unique_ptr<NetworkPacket> &packet)
+                {
+                    return data == packet->Data;
+                }))
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void NetworkCompressionCache::Add(
+    const std::deque<std::unique_ptr<NetworkPacket>> &packets, size_t begin, size_t end, NetworkPacket * compressed)
+{
+    // Only batches of shared broadcast data can ever match another connection's
+    if (std::none_of(packets.begin() + begin, packets.begin() + end,
+        [](const std::unique_ptr<NetworkPacket> &packet) { return packet->Data.use_count() > 1; }))
+    {
+        return;
+    }
+
+    Entry entry;
+    for (size_t i = begin; i < end; i++)
+    {
+        entry.Packets.push_back(packets[i]->Data);
+    }
+    if (compressed != nullptr)
+    {
+        entry.Compressed = NetworkPacket::Duplicate(*compressed);
+    }
+    _entries.push_back(std::move(entry));
+}
+
+void NetworkConnection::SendQueuedPackets(NetworkCompressionCache * compressionCache)
+{
+    if (IsReceiveClosed())
+    {
+        return;
+    }
+    if (CompressionEnabled)
+    {
+        CompressQueuedPackets(compressionCache);
+    }
+
+    // Gather as many queued packets as possible into each send, every packet being its size followed by its data.
+    // The data of broadcast packets is shared between connections, so nothing is copied here.
+    constexpr size_t MAX_PACKETS_PER_SEND = 64;
+    while (!_outboundPackets.empty())
+    {
+        uint16 sizes[MAX_PACKETS_PER_SEND];
+        SocketBuffer buffers[MAX_PACKETS_PER_SEND * 2];
+        size_t numBuffers = 0;
+        size_t totalSize = 0;
+        size_t numPackets = std::min<size_t>(MAX_PACKETS_PER_SEND, _outboundPackets.size());
+        for (size_t i = 0; i < numPackets; i++)
+        {
+            NetworkPacket &packet = *_outboundPackets[i];
+            sizes[i] = Convert::HostToNetwork(packet.Size);
+
+            // Only the first packet can have been partially sent already
+            size_t offset = packet.BytesTransferred;
+            if (offset < sizeof(sizes[i]))
+            {
+                buffers[numBuffers++] = { (const uint8 *)&sizes[i] + offset, sizeof(sizes[i]) - offset };
+                offset = 0;
+            }
+            else
+            {
+                offset -= sizeof(sizes[i]);
+            }
+            buffers[numBuffers++] = { packet.GetData() + offset, packet.Size - offset };
+            totalSize += sizeof(sizes[i]) + packet.Size - packet.BytesTransferred;
+        }
+
+        size_t sent;
+        try
+        {
+            sent = Socket->SendData(buffers, numBuffers);
+        }
+        catch (const std::exception &ex)
+        {
+            // Nothing more can be sent, so treat the connection as closed like a failed receive
+            log_warning("Closing connection after failing to send: %s", ex.what());
+            _outboundPackets.clear();
+            CloseReceive();
+            break;
+        }
+        size_t remaining = sent;
+        while (remaining > 0)
+        {
+            NetworkPacket &packet = *_outboundPackets.front();
+            size_t packetRemaining = sizeof(packet.Size) + packet.Size - packet.BytesTransferred;
+            if (remaining >= packetRemaining)
+            {
+                remaining -= packetRemaining;
+                size_t wireSize = sizeof(packet.Size) + packet.Size;
+                size_t uncompressedSize = wireSize;
+                if (packet.GetCommand() == NETWORK_COMMAND_COMPRESSED)
+                {
+                    uncompressedSize = ByteSwapBE(ReadUInt32(packet.GetData() + sizeof(uint32)));
+                }
+                _bytesSent.fetch_add(wireSize, std::memory_order_relaxed);
+                _bytesSentUncompressed.fetch_add(uncompressedSize, std::memory_order_relaxed);
+                _outboundPackets.pop_front();
+            }
+            else
+            {
+                packet.BytesTransferred += remaining;
+                remaining = 0;
+            }
+        }
+
+        if (sent < totalSize)
+        {
+            // Socket buffer is full, try again next update
+            break;
+        }
+    }
+}
+
+void NetworkConnection::HoldPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(*_outboundPackets.front()))
+    // Everything but the map is kept back until the map has been queued, otherwise the client would
+    // receive game commands for a state it has not loaded yet.
+    _holdPackets = true;
+}
+
+void NetworkConnection::ReleaseHeldPackets()
+{
+    _holdPackets = false;
+    for (auto &packet : _heldPackets)
     {
-        _outboundPackets.remove(_outboundPackets.front());
+        _outboundPackets.push_back(std::move(packet));
     }
+    _heldPackets.clear();
+}
+
+NetworkTrafficStats NetworkConnection::GetTrafficStats() const
+{
+    NetworkTrafficStats stats;
+    stats.BytesSent = _bytesSent.load(std::memory_order_relaxed);
+    stats.BytesSentUncompressed = _bytesSentUncompressed.load(std::memory_order_relaxed);
+    stats.BytesReceived = _bytesReceived.load(std::memory_order_relaxed);
+    stats.BytesReceivedUncompressed = _bytesReceivedUncompressed.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void NetworkConnection::ResetLastPacketTime()
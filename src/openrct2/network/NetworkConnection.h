@@ -19,12 +19,15 @@
 #ifdef __cplusplus
 
 #ifndef DISABLE_NETWORK
-#include <list>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <vector>
 
 #include "../common.h"
+#include "../core/LockFreeQueue.hpp"
 
+#include "NetworkCompression.h"
 #include "NetworkTypes.h"
 #include "NetworkKey.h"
 #include "NetworkPacket.h"
@@ -33,6 +36,27 @@ interface ITcpSocket;
 class NetworkPlayer;
 struct ObjectRepositoryItem;
 
+/**
+ * Compressed batches made while flushing every connection. Connections that queued the same broadcast packets in the
+ * same order make identical batches, so each is only deflated once and the compressed data is shared between them.
+ */
+class NetworkCompressionCache final
+{
+public:
+    struct Entry
+    {
+        std::vector<std::shared_ptr<std::vector<uint8>>>    Packets;
+        std::unique_ptr<NetworkPacket>                      Compressed; // nullptr if the batch did not compress
+    };
+
+    Entry * Find(const std::deque<std::unique_ptr<NetworkPacket>> &packets, size_t begin, size_t end);
+    void Add(const std::deque<std::unique_ptr<NetworkPacket>> &packets, size_t begin, size_t end,
+             NetworkPacket * compressed);
+
+private:
+    std::vector<Entry> _entries;
+};
+
 class NetworkConnection final
 {
 public:
@@ -44,26 +68,57 @@ public:
     NetworkKey                                  Key;
     std::vector<uint8>                          Challenge;
     std::vector<const ObjectRepositoryItem *>   RequestedObjects;
+    // Set once compression has been agreed, the receive thread reads it to reject compressed packets before that
+    std::atomic<bool>                           CompressionEnabled = { false };
 
     NetworkConnection();
     ~NetworkConnection();
 
     sint32  ReadPacket();
+    void ReceivePackets();
+    bool PopReceivedPacket(std::unique_ptr<NetworkPacket> &packet);
+    bool IsReceiveClosed() const;
+    void CloseReceive();
     void QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front = false);
-    void SendQueuedPackets();
+    void SendQueuedPackets(NetworkCompressionCache * compressionCache = nullptr);
+    void HoldPackets();
+    void ReleaseHeldPackets();
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
+    NetworkTrafficStats GetTrafficStats() const;
 
     const utf8 * GetLastDisconnectReason() const;
     void SetLastDisconnectReason(const utf8 * src);
     void SetLastDisconnectReason(const rct_string_id string_id, void * args = nullptr);
 
 private:
-    std::list<std::unique_ptr<NetworkPacket>>   _outboundPackets;
+    std::vector<uint8>                          _receiveBuffer;
+    size_t                                      _receiveBufferStart     = 0;
+    size_t                                      _receiveBufferEnd       = 0;
+    size_t                                      _decompressedEnd        = 0;
+    std::unique_ptr<NetworkCompressor>          _compressor;
+    std::unique_ptr<NetworkDecompressor>        _decompressor;
+    std::vector<uint8>                          _compressionBuffer;
+    std::vector<uint8>                          _decompressionBuffer;
+    LockFreeQueue<std::unique_ptr<NetworkPacket>> _receivedPackets;
+    std::atomic<bool>                           _receiveClosed          = { false };
+    std::deque<std::unique_ptr<NetworkPacket>>  _outboundPackets;
+    std::deque<std::unique_ptr<NetworkPacket>>  _heldPackets;
+    bool                                        _holdPackets            = false;
     uint32                                      _lastPacketTime;
     utf8 *                                      _lastDisconnectReason   = nullptr;
 
-    bool SendPacket(NetworkPacket &packet);
+    // Bytes on the wire and what they would have been without compression, counting each packet's size too
+    std::atomic<uint64>                         _bytesSent                  = { 0 };
+    std::atomic<uint64>                         _bytesSentUncompressed      = { 0 };
+    std::atomic<uint64>                         _bytesReceived              = { 0 };
+    std::atomic<uint64>                         _bytesReceivedUncompressed  = { 0 };
+
+    sint32 ReceiveData();
+    sint32 ParsePacket(NetworkPacket &packet);
+    bool DecompressPacket(const uint8 * data, size_t size);
+    void CompressQueuedPackets(NetworkCompressionCache * cache);
+    std::unique_ptr<NetworkPacket> CompressBatch(size_t begin, size_t end, size_t batchSize);
 };
 
 #endif // DISABLE_NETWORK
@@ -16,9 +16,116 @@
 
 #ifndef DISABLE_NETWORK
 
+#include <mutex>
 #include "NetworkTypes.h"
 #include "NetworkPacket.h"
 
+/**
+ * Every message sent or received goes through a NetworkPacket, so both the packet objects and their data buffers are
+ * kept for reuse. Buffers are handed out with a deleter that gives them back to the pool, so a buffer shared between
+ * packets (e.g. broadcast duplicates on different threads) only returns once the last of them lets go of it.
+ */
+class NetworkPacketPool final
+{
+private:
+    static constexpr size_t MAX_POOLED_PACKETS          = 512;
+    static constexpr size_t MAX_POOLED_BUFFERS          = 512;
+    static constexpr size_t MAX_POOLED_BUFFER_CAPACITY  = 4096;
+
+    std::mutex                          _mutex;
+    std::vector<void *>                 _packets;
+    std::vector<std::vector<uint8> *>   _buffers;
+
+public:
+    static NetworkPacketPool * Get()
+    {
+        // Never destroyed, packets may outlive any other static
+        static NetworkPacketPool * pool = new NetworkPacketPool();
+        return pool;
+    }
+
+    void * AllocatePacket(size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (size == sizeof(NetworkPacket) && !_packets.empty())
+            {
+                void * ptr = _packets.back();
+                _packets.pop_back();
+                return ptr;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void FreePacket(void * ptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_packets.size() < MAX_POOLED_PACKETS)
+            {
+                _packets.push_back(ptr);
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+    std::shared_ptr<std::vector<uint8>> AllocateBuffer()
+    {
+        std::vector<uint8> * buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_buffers.empty())
+            {
+                buffer = _buffers.back();
+                _buffers.pop_back();
+            }
+        }
+        if (buffer == nullptr)
+        {
+            buffer = new std::vector<uint8>();
+        }
+        return std::shared_ptr<std::vector<uint8>>(buffer, [](std::vector<uint8> * released)
+        {
+            NetworkPacketPool::Get()->FreeBuffer(released);
+        });
+    }
+
+private:
+    void FreeBuffer(std::vector<uint8> * buffer)
+    {
+        // Only called once the last reference to the buffer has gone
+        if (buffer->capacity() <= MAX_POOLED_BUFFER_CAPACITY)
+        {
+            buffer->clear();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_buffers.size() < MAX_POOLED_BUFFERS)
+            {
+                _buffers.push_back(buffer);
+                return;
+            }
+        }
+        delete buffer;
+    }
+};
+
+NetworkPacket::NetworkPacket()
+    : Data(NetworkPacketPool::Get()->AllocateBuffer())
+{
+}
+
+void * NetworkPacket::operator new(size_t size)
+{
+    return NetworkPacketPool::Get()->AllocatePacket(size);
+}
+
+void NetworkPacket::operator delete(void * ptr)
+{
+    NetworkPacketPool::Get()->FreePacket(ptr);
+}
+
 std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
 {
     return std::unique_ptr<NetworkPacket>(new NetworkPacket); // change to make_unique in c++14
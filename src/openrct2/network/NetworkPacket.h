@@ -28,10 +28,17 @@ class NetworkPacket final
 {
 public:
     uint16                              Size = 0;
-    std::shared_ptr<std::vector<uint8>> Data = std::make_shared<std::vector<uint8>>();
+    std::shared_ptr<std::vector<uint8>> Data;
     size_t                              BytesTransferred = 0;
     size_t                              BytesRead = 0;
 
+    NetworkPacket();
+    NetworkPacket(const NetworkPacket &) = default;
+
+    // Packets are recycled through a pool rather than going back to the heap
+    static void * operator new(size_t size);
+    static void operator delete(void * ptr);
+
     static std::unique_ptr<NetworkPacket> Allocate();
     static std::unique_ptr<NetworkPacket> Duplicate(NetworkPacket& packet);
 
@@ -0,0 +1,102 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#ifndef DISABLE_NETWORK
+
+#include <exception>
+#include "NetworkConnection.h"
+#include "NetworkReceiver.h"
+
+// How long the network thread waits for data before checking whether it should stop
+constexpr sint32 NETWORK_RECEIVER_TIMEOUT_MS = 1000;
+
+constexpr size_t NETWORK_RECEIVER_MAX_EVENTS = 64;
+
+std::unique_ptr<NetworkReceiver> NetworkReceiver::Create()
+{
+    ISocketPoller * poller = CreateSocketPoller();
+    if (poller == nullptr)
+    {
+        return nullptr;
+    }
+    return std::make_unique<NetworkReceiver>(poller);
+}
+
+NetworkReceiver::NetworkReceiver(ISocketPoller * poller)
+    : _poller(poller)
+{
+    _thread = std::thread([this]() -> void { Run(); });
+}
+
+NetworkReceiver::~NetworkReceiver()
+{
+    _stopping = true;
+    _poller->Wake();
+    _thread.join();
+}
+
+void NetworkReceiver::AddConnection(NetworkConnection * connection)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _connections.insert(connection);
+    _poller->Add(connection->Socket, connection);
+}
+
+void NetworkReceiver::RemoveConnection(NetworkConnection * connection)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_connections.erase(connection) != 0)
+    {
+        _poller->Remove(connection->Socket);
+    }
+}
+
+void NetworkReceiver::Run()
+{
+    void * ready[NETWORK_RECEIVER_MAX_EVENTS];
+    while (!_stopping)
+    {
+        size_t numReady = _poller->Wait(ready, NETWORK_RECEIVER_MAX_EVENTS, NETWORK_RECEIVER_TIMEOUT_MS);
+
+        // A connection may have been removed by the game thread since the poller reported it
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i < numReady; i++)
+        {
+            auto connection = static_cast<NetworkConnection *>(ready[i]);
+            if (_connections.find(connection) != _connections.end())
+            {
+                try
+                {
+                    connection->ReceivePackets();
+                }
+                catch (const std::exception &e)
+                {
+                    // Nothing above this thread can handle it, treat the connection as closed so the game thread
+                    // disconnects it
+                    log_warning("Unable to receive from connection: %s", e.what());
+                    connection->CloseReceive();
+                }
+                if (connection->IsReceiveClosed())
+                {
+                    // Stop the poller reporting the closed socket until the game thread removes the connection
+                    _poller->Remove(connection->Socket);
+                }
+            }
+        }
+    }
+}
+
+#endif // DISABLE_NETWORK
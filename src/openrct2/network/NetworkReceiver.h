@@ -0,0 +1,65 @@
+#pragma region Copyright (c) 2014-2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "TcpSocket.h"
+
+class NetworkConnection;
+
+/**
+ * Reads from client connections on a dedicated network thread. The thread only wakes for sockets that have data,
+ * splits what it reads into packets and hands them to the game thread through each connection's received packet
+ * queue.
+ */
+class NetworkReceiver final
+{
+private:
+    std::unique_ptr<ISocketPoller>          _poller;
+    std::thread                             _thread;
+    std::mutex                              _mutex;
+    std::unordered_set<NetworkConnection *> _connections;
+    std::atomic<bool>                       _stopping = { false };
+
+public:
+    /**
+     * Creates a receiver, or returns nullptr if the platform does not support one.
+     */
+    static std::unique_ptr<NetworkReceiver> Create();
+
+    explicit NetworkReceiver(ISocketPoller * poller);
+    ~NetworkReceiver();
+
+    void AddConnection(NetworkConnection * connection);
+
+    /**
+     * Stops reading from the given connection. Once this returns the network thread no longer touches it.
+     */
+    void RemoveConnection(NetworkConnection * connection);
+
+private:
+    void Run();
+};
+
+#endif // DISABLE_NETWORK
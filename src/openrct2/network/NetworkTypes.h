@@ -52,6 +52,22 @@ enum NETWORK_COMMAND
     NETWORK_COMMAND_TOKEN,
     NETWORK_COMMAND_OBJECTS,
     NETWORK_COMMAND_GAME_ACTION,
+    NETWORK_COMMAND_CHECKSUMS,
+    NETWORK_COMMAND_COMPRESSED,
     NETWORK_COMMAND_MAX,
     NETWORK_COMMAND_INVALID = -1
 };
+
+// Optional features a client asks for when authenticating, and the server grants in its reply
+enum NETWORK_CAPABILITY
+{
+    NETWORK_CAPABILITY_COMPRESSION = 1 << 0,
+};
+
+typedef struct NetworkTrafficStats
+{
+    uint64 BytesSent;
+    uint64 BytesSentUncompressed;
+    uint64 BytesReceived;
+    uint64 BytesReceivedUncompressed;
+} NetworkTrafficStats;
@@ -16,6 +16,8 @@
 
 #ifndef DISABLE_NETWORK
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <chrono>
 #include <future>
@@ -45,7 +47,13 @@
     #include <netinet/tcp.h>
     #include <netinet/in.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <fcntl.h>
+    #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/epoll.h>
+        #include <sys/eventfd.h>
+    #endif // defined(__linux__)
     #include "../common.h"
     typedef sint32 SOCKET;
     #define SOCKET_ERROR -1
@@ -65,6 +73,9 @@
 
 constexpr auto CONNECT_TIMEOUT = std::chrono::milliseconds(3000);
 
+// Number of buffers passed to the OS in a single gathered send, well below IOV_MAX
+constexpr size_t MAX_SEND_BUFFERS = 128;
+
 #ifdef _WIN32
     static bool _wsaInitialised = false;
 #endif
@@ -80,9 +91,10 @@ public:
 class TcpSocket final : public ITcpSocket
 {
 private:
-    SOCKET_STATUS   _status         = SOCKET_STATUS_CLOSED;
-    uint16          _listeningPort  = 0;
-    SOCKET          _socket         = INVALID_SOCKET;
+    // Read by the network thread while the game thread may be closing the socket
+    std::atomic<SOCKET_STATUS>  _status         = { SOCKET_STATUS_CLOSED };
+    uint16                      _listeningPort  = 0;
+    SOCKET                      _socket         = INVALID_SOCKET;
 
     std::string         _hostName;
     std::future<void>   _connectFuture;
@@ -373,6 +385,46 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer * buffers, size_t count) override
+    {
+        if (_status != SOCKET_STATUS_CONNECTED)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        count = std::min(count, MAX_SEND_BUFFERS);
+#ifdef _WIN32
+        WSABUF wsaBuffers[MAX_SEND_BUFFERS];
+        for (size_t i = 0; i < count; i++)
+        {
+            wsaBuffers[i].buf = (CHAR *)buffers[i].Data;
+            wsaBuffers[i].len = (ULONG)buffers[i].Size;
+        }
+        DWORD sentBytes = 0;
+        if (WSASend(_socket, wsaBuffers, (DWORD)count, &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+        {
+            return HandleSendError();
+        }
+        return sentBytes;
+#else
+        iovec iov[MAX_SEND_BUFFERS];
+        for (size_t i = 0; i < count; i++)
+        {
+            iov[i].iov_base = (void *)buffers[i].Data;
+            iov[i].iov_len = buffers[i].Size;
+        }
+        msghdr msg = {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t sentBytes = sendmsg(_socket, &msg, FLAG_NO_PIPE);
+        if (sentBytes == SOCKET_ERROR)
+        {
+            return HandleSendError();
+        }
+        return (size_t)sentBytes;
+#endif
+    }
+
     NETWORK_READPACKET ReceiveData(void * buffer, size_t size, size_t * sizeReceived) override
     {
         if (_status != SOCKET_STATUS_CONNECTED)
@@ -419,6 +471,11 @@ public:
         return _hostName.empty() ? nullptr : _hostName.c_str();
     }
 
+    SOCKET GetSocket() const
+    {
+        return _socket;
+    }
+
 private:
     explicit TcpSocket(SOCKET socket)
     {
@@ -436,6 +493,17 @@ private:
         _status = SOCKET_STATUS_CLOSED;
     }
 
+    size_t HandleSendError()
+    {
+        // A full send buffer only means the rest has to wait, anything else is the connection failing
+        sint32 error = LAST_SOCKET_ERROR();
+        if (error == EWOULDBLOCK || error == EAGAIN)
+        {
+            return 0;
+        }
+        throw SocketException("Unable to send data, error: " + std::to_string(error));
+    }
+
     bool ResolveAddress(const char * address, uint16 port, sockaddr_storage * ss, sint32 * ss_len)
     {
         std::string serviceName = std::to_string(port);
@@ -490,6 +558,113 @@ ITcpSocket * CreateTcpSocket()
     return new TcpSocket();
 }
 
+#if defined(__linux__)
+
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    sint32 _epoll   = -1;
+    sint32 _wakeFd  = -1;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+        _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_wakeFd == -1)
+        {
+            close(_epoll);
+            throw SocketException("Unable to create eventfd.");
+        }
+
+        // The wake event is tagged with nullptr so it can be told apart from sockets
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+        epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeFd, &ev);
+    }
+
+    ~EpollSocketPoller() override
+    {
+        close(_wakeFd);
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket * socket, void * tag) override
+    {
+        epoll_event ev = {};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = tag;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, static_cast<TcpSocket *>(socket)->GetSocket(), &ev) != 0)
+        {
+            log_error("epoll_ctl failed. %d", LAST_SOCKET_ERROR());
+        }
+    }
+
+    void Remove(ITcpSocket * socket) override
+    {
+        // Fails harmlessly if the socket was already removed
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, static_cast<TcpSocket *>(socket)->GetSocket(), nullptr);
+    }
+
+    size_t Wait(void * * readyTags, size_t maxReady, sint32 timeoutMs) override
+    {
+        constexpr size_t MAX_EVENTS = 64;
+        epoll_event events[MAX_EVENTS];
+        sint32 numEvents = epoll_wait(_epoll, events, (sint32)std::min(maxReady, MAX_EVENTS), timeoutMs);
+
+        size_t numReady = 0;
+        for (sint32 i = 0; i < numEvents; i++)
+        {
+            if (events[i].data.ptr == nullptr)
+            {
+                uint64_t value;
+                while (read(_wakeFd, &value, sizeof(value)) > 0) { }
+            }
+            else
+            {
+                readyTags[numReady++] = events[i].data.ptr;
+            }
+        }
+        return numReady;
+    }
+
+    void Wake() override
+    {
+        uint64_t value = 1;
+        if (write(_wakeFd, &value, sizeof(value)) == -1)
+        {
+            log_error("Failed to wake socket poller. %d", LAST_SOCKET_ERROR());
+        }
+    }
+};
+
+ISocketPoller * CreateSocketPoller()
+{
+    try
+    {
+        return new EpollSocketPoller();
+    }
+    catch (const std::exception &ex)
+    {
+        log_error("%s", ex.what());
+        return nullptr;
+    }
+}
+
+#else
+
+ISocketPoller * CreateSocketPoller()
+{
+    return nullptr;
+}
+
+#endif // defined(__linux__)
+
 bool InitialiseWSA()
 {
 #ifdef _WIN32
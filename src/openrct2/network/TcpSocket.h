@@ -37,6 +37,15 @@ enum NETWORK_READPACKET
     NETWORK_READPACKET_DISCONNECTED
 };
 
+/**
+ * A piece of data to be sent as part of a larger, gathered send.
+ */
+struct SocketBuffer
+{
+    const void *    Data;
+    size_t          Size;
+};
+
 /**
  * Represents a TCP socket / connection or listener.
  */
@@ -57,14 +66,40 @@ public:
     virtual void ConnectAsync(const char * address, uint16 port) abstract;
 
     virtual size_t             SendData(const void * buffer, size_t size)                     abstract;
+    // Returns how much was sent before the socket would block, throws if the connection has failed
+    virtual size_t             SendData(const SocketBuffer * buffers, size_t count)           abstract;
     virtual NETWORK_READPACKET ReceiveData(void * buffer, size_t size, size_t * sizeReceived) abstract;
 
     virtual void Disconnect() abstract;
     virtual void Close() abstract;
 };
 
+/**
+ * Waits for data to arrive on any of a set of connected sockets.
+ */
+interface ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() { }
+
+    virtual void   Add(ITcpSocket * socket, void * tag) abstract;
+    virtual void   Remove(ITcpSocket * socket)          abstract;
+
+    /**
+     * Blocks until at least one socket is readable, Wake is called or the timeout elapses.
+     * @returns the number of tags written to readyTags, one for each readable socket.
+     */
+    virtual size_t Wait(void * * readyTags, size_t maxReady, sint32 timeoutMs) abstract;
+    virtual void   Wake()                                                       abstract;
+};
+
 ITcpSocket * CreateTcpSocket();
 
+/**
+ * Creates a socket poller, or returns nullptr if the platform does not support one.
+ */
+ISocketPoller * CreateSocketPoller();
+
 bool InitialiseWSA();
 void DisposeWSA();
 
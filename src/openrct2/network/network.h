@@ -51,12 +51,13 @@ typedef struct GameAction GameAction;
 // This define specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "28"
+#define NETWORK_STREAM_VERSION "31"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 #ifdef __cplusplus
 
 #include <array>
+#include <deque>
 #include <list>
 #include <set>
 #include <memory>
@@ -64,17 +65,20 @@ typedef struct GameAction GameAction;
 #include <vector>
 #include <functional>
 #include <fstream>
+#include <future>
 #include <map>
 #include <openssl/evp.h>
 #include "../actions/GameAction.h"
 #include "../core/Json.hpp"
 #include "../core/Nullable.hpp"
 #include "../core/MemoryStream.h"
+#include "NetworkChecksum.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
 #include "NetworkKey.h"
 #include "NetworkPacket.h"
 #include "NetworkPlayer.h"
+#include "NetworkReceiver.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkUser.h"
 #include "TcpSocket.h"
@@ -83,6 +87,9 @@ enum {
     NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
 };
 
+// Number of sent ticks the server keeps checksum trees for, to answer clients that desynchronised
+constexpr size_t NETWORK_CHECKSUM_HISTORY_SIZE = 100;
+
 struct ObjectRepositoryItem;
 
 namespace OpenRCT2
@@ -104,6 +111,7 @@ public:
     sint32 GetStatus();
     sint32 GetAuthStatus();
     uint32 GetServerTick();
+    NetworkTrafficStats GetTrafficStats();
     uint8 GetPlayerID();
     void Update();
     void Flush();
@@ -144,6 +152,7 @@ public:
     void Server_Send_AUTH(NetworkConnection& connection);
     void Server_Send_TOKEN(NetworkConnection& connection);
     void Server_Send_MAP(NetworkConnection* connection = nullptr);
+    void Server_Send_MAP_Chunks(NetworkConnection* connection, const std::vector<uint8> &data);
     void Client_Send_CHAT(const char* text);
     void Server_Send_CHAT(const char* text);
     void Client_Send_GAMECMD(uint32 eax, uint32 ebx, uint32 ecx, uint32 edx, uint32 esi, uint32 edi, uint32 ebp, uint8 callback);
@@ -164,6 +173,8 @@ public:
     void Client_Send_GAMEINFO();
     void Client_Send_OBJECTS(const std::vector<std::string> &objects);
     void Server_Send_OBJECTS(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem *> &objects) const;
+    void Client_Send_CHECKSUMS(const NetworkChecksumTree &checksums);
+    void Server_Send_CHECKSUMS(NetworkConnection& connection, uint32 tick, const NetworkChecksumTree * checksums, const std::vector<uint16> &spriteBlocks, const std::vector<uint16> &tileBlocks);
 
     std::vector<std::unique_ptr<NetworkPlayer>> player_list;
     std::vector<std::unique_ptr<NetworkGroup>> group_list;
@@ -181,6 +192,7 @@ public:
 
 private:
     bool ProcessConnection(NetworkConnection& connection);
+    bool ReadPackets(NetworkConnection& connection);
     void ProcessPacket(NetworkConnection& connection, NetworkPacket& packet);
     void AddClient(ITcpSocket * socket);
     void RemoveClient(std::unique_ptr<NetworkConnection>& connection);
@@ -225,6 +237,20 @@ private:
         }
     };
 
+    // An exported map that is being compressed, or has been, for clients that joined in the same tick
+    struct MapPayload
+    {
+        uint32                                      Tick = 0;
+        bool                                        Shareable = true;
+        std::vector<const ObjectRepositoryItem *>   Objects;
+        std::shared_future<std::vector<uint8>>      Data;
+        std::vector<NetworkConnection *>            Recipients;
+    };
+
+    MapPayload * GetOrCreateMapPayload(const std::vector<const ObjectRepositoryItem *> &objects);
+    void UpdateMapPayloads();
+    void InvalidateMapPayloads();
+
     sint32 mode = NETWORK_MODE_NONE;
     sint32 status = NETWORK_STATUS_NONE;
     bool _closeLock = false;
@@ -239,11 +265,19 @@ private:
     uint32 server_tick = 0;
     uint32 server_srand0 = 0;
     uint32 server_srand0_tick = 0;
-    char server_sprite_hash[EVP_MAX_MD_SIZE + 1];
+    NetworkChecksumSummary server_checksums;
+    bool server_checksums_valid = false;
+    NetworkChecksumTracker _checksumTracker;
+    std::unique_ptr<NetworkChecksumTree> _localChecksums;
+    std::vector<rct_sprite> _localDesyncSprites;
+    std::deque<std::unique_ptr<NetworkChecksumTree>> _checksumHistory;
     uint8 player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    std::unique_ptr<NetworkReceiver> _receiver;
+    NetworkTrafficStats _disconnectedTrafficStats = {};
     std::multiset<GameCommand> game_command_queue;
     std::vector<uint8> chunk_buffer;
+    std::list<MapPayload> _mapPayloads;
     std::string _password;
     bool _desynchronised = false;
     INetworkServerAdvertiser * _advertiser = nullptr;
@@ -289,8 +323,11 @@ private:
     void Server_Handle_TOKEN(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_CHECKSUMS(NetworkConnection& connection, NetworkPacket& packet);
+    void Server_Handle_CHECKSUMS(NetworkConnection& connection, NetworkPacket& packet);
 
-    uint8 * save_for_network(size_t &out_size, const std::vector<const ObjectRepositoryItem *> &objects) const;
+    bool save_for_network(std::vector<uint8> &out, const std::vector<const ObjectRepositoryItem *> &objects) const;
+    static std::vector<uint8> encode_for_network(std::vector<uint8> sv6);
 
     std::ofstream _chat_log_fs;
     std::ofstream _server_log_fs;
@@ -320,6 +357,7 @@ void network_flush();
 
 sint32 network_get_authstatus();
 uint32 network_get_server_tick();
+void network_get_traffic_stats(NetworkTrafficStats * stats);
 uint8 network_get_current_player_id();
 sint32 network_get_num_players();
 const char* network_get_player_name(uint32 index);
@@ -15,6 +15,7 @@
 #pragma endregion
 
 #include <stdexcept>
+#include <vector>
 #include "../core/IStream.hpp"
 #include "../core/Memory.hpp"
 #include "../OpenRCT2.h"
@@ -40,8 +41,13 @@ void ImageTable::Read(IReadObjectContext * context, IStream * stream)
         uint32 numImages = stream->ReadValue<uint32>();
         uint32 imageDataSize = stream->ReadValue<uint32>();
 
-        uint64 headerTableSize = numImages * 16;
-        uint64 remainingBytes = stream->GetLength() - stream->GetPosition() - headerTableSize;
+        uint64 headerTableSize = (uint64)numImages * sizeof(rct_g1_element_32bit);
+        uint64 streamRemainingBytes = stream->GetLength() - stream->GetPosition();
+        if (headerTableSize > streamRemainingBytes)
+        {
+            throw std::runtime_error("Image table headers longer than object.");
+        }
+        uint64 remainingBytes = streamRemainingBytes - headerTableSize;
         if (remainingBytes > imageDataSize)
         {
             context->LogWarning(OBJECT_ERROR_BAD_IMAGE_TABLE, "Image table size longer than expected.");
@@ -57,21 +63,21 @@ void ImageTable::Read(IReadObjectContext * context, IStream * stream)
         }
 
         // Read g1 element headers
+        std::vector<rct_g1_element_32bit> g1Elements32(numImages);
+        stream->Read(g1Elements32.data(), headerTableSize);
+
         uintptr_t imageDataBase = (uintptr_t)_data;
-        for (uint32 i = 0; i < numImages; i++)
+        _entries.reserve(numImages);
+        for (const auto &src : g1Elements32)
         {
             rct_g1_element g1Element;
-
-            uintptr_t imageDataOffset = (uintptr_t)stream->ReadValue<uint32>();
-            g1Element.offset = (uint8*)(imageDataBase + imageDataOffset);
-
-            g1Element.width = stream->ReadValue<sint16>();
-            g1Element.height = stream->ReadValue<sint16>();
-            g1Element.x_offset = stream->ReadValue<sint16>();
-            g1Element.y_offset = stream->ReadValue<sint16>();
-            g1Element.flags = stream->ReadValue<uint16>();
-            g1Element.zoomed_offset = stream->ReadValue<uint16>();
-
+            g1Element.offset = (uint8*)(imageDataBase + (uintptr_t)src.offset);
+            g1Element.width = src.width;
+            g1Element.height = src.height;
+            g1Element.x_offset = src.x_offset;
+            g1Element.y_offset = src.y_offset;
+            g1Element.flags = src.flags;
+            g1Element.zoomed_offset = src.zoomed_offset;
             _entries.push_back(g1Element);
         }
 
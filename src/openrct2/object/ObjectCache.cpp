@@ -0,0 +1,207 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/FileStream.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "ObjectCache.h"
+#include "ObjectRepository.h"
+
+#pragma pack(push, 1)
+struct ObjectCacheHeader
+{
+    uint32              MagicNumber = 0;
+    uint16              Version = 0;
+    uint16              HeaderSize = sizeof(ObjectCacheHeader);
+    rct_object_entry    Entry = { 0 };
+    uint64              SourceSize = 0;
+    uint64              SourceLastModified = 0;
+    uint32              DataSize = 0;
+};
+#pragma pack(pop)
+
+// Cache file format version which when incremented invalidates every cached object
+constexpr uint16 OBJECT_CACHE_VERSION = 2;
+constexpr uint32 OBJECT_CACHE_MAGIC_NUMBER = 0x434A424F; // OBJC
+
+// Not .dat, so that nothing scanning for objects can mistake a cache entry for one
+constexpr const utf8 * OBJECT_CACHE_EXTENSION = ".cache";
+
+constexpr uint64 ObjectCache::MaxSize;
+
+ObjectCache::ObjectCache(const std::string &directory)
+    : _directory(directory)
+{
+}
+
+std::unique_ptr<CachedObjectData> ObjectCache::Find(const ObjectRepositoryItem &item) const
+{
+    auto path = GetCachePath(item.ObjectEntry);
+    if (!File::Exists(path))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        auto file = std::make_unique<MemoryMappedFile>(path);
+        auto header = file->GetArray<ObjectCacheHeader>(0, 1);
+        if (header->MagicNumber != OBJECT_CACHE_MAGIC_NUMBER ||
+            header->Version != OBJECT_CACHE_VERSION ||
+            header->HeaderSize != sizeof(ObjectCacheHeader) ||
+            std::memcmp(&header->Entry, &item.ObjectEntry, sizeof(rct_object_entry)) != 0 ||
+            header->SourceSize != item.FileSize ||
+            header->SourceLastModified != item.FileLastModified ||
+            file->GetLength() != sizeof(ObjectCacheHeader) + header->DataSize)
+        {
+            log_verbose("ObjectCache: '%s' is out of date", path.c_str());
+            return nullptr;
+        }
+        size_t dataSize = header->DataSize;
+        return std::make_unique<CachedObjectData>(std::move(file), sizeof(ObjectCacheHeader), dataSize);
+    }
+    catch (const std::exception &e)
+    {
+        log_warning("Unable to read cached object '%s': %s", path.c_str(), e.what());
+        return nullptr;
+    }
+}
+
+void ObjectCache::Add(const ObjectRepositoryItem &item, const void * data, size_t dataSize) const
+{
+    auto path = GetCachePath(item.ObjectEntry);
+    try
+    {
+        Path::CreateDirectory(_directory);
+
+        ObjectCacheHeader header;
+        header.MagicNumber = OBJECT_CACHE_MAGIC_NUMBER;
+        header.Version = OBJECT_CACHE_VERSION;
+        header.Entry = item.ObjectEntry;
+        header.SourceSize = item.FileSize;
+        header.SourceLastModified = item.FileLastModified;
+        header.DataSize = (uint32)dataSize;
+
+        // Other processes can have the existing file mapped, so the new file is written separately and moved over it
+        auto threadHash = std::hash<std::thread::id>()(std::this_thread::get_id());
+        auto tempPath = String::StdFormat("%s.%08X%08X.tmp", path.c_str(),
+            (uint32)threadHash, (uint32)std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        {
+            auto fs = FileStream(tempPath, FILE_MODE_WRITE);
+            fs.WriteValue(header);
+            fs.Write(data, dataSize);
+        }
+        if (!File::Move(tempPath, path))
+        {
+            // The destination must not exist when moving on some platforms
+            File::Delete(path);
+            if (!File::Move(tempPath, path))
+            {
+                File::Delete(tempPath);
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        log_warning("Unable to write cached object '%s': %s", path.c_str(), e.what());
+        return;
+    }
+
+    // Trim now and again while running as well, a session that loads many parks can add a lot
+    uint64 addedSize = _addedSize += sizeof(ObjectCacheHeader) + dataSize;
+    if (addedSize >= MaxSize / 4)
+    {
+        _addedSize = 0;
+        Trim();
+    }
+}
+
+void ObjectCache::Trim() const
+{
+    std::lock_guard<std::mutex> lock(_trimMutex);
+
+    struct CacheFile
+    {
+        std::string Path;
+        uint64      Size;
+        uint64      LastModified;
+    };
+    std::vector<CacheFile> files;
+    uint64 totalSize = 0;
+
+    auto pattern = Path::Combine(_directory, String::StdFormat("*%s;*.tmp", OBJECT_CACHE_EXTENSION));
+    IFileScanner * scanner = Path::ScanDirectory(pattern, false);
+    while (scanner->Next())
+    {
+        auto fileInfo = scanner->GetFileInfo();
+        std::string path = scanner->GetPath();
+        if (String::Equals(Path::GetExtension(path).c_str(), ".tmp", true))
+        {
+            // Left behind by a process that stopped while writing. If it is still being written the move over the
+            // entry fails and the entry is simply written again next time.
+            File::Delete(path);
+            continue;
+        }
+        files.push_back({ path, fileInfo->Size, fileInfo->LastModified });
+        totalSize += fileInfo->Size;
+    }
+    delete scanner;
+
+    if (totalSize <= MaxSize)
+    {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const CacheFile &a, const CacheFile &b) -> bool
+    {
+        return a.LastModified < b.LastModified;
+    });
+    for (const auto &file : files)
+    {
+        if (totalSize <= MaxSize)
+        {
+            break;
+        }
+        // Can fail if another process has the file mapped, it will be tried again next time
+        if (File::Delete(file.Path))
+        {
+            totalSize -= file.Size;
+        }
+    }
+    log_verbose("ObjectCache: trimmed '%s' to %llu bytes", _directory.c_str(), (unsigned long long)totalSize);
+}
+
+std::string ObjectCache::GetCachePath(const rct_object_entry &entry) const
+{
+    // The object name can contain characters that are not valid in file names, so the whole entry is used in hex
+    const uint8 * entryBytes = (const uint8 *)&entry;
+    utf8 fileName[sizeof(rct_object_entry) * 2 + 8];
+    for (size_t i = 0; i < sizeof(rct_object_entry); i++)
+    {
+        snprintf(&fileName[i * 2], 3, "%02X", entryBytes[i]);
+    }
+    String::Set(&fileName[sizeof(rct_object_entry) * 2], sizeof(fileName) - sizeof(rct_object_entry) * 2, OBJECT_CACHE_EXTENSION);
+    return Path::Combine(_directory, fileName);
+}
@@ -0,0 +1,92 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "../common.h"
+#include "../core/MemoryMappedFile.h"
+#include "Object.h"
+
+struct ObjectRepositoryItem;
+
+/**
+ * Decoded object data read from the object cache.
+ */
+class CachedObjectData final
+{
+private:
+    std::unique_ptr<MemoryMappedFile> const _file;
+    size_t const _offset;
+    size_t const _size;
+
+public:
+    CachedObjectData(std::unique_ptr<MemoryMappedFile> file, size_t offset, size_t size)
+        : _file(std::move(file)),
+          _offset(offset),
+          _size(size)
+    {
+    }
+
+    const void * GetData() const { return (const uint8 *)_file->GetData() + _offset; }
+    size_t GetSize() const { return _size; }
+};
+
+/**
+ * A directory of decoded object data chunks so that objects can be read again without opening their DAT files.
+ * Entries are keyed by the object entry and are only used while the size and modification time recorded for the
+ * object's file in the object index are unchanged. Once the directory grows past MaxSize the least recently written
+ * entries are deleted.
+ */
+class ObjectCache final
+{
+public:
+    static constexpr uint64 MaxSize = 64 * 1024 * 1024;
+
+private:
+    std::string const _directory;
+    mutable std::atomic<uint64> _addedSize { 0 };
+    mutable std::mutex _trimMutex;
+
+public:
+    explicit ObjectCache(const std::string &directory);
+
+    /**
+     * Finds the decoded data for the given object, returns nullptr if the object is not in the cache or its file has
+     * changed since it was added. The object's file is not accessed.
+     */
+    std::unique_ptr<CachedObjectData> Find(const ObjectRepositoryItem &item) const;
+
+    /**
+     * Adds the decoded data for the given object to the cache, replacing any existing entry.
+     */
+    void Add(const ObjectRepositoryItem &item, const void * data, size_t dataSize) const;
+
+    /**
+     * Deletes the oldest entries until the cache is no larger than MaxSize, along with any left over temporary files.
+     */
+    void Trim() const;
+
+private:
+    std::string GetCachePath(const rct_object_entry &entry) const;
+};
+
+#endif
@@ -14,8 +14,10 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <cstring>
 #include "../core/Console.hpp"
 #include "../core/FileStream.hpp"
+#include "../core/Guard.hpp"
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
 #include "../core/String.hpp"
@@ -26,7 +28,9 @@
 #include "FootpathObject.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
+#include "ObjectCache.h"
 #include "ObjectFactory.h"
+#include "ObjectRepository.h"
 #include "RideObject.h"
 #include "SceneryGroupObject.h"
 #include "SmallSceneryObject.h"
@@ -99,7 +103,11 @@ namespace ObjectFactory
         }
     }
 
-    Object * CreateObjectFromLegacyFile(const utf8 * path)
+    /**
+     * Creates an object from a DAT file. If a cache is given, the decoded data is added to it for the repository
+     * item, as long as the file still holds the object the item was indexed from.
+     */
+    static Object * CreateObjectFromLegacyFile(const utf8 * path, const ObjectRepositoryItem * item, const ObjectCache * cache)
     {
         log_verbose("CreateObjectFromLegacyFile(\"%s\")", path);
 
@@ -126,6 +134,11 @@ namespace ObjectFactory
             {
                 throw std::runtime_error("Object has errors");
             }
+
+            if (cache != nullptr && std::memcmp(&entry, &item->ObjectEntry, sizeof(rct_object_entry)) == 0)
+            {
+                cache->Add(*item, chunk->GetData(), chunk->GetLength());
+            }
         }
         catch (const std::exception &)
         {
@@ -137,6 +150,32 @@ namespace ObjectFactory
         return result;
     }
 
+    Object * CreateObjectFromLegacyFile(const utf8 * path)
+    {
+        return CreateObjectFromLegacyFile(path, nullptr, nullptr);
+    }
+
+    /**
+     * Creates the object for a repository item. The decoded data is read from the cache when the item's file has not
+     * changed since it was indexed, in which case the file is not opened at all.
+     */
+    Object * CreateObjectFromRepositoryItem(const ObjectRepositoryItem * item, const ObjectCache * cache)
+    {
+        Guard::ArgumentNotNull(item, GUARD_LINE);
+        Guard::ArgumentNotNull(cache, GUARD_LINE);
+
+        auto cachedData = cache->Find(*item);
+        if (cachedData != nullptr)
+        {
+            Object * result = CreateObjectFromLegacyData(&item->ObjectEntry, cachedData->GetData(), cachedData->GetSize());
+            if (result != nullptr)
+            {
+                return result;
+            }
+        }
+        return CreateObjectFromLegacyFile(item->Path, item, cache);
+    }
+
     Object * CreateObjectFromLegacyData(const rct_object_entry * entry, const void * data, size_t dataSize)
     {
         Guard::ArgumentNotNull(entry, GUARD_LINE);
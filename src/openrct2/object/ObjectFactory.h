@@ -21,10 +21,13 @@
 #include "../common.h"
 
 class Object;
+class ObjectCache;
+struct ObjectRepositoryItem;
 
 namespace ObjectFactory
 {
     Object * CreateObjectFromLegacyFile(const utf8 * path);
+    Object * CreateObjectFromRepositoryItem(const ObjectRepositoryItem * item, const ObjectCache * cache);
     Object * CreateObjectFromLegacyData(const rct_object_entry * entry, const void * data, size_t dataSize);
     Object * CreateObject(const rct_object_entry &entry);
 }
@@ -16,8 +16,10 @@
 
 #include <array>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include "../core/Console.hpp"
+#include "../core/JobPool.hpp"
 #include "../core/Memory.hpp"
 #include "../localisation/StringIds.h"
 #include "FootpathItemObject.h"
@@ -532,6 +534,9 @@ private:
 
     Object * * LoadObjects(const ObjectRepositoryItem * * requiredObjects, size_t * outNewObjectsLoaded)
     {
+        auto readObjects = ReadObjects(requiredObjects);
+
+        // Loading allocates images and strings, so is done in slot order on this thread
         size_t newObjectsLoaded = 0;
         Object * * loadedObjects = Memory::AllocateArray<Object *>(OBJECT_ENTRY_COUNT);
         for (sint32 i = 0; i < OBJECT_ENTRY_COUNT; i++)
@@ -543,13 +548,26 @@ private:
                 loadedObject = ori->LoadedObject;
                 if (loadedObject == nullptr)
                 {
-                    loadedObject = GetOrLoadObject(ori);
+                    auto it = readObjects.find(ori);
+                    if (it != readObjects.end())
+                    {
+                        loadedObject = it->second;
+                        readObjects.erase(it);
+                    }
                     if (loadedObject == nullptr)
                     {
                         ReportObjectLoadProblem(&ori->ObjectEntry);
+                        for (auto &readObject : readObjects)
+                        {
+                            delete readObject.second;
+                        }
                         Memory::Free(loadedObjects);
                         return nullptr;
-                    } else {
+                    }
+                    else
+                    {
+                        loadedObject->Load();
+                        _objectRepository->RegisterLoadedObject(ori, loadedObject);
                         newObjectsLoaded++;
                     }
                 }
@@ -563,6 +581,45 @@ private:
         return loadedObjects;
     }
 
+    /**
+     * Reads every required object that is not already loaded. Objects are read from their files on a pool of
+     * worker threads, they still need to be loaded and registered before they can be used.
+     */
+    std::unordered_map<const ObjectRepositoryItem *, Object *> ReadObjects(const ObjectRepositoryItem * * requiredObjects)
+    {
+        std::unordered_map<const ObjectRepositoryItem *, Object *> readObjects;
+        for (sint32 i = 0; i < OBJECT_ENTRY_COUNT; i++)
+        {
+            const ObjectRepositoryItem * ori = requiredObjects[i];
+            if (ori != nullptr && ori->LoadedObject == nullptr)
+            {
+                readObjects[ori] = nullptr;
+            }
+        }
+
+        if (readObjects.size() == 1)
+        {
+            auto &readObject = *readObjects.begin();
+            readObject.second = _objectRepository->LoadObject(readObject.first);
+        }
+        else if (readObjects.size() > 1)
+        {
+            // Each task only writes to its own map value, the map itself is not modified until the pool is joined
+            JobPool jobPool;
+            for (auto &readObject : readObjects)
+            {
+                auto ori = readObject.first;
+                auto result = &readObject.second;
+                jobPool.AddTask([this, ori, result]()
+                {
+                    *result = _objectRepository->LoadObject(ori);
+                });
+            }
+            jobPool.Join();
+        }
+        return readObjects;
+    }
+
     Object * GetOrLoadObject(const ObjectRepositoryItem * ori)
     {
         Object * loadedObject = ori->LoadedObject;
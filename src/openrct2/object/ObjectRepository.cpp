@@ -21,6 +21,7 @@
 
 #include "../common.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
 #include "../core/FileIndex.hpp"
 #include "../core/FileStream.hpp"
 #include "../core/Guard.hpp"
@@ -34,6 +35,7 @@
 #include "../rct12/SawyerChunkWriter.h"
 #include "../scenario/ScenarioRepository.h"
 #include "Object.h"
+#include "ObjectCache.h"
 #include "ObjectFactory.h"
 #include "ObjectManager.h"
 #include "ObjectRepository.h"
@@ -75,11 +77,89 @@ using ObjectEntryMap = std::unordered_map<rct_object_entry, size_t, ObjectEntryH
 
 static void ReportMissingObject(const rct_object_entry * entry);
 
+ObjectRepositoryItem::ObjectRepositoryItem()
+{
+    // Clears whichever part of the union is in use as well
+    Memory::Set(this, 0, sizeof(ObjectRepositoryItem));
+}
+
+ObjectRepositoryItem::ObjectRepositoryItem(const ObjectRepositoryItem &other)
+{
+    Memory::Copy<void>(this, &other, sizeof(ObjectRepositoryItem));
+    Path = String::Duplicate(other.Path);
+    Name = String::Duplicate(other.Name);
+    if (HasThemeObjects())
+    {
+        ThemeObjects = Memory::DuplicateArray(other.ThemeObjects, other.NumThemeObjects);
+    }
+}
+
+ObjectRepositoryItem::ObjectRepositoryItem(ObjectRepositoryItem &&other)
+{
+    Memory::Copy<void>(this, &other, sizeof(ObjectRepositoryItem));
+    other.Path = nullptr;
+    other.Name = nullptr;
+    if (HasThemeObjects())
+    {
+        other.ThemeObjects = nullptr;
+        other.NumThemeObjects = 0;
+    }
+}
+
+ObjectRepositoryItem::~ObjectRepositoryItem()
+{
+    Free();
+}
+
+ObjectRepositoryItem & ObjectRepositoryItem::operator=(const ObjectRepositoryItem &other)
+{
+    if (this != &other)
+    {
+        *this = ObjectRepositoryItem(other);
+    }
+    return *this;
+}
+
+ObjectRepositoryItem & ObjectRepositoryItem::operator=(ObjectRepositoryItem &&other)
+{
+    if (this != &other)
+    {
+        Free();
+        Memory::Copy<void>(this, &other, sizeof(ObjectRepositoryItem));
+        other.Path = nullptr;
+        other.Name = nullptr;
+        if (HasThemeObjects())
+        {
+            other.ThemeObjects = nullptr;
+            other.NumThemeObjects = 0;
+        }
+    }
+    return *this;
+}
+
+bool ObjectRepositoryItem::HasThemeObjects() const
+{
+    return (ObjectEntry.flags & 0x0F) == OBJECT_TYPE_SCENERY_GROUP;
+}
+
+void ObjectRepositoryItem::Free()
+{
+    Memory::Free(Path);
+    Memory::Free(Name);
+    Path = nullptr;
+    Name = nullptr;
+    if (HasThemeObjects())
+    {
+        Memory::Free(ThemeObjects);
+        ThemeObjects = nullptr;
+    }
+}
+
 class ObjectFileIndex final : public FileIndex<ObjectRepositoryItem>
 {
 private:
     static constexpr uint32 MAGIC_NUMBER = 0x5844494F; // OIDX
-    static constexpr uint16 VERSION = 16;
+    static constexpr uint16 VERSION = 17;
     static constexpr auto PATTERN = "*.dat;*.pob";
 
 public:
@@ -98,11 +178,26 @@ public:
 public:
     std::tuple<bool, ObjectRepositoryItem> Create(const std::string &path) const override
     {
+        // Recorded before reading, so that a file changed while it is read does not match the object cache later
+        uint64 fileSize = 0;
+        uint64 fileLastModified = 0;
+        try
+        {
+            fileSize = FileStream(path, FILE_MODE_OPEN).GetLength();
+            fileLastModified = File::GetLastModified(path);
+        }
+        catch (const std::exception &)
+        {
+            // The file can not be read, so loading the object below fails as well
+        }
+
         auto object = ObjectFactory::CreateObjectFromLegacyFile(path.c_str());
         if (object != nullptr)
         {
-            ObjectRepositoryItem item = { 0 };
+            ObjectRepositoryItem item;
             item.ObjectEntry = *object->GetObjectEntry();
+            item.FileSize = fileSize;
+            item.FileLastModified = fileLastModified;
             item.Path = String::Duplicate(path);
             item.Name = String::Duplicate(object->GetName());
             object->SetRepositoryItem(&item);
@@ -119,6 +214,8 @@ protected:
     void Serialise(IStream * stream, const ObjectRepositoryItem &item) const override
     {
         stream->WriteValue(item.ObjectEntry);
+        stream->WriteValue(item.FileSize);
+        stream->WriteValue(item.FileLastModified);
         stream->WriteString(item.Path);
         stream->WriteString(item.Name);
 
@@ -147,9 +244,11 @@ protected:
 
     ObjectRepositoryItem Deserialise(IStream * stream) const override
     {
-        ObjectRepositoryItem item = { 0 };
+        ObjectRepositoryItem item;
 
         item.ObjectEntry = stream->ReadValue<rct_object_entry>();
+        item.FileSize = stream->ReadValue<uint64>();
+        item.FileLastModified = stream->ReadValue<uint64>();
         item.Path = stream->ReadString();
         item.Name = stream->ReadString();
 
@@ -191,13 +290,15 @@ class ObjectRepository final : public IObjectRepository
 {
     IPlatformEnvironment * const        _env = nullptr;
     ObjectFileIndex const               _fileIndex;
+    ObjectCache const                   _objectCache;
     std::vector<ObjectRepositoryItem>   _items;
     ObjectEntryMap                      _itemMap;
 
 public:
     explicit ObjectRepository(IPlatformEnvironment * env)
         : _env(env),
-          _fileIndex(env)
+          _fileIndex(env),
+          _objectCache(env->GetDirectoryPath(DIRBASE::CACHE, DIRID::OBJECT_CACHE))
     {
     }
 
@@ -212,6 +313,7 @@ public:
         auto items = _fileIndex.LoadOrBuild();
         AddItems(items);
         SortItems();
+        _objectCache.Trim();
     }
 
     void Construct() override
@@ -260,7 +362,7 @@ public:
     {
         Guard::ArgumentNotNull(ori, GUARD_LINE);
 
-        Object * object = ObjectFactory::CreateObjectFromLegacyFile(ori->Path);
+        Object * object = ObjectFactory::CreateObjectFromRepositoryItem(ori, &_objectCache);
         return object;
     }
 
@@ -350,10 +452,6 @@ public:
 private:
     void ClearItems()
     {
-        for (auto &item : _items)
-        {
-            FreeItem(&item);
-        }
         _items.clear();
         _itemMap.clear();
     }
@@ -427,22 +525,6 @@ private:
         }
     }
 
-    static void FreeItem(ObjectRepositoryItem * item)
-    {
-        Memory::Free(item->Path);
-        Memory::Free(item->Name);
-        item->Path = nullptr;
-        item->Name = nullptr;
-
-        uint8 objectType = item->ObjectEntry.flags & 0x0F;
-        switch (objectType) {
-        case OBJECT_TYPE_SCENERY_GROUP:
-            Memory::Free(item->ThemeObjects);
-            item->ThemeObjects = nullptr;
-            break;
-        }
-    }
-
     static void SaveObject(const utf8 * path,
                            const rct_object_entry * entry,
                            const void * data, size_t dataSize,
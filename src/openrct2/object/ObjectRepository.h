@@ -45,6 +45,9 @@ typedef struct ObjectRepositoryItem
     utf8 *             Path;
     utf8 *             Name;
     Object *           LoadedObject;
+    // Size and modification time of the file when it was indexed, checked by the object cache instead of the file
+    uint64             FileSize;
+    uint64             FileLastModified;
     union
     {
         struct
@@ -60,6 +63,20 @@ typedef struct ObjectRepositoryItem
             rct_object_entry * ThemeObjects;
         };
     };
+
+#ifdef __cplusplus
+    // Path, Name and ThemeObjects are owned by the item, so copies duplicate them and moves take them over
+    ObjectRepositoryItem();
+    ObjectRepositoryItem(const ObjectRepositoryItem &other);
+    ObjectRepositoryItem(ObjectRepositoryItem &&other);
+    ~ObjectRepositoryItem();
+    ObjectRepositoryItem & operator=(const ObjectRepositoryItem &other);
+    ObjectRepositoryItem & operator=(ObjectRepositoryItem &&other);
+
+private:
+    bool HasThemeObjects() const;
+    void Free();
+#endif
 } ObjectRepositoryItem;
 
 #ifdef __cplusplus
@@ -67,12 +67,12 @@ void Painter::Paint(IDrawingEngine * de)
 
     if (gConfigGeneral.show_fps)
     {
-        PaintFPS(dpi);
+        PaintFPS(de, dpi);
     }
     gCurrentDrawCount++;
 }
 
-void Painter::PaintFPS(rct_drawpixelinfo * dpi)
+void Painter::PaintFPS(IDrawingEngine * de, rct_drawpixelinfo * dpi)
 {
     sint32 x = _uiContext->GetWidth() / 2;
     sint32 y = 2;
@@ -87,7 +87,17 @@ void Painter::PaintFPS(rct_drawpixelinfo * dpi)
     ch = utf8_write_codepoint(ch, FORMAT_OUTLINE);
     ch = utf8_write_codepoint(ch, FORMAT_WHITE);
 
-    snprintf(ch, 64 - (ch - buffer), "%d", _currentFPS);
+    // Engines that only redraw what has changed also show how much of the screen that was this frame
+    DirtyRegionStats dirtyStats;
+    if (de->GetDirtyRegionStats(&dirtyStats) && dirtyStats.ScreenPixels != 0)
+    {
+        snprintf(ch, 64 - (ch - buffer), "%d   %u rects %u%%", _currentFPS, dirtyStats.Rects,
+            (uint32)((dirtyStats.Pixels * 100) / dirtyStats.ScreenPixels));
+    }
+    else
+    {
+        snprintf(ch, 64 - (ch - buffer), "%d", _currentFPS);
+    }
 
     // Draw Text
     sint32 stringWidth = gfx_get_string_width(buffer);
@@ -51,7 +51,7 @@ namespace OpenRCT2
             void Paint(Drawing::IDrawingEngine * de);
 
         private:
-            void PaintFPS(rct_drawpixelinfo * dpi);
+            void PaintFPS(Drawing::IDrawingEngine * de, rct_drawpixelinfo * dpi);
             void MeasureFPS();
         };
     }
@@ -55,6 +55,7 @@
 #include "../world/Climate.h"
 #include "../world/Footpath.h"
 #include "../world/MapAnimation.h"
+#include "../world/MapChangeJournal.h"
 #include "../world/Park.h"
 #include "../world/Entrance.h"
 #include "../world/LargeScenery.h"
@@ -2291,6 +2292,7 @@ private:
         }
 
         gNextFreeTileElement = nextFreeTileElement;
+        map_change_journal_mark_all();
     }
 
     void FixSceneryColours()
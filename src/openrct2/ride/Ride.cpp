@@ -46,6 +46,7 @@
 #include "../world/Footpath.h"
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
+#include "../world/MapChangeJournal.h"
 #include "../world/Scenery.h"
 #include "../world/Sprite.h"
 #include "CableLift.h"
@@ -5471,6 +5472,7 @@ sint32 ride_get_refund_price(sint32 ride_id)
                 0);
             if (removePrice == MONEY32_UNDEFINED) {
                 tile_element_remove(it.element);
+                map_change_journal_mark_tile(it.x, it.y);
             } else {
                 refundPrice += removePrice;
             }
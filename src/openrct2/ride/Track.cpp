@@ -29,6 +29,7 @@
 #include "../world/Footpath.h"
 #include "../world/Map.h"
 #include "../world/MapAnimation.h"
+#include "../world/MapChangeJournal.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
 #include "Ride.h"
@@ -1847,6 +1848,7 @@ static money32 track_remove(uint8 type,
             footpath_remove_edges_at(x, y, tileElement);
         }
         tile_element_remove(tileElement);
+        map_change_journal_mark_tile(x >> 5, y >> 5);
         if (!(flags & GAME_COMMAND_FLAG_GHOST))
         {
             sub_6CB945(rideIndex);
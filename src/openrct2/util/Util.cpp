@@ -182,6 +182,7 @@ sint32 bitscanforward(sint32 source)
     #include <cpuid.h>
     #define OpenRCT2_CPUID_GNUC_X86
 #elif defined(_MSC_VER) && (_MSC_VER >= 1500) && (defined(_M_X64) || defined(_M_IX86)) // VS2008
+    #include <immintrin.h>
     #include <intrin.h>
     #include <nmmintrin.h>
     #define OpenRCT2_CPUID_MSVC_X86
@@ -215,6 +216,41 @@ bool sse41_available()
     return false;
 }
 
+bool avx2_available()
+{
+#ifdef OPENRCT2_X86
+    // AVX2 support is declared as the 5th bit of EBX with CPUID(EAX = 7, ECX = 0). The OS also has
+    // to save the YMM registers on context switches, which is checked through OSXSAVE and XGETBV.
+    uint32 regs[4] = { 0 };
+    if (!cpuid_x86(regs, 0) || regs[0] < 7)
+    {
+        return false;
+    }
+    if (!cpuid_x86(regs, 1) || !(regs[2] & (1 << 27)))
+    {
+        return false;
+    }
+
+#if defined(OpenRCT2_CPUID_GNUC_X86)
+    uint32 xcr0Low, xcr0High;
+    __asm__ ("xgetbv" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+    __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#elif defined(OpenRCT2_CPUID_MSVC_X86)
+    uint32 xcr0Low = (uint32)_xgetbv(0);
+    __cpuidex((int *)regs, 7, 0);
+#else
+    uint32 xcr0Low = 0;
+#endif
+    if ((xcr0Low & 0x6) != 0x6)
+    {
+        return false;
+    }
+    return (regs[1] & (1 << 5));
+#else
+    return false;
+#endif
+}
+
 static bool bitcount_popcnt_available()
 {
 #ifdef OPENRCT2_X86
@@ -42,6 +42,7 @@ bool readentirefile(const utf8 *path, void **outBuffer, size_t *outLength);
 bool writeentirefile(const utf8 * path, const void * buffer, size_t length);
 
 bool sse41_available();
+bool avx2_available();
 
 sint32 bitscanforward(sint32 source);
 void bitcount_init();
@@ -20,6 +20,7 @@
 #include "Entrance.h"
 #include "Footpath.h"
 #include "Map.h"
+#include "MapChangeJournal.h"
 #include "Park.h"
 #include "../Cheats.h"
 #include "../Game.h"
@@ -413,6 +414,7 @@ static money32 RideEntranceExitRemove(sint16 x, sint16 y, uint8 rideIndex, uint8
         bool isExit = tileElement->properties.entrance.type == ENTRANCE_TYPE_RIDE_EXIT;
 
         tile_element_remove(tileElement);
+        map_change_journal_mark_tile(x >> 5, y >> 5);
 
         if (isExit)
         {
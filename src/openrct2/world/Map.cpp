@@ -41,6 +41,7 @@
 #include "LargeScenery.h"
 #include "Map.h"
 #include "MapAnimation.h"
+#include "MapChangeJournal.h"
 #include "Park.h"
 #include "Scenery.h"
 #include "SmallScenery.h"
@@ -514,6 +515,7 @@ void map_update_tile_pointers()
     }
 
     gNextFreeTileElement = tileElement;
+    map_change_journal_mark_all();
 }
 
 /**
@@ -2963,6 +2965,7 @@ void map_remove_all_rides()
             footpath_queue_chain_reset();
             footpath_remove_edges_at(it.x * 32, it.y * 32, it.element);
             tile_element_remove(it.element);
+            map_change_journal_mark_tile(it.x, it.y);
             tile_element_iterator_restart_for_tile(&it);
             break;
         }
@@ -3131,6 +3134,7 @@ rct_tile_element *tile_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags
 
     // Set tile index pointer to point to new element block
     gTileElementTilePointers[y * MAXIMUM_MAP_SIZE_TECHNICAL + x] = newTileElement;
+    map_change_journal_mark_tile(x, y);
 
     // Copy all elements that are below the insert height
     while (z >= originalTileElement->base_height) {
@@ -3764,6 +3768,7 @@ static void clear_element_at(sint32 x, sint32 y, rct_tile_element **elementPtr)
         break;
     default:
         tile_element_remove(element);
+        map_change_journal_mark_tile(x >> 5, y >> 5);
         break;
     }
 }
@@ -4072,6 +4077,8 @@ LocationXY32 translate_3d_to_2d_with_z(sint32 rotation, LocationXYZ32 pos)
 
 static void map_invalidate_tile_under_zoom(sint32 x, sint32 y, sint32 z0, sint32 z1, sint32 maxZoom)
 {
+    map_change_journal_mark_tile(x >> 5, y >> 5);
+
     if (gOpenRCT2Headless) return;
 
     sint32 x1, y1, x2, y2;
@@ -0,0 +1,65 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <bitset>
+#include "Map.h"
+#include "MapChangeJournal.h"
+
+static std::bitset<MAXIMUM_MAP_SIZE_TECHNICAL * MAXIMUM_MAP_SIZE_TECHNICAL> _changedTileFlags;
+static std::vector<LocationXY8> _changedTiles;
+static bool _allTilesChanged = true;
+
+void map_change_journal_mark_tile(sint32 x, sint32 y)
+{
+    if (_allTilesChanged)
+        return;
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_TECHNICAL || y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+        return;
+
+    size_t index = (size_t)(y * MAXIMUM_MAP_SIZE_TECHNICAL + x);
+    if (!_changedTileFlags[index])
+    {
+        _changedTileFlags[index] = true;
+        LocationXY8 tile;
+        tile.x = (uint8)x;
+        tile.y = (uint8)y;
+        _changedTiles.push_back(tile);
+    }
+}
+
+void map_change_journal_mark_all()
+{
+    _allTilesChanged = true;
+    _changedTileFlags.reset();
+    _changedTiles.clear();
+}
+
+bool map_change_journal_consume(std::vector<LocationXY8> &tiles)
+{
+    tiles.clear();
+    if (_allTilesChanged)
+    {
+        _allTilesChanged = false;
+        return false;
+    }
+
+    tiles.swap(_changedTiles);
+    for (const auto &tile : tiles)
+    {
+        _changedTileFlags[tile.y * MAXIMUM_MAP_SIZE_TECHNICAL + tile.x] = false;
+    }
+    return true;
+}
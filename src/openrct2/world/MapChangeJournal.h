@@ -0,0 +1,42 @@
+#pragma region Copyright (c) 2017 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <vector>
+#include "../common.h"
+#include "Location.h"
+
+/**
+ * Records which tiles have been changed (elements inserted, removed or modified) since the journal was last consumed,
+ * so that views of the whole map such as the minimap only need to redraw what has changed.
+ */
+
+/**
+ * Marks the given tile (in tile coordinates) as changed.
+ */
+void map_change_journal_mark_tile(sint32 x, sint32 y);
+
+/**
+ * Marks the whole map as changed, e.g. after a park has been loaded.
+ */
+void map_change_journal_mark_all();
+
+/**
+ * Moves the tiles changed since the last call into the given list and clears the journal.
+ * @returns false if the whole map has changed, in which case the list is left empty.
+ */
+bool map_change_journal_consume(std::vector<LocationXY8> &tiles);
@@ -37,6 +37,7 @@
 #include "../scenario/Scenario.h"
 #include "Entrance.h"
 #include "Map.h"
+#include "MapChangeJournal.h"
 #include "Park.h"
 #include "Sprite.h"
 
@@ -702,6 +703,9 @@ void update_park_fences(sint32 x, sint32 y)
     if (y <= 0 || y >= gMapSizeUnits)
         return;
 
+    // Ownership may have changed without the tile being invalidated
+    map_change_journal_mark_tile(x >> 5, y >> 5);
+
     rct_tile_element* sufaceElement = map_get_surface_element_at(x / 32, y / 32);
     if (sufaceElement == nullptr)return;
 
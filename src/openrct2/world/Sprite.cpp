@@ -202,59 +202,6 @@ static size_t GetSpatialIndexOffset(sint32 x, sint32 y)
     return index;
 }
 
-#ifndef DISABLE_NETWORK
-
-static uint8 _spriteChecksum[EVP_MAX_MD_SIZE + 1];
-
-const char * sprite_checksum()
-{
-    if (EVP_DigestInit_ex(gHashCTX, EVP_sha1(), NULL) <= 0)
-    {
-        openrct2_assert(false, "Failed to initialise SHA1 engine");
-    }
-    for (size_t i = 0; i < MAX_SPRITES; i++)
-    {
-        rct_sprite *sprite = get_sprite(i);
-        if (sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_NULL && sprite->unknown.sprite_identifier != SPRITE_IDENTIFIER_MISC)
-        {
-            rct_sprite copy = *sprite;
-            copy.unknown.sprite_left = copy.unknown.sprite_right = copy.unknown.sprite_top = copy.unknown.sprite_bottom = 0;
-
-            if (copy.unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP) {
-                // We set this to 0 because as soon the client selects a guest the window will remove the
-                // invalidation flags causing the sprite checksum to be different than on server, the flag does not affect game state.
-                copy.peep.window_invalidate_flags = 0;
-            }
-
-            if (EVP_DigestUpdate(gHashCTX, &copy, sizeof(rct_sprite)) <= 0)
-            {
-                openrct2_assert(false, "Failed to update digest");
-            }
-        }
-    }
-    uint8 localhash[EVP_MAX_MD_SIZE + 1];
-    uint32 size = sizeof(localhash);
-    EVP_DigestFinal(gHashCTX, localhash, &size);
-    assert(size <= sizeof(localhash));
-    localhash[sizeof(localhash) - 1] = '\0';
-    char *x = (char *)_spriteChecksum;
-    for (uint32 i = 0; i < size; i++)
-    {
-        snprintf(x, EVP_MAX_MD_SIZE + 1, "%02x", localhash[i]);
-        x += 2;
-    }
-    *x = '\0';
-    return (char *)_spriteChecksum;
-}
-#else
-
-const char * sprite_checksum()
-{
-    return NULL;
-}
-
-#endif // DISABLE_NETWORK
-
 static void sprite_reset(rct_unk_sprite *sprite)
 {
     // Need to retain how the sprite is linked in lists
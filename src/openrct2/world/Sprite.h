@@ -454,8 +454,6 @@ void crashed_vehicle_particle_update(rct_crashed_vehicle_particle *particle);
 void crash_splash_create(sint32 x, sint32 y, sint32 z);
 void crash_splash_update(rct_crash_splash *splash);
 
-const char *sprite_checksum();
-
 void sprite_set_flashing(rct_sprite *sprite, bool flashing);
 bool sprite_get_flashing(rct_sprite *sprite);
 sint32 check_for_sprite_list_cycles(bool fix);
@@ -0,0 +1,115 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/DirtyRegion.h>
+
+static void AssertNoOverlaps(const DirtyRegion &region)
+{
+    const auto &rects = region.GetRects();
+    for (size_t i = 0; i < rects.size(); i++)
+    {
+        ASSERT_FALSE(rects[i].IsEmpty());
+        for (size_t j = i + 1; j < rects.size(); j++)
+        {
+            ASSERT_FALSE(rects[i].Intersects(rects[j]));
+        }
+    }
+}
+
+static bool RegionContains(const DirtyRegion &region, sint32 x, sint32 y)
+{
+    for (const auto &rect : region.GetRects())
+    {
+        if (x >= rect.Left && x < rect.Right && y >= rect.Top && y < rect.Bottom)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(DirtyRegionTest, UnionOverlappingCountsPixelsOnce)
+{
+    DirtyRegion region;
+    region.Union({ 0, 0, 100, 100 });
+    region.Union({ 50, 50, 150, 150 });
+    AssertNoOverlaps(region);
+    ASSERT_EQ(region.GetArea(), 100u * 100u * 2 - 50u * 50u);
+
+    DirtyRect bounds = region.GetBounds();
+    ASSERT_EQ(bounds.Left, 0);
+    ASSERT_EQ(bounds.Top, 0);
+    ASSERT_EQ(bounds.Right, 150);
+    ASSERT_EQ(bounds.Bottom, 150);
+}
+
+TEST(DirtyRegionTest, UnionCoalescesNeighbours)
+{
+    DirtyRegion region;
+    for (sint32 x = 0; x < 320; x += 32)
+    {
+        region.Union({ x, 16, x + 32, 48 });
+    }
+    ASSERT_EQ(region.GetRects().size(), 1u);
+
+    region.Union({ 0, 48, 320, 64 });
+    ASSERT_EQ(region.GetRects().size(), 1u);
+    ASSERT_EQ(region.GetArea(), 320u * 48u);
+
+    region.Union({ 10, 20, 30, 40 });
+    ASSERT_EQ(region.GetRects().size(), 1u);
+}
+
+TEST(DirtyRegionTest, Intersect)
+{
+    DirtyRegion region;
+    region.Union({ 0, 0, 10, 10 });
+    region.Union({ 20, 0, 30, 10 });
+
+    DirtyRegion clipped = region.Intersect({ 5, 5, 25, 100 });
+    ASSERT_EQ(clipped.GetRects().size(), 2u);
+    ASSERT_EQ(clipped.GetArea(), 5u * 5u * 2);
+    ASSERT_TRUE(region.Intersect({ 10, 0, 20, 10 }).IsEmpty());
+}
+
+TEST(DirtyRegionTest, SubtractLeavesFrameAroundHole)
+{
+    DirtyRegion region;
+    region.Union({ 0, 0, 100, 100 });
+    region.Subtract({ 25, 25, 75, 75 });
+    AssertNoOverlaps(region);
+    ASSERT_EQ(region.GetArea(), 100u * 100u - 50u * 50u);
+    ASSERT_TRUE(RegionContains(region, 24, 50));
+    ASSERT_TRUE(RegionContains(region, 75, 50));
+    ASSERT_FALSE(RegionContains(region, 25, 25));
+    ASSERT_FALSE(RegionContains(region, 74, 74));
+
+    region.Subtract({ -10, -10, 200, 200 });
+    ASSERT_TRUE(region.IsEmpty());
+}
+
+TEST(DirtyRegionTest, RandomRectsStayCoveredWithoutOverlaps)
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<sint32> position(0, 500);
+    std::uniform_int_distribution<sint32> size(1, 40);
+
+    DirtyRegion region;
+    std::vector<DirtyRect> added;
+    for (sint32 i = 0; i < 400; i++)
+    {
+        sint32 x = position(rng);
+        sint32 y = position(rng);
+        DirtyRect rect = { x, y, x + size(rng), y + size(rng) };
+        region.Union(rect);
+        added.push_back(rect);
+    }
+
+    ASSERT_LE(region.GetRects().size(), DirtyRegion::MaxRects);
+    AssertNoOverlaps(region);
+    for (const auto &rect : added)
+    {
+        ASSERT_TRUE(RegionContains(region, rect.Left, rect.Top));
+        ASSERT_TRUE(RegionContains(region, rect.Right - 1, rect.Bottom - 1));
+    }
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <openrct2/drawing/ImageListAllocator.h>
+
+constexpr uint32 BASE_ID = 1000;
+constexpr uint32 CAPACITY = 10000;
+
+TEST(ImageListAllocatorTest, AllocateIsContiguous)
+{
+    ImageListAllocator allocator(BASE_ID, CAPACITY);
+    ASSERT_EQ(allocator.Allocate(10), BASE_ID);
+    ASSERT_EQ(allocator.Allocate(20), BASE_ID + 10);
+    ASSERT_EQ(allocator.Allocate(CAPACITY - 30), BASE_ID + 30);
+    ASSERT_EQ(allocator.Allocate(1), ImageListAllocator::INVALID_ID);
+    ASSERT_EQ(allocator.GetAllocatedImageCount(), CAPACITY);
+}
+
+TEST(ImageListAllocatorTest, FreeMergesNeighbours)
+{
+    ImageListAllocator allocator(BASE_ID, CAPACITY);
+    uint32 a = allocator.Allocate(100);
+    uint32 b = allocator.Allocate(100);
+    uint32 c = allocator.Allocate(100);
+    allocator.Allocate(CAPACITY - 300);
+
+    ASSERT_TRUE(allocator.Free(a, 100));
+    ASSERT_TRUE(allocator.Free(c, 100));
+    ASSERT_EQ(allocator.GetStats().free_ranges, 2u);
+    ASSERT_EQ(allocator.Allocate(200), ImageListAllocator::INVALID_ID);
+
+    ASSERT_TRUE(allocator.Free(b, 100));
+    auto stats = allocator.GetStats();
+    ASSERT_EQ(stats.free_ranges, 1u);
+    ASSERT_EQ(stats.largest_free_range, 300u);
+    ASSERT_EQ(allocator.Allocate(300), a);
+}
+
+TEST(ImageListAllocatorTest, AllocateBestFit)
+{
+    ImageListAllocator allocator(BASE_ID, CAPACITY);
+    uint32 a = allocator.Allocate(50);
+    allocator.Allocate(1);
+    uint32 b = allocator.Allocate(10);
+    allocator.Allocate(1);
+    allocator.Free(a, 50);
+    allocator.Free(b, 10);
+
+    // The 10 image gap is used rather than the first gap that fits
+    ASSERT_EQ(allocator.Allocate(8), b);
+    ASSERT_EQ(allocator.Allocate(50), a);
+}
+
+TEST(ImageListAllocatorTest, FreeInvalid)
+{
+    ImageListAllocator allocator(BASE_ID, CAPACITY);
+    uint32 a = allocator.Allocate(10);
+    ASSERT_FALSE(allocator.Free(a, 5));
+    ASSERT_FALSE(allocator.Free(a + 1, 9));
+    ASSERT_TRUE(allocator.Free(a, 10));
+    ASSERT_FALSE(allocator.Free(a, 10));
+    ASSERT_EQ(allocator.GetAllocatedImageCount(), 0u);
+}
+
+TEST(ImageListAllocatorTest, RandomAllocateAndFree)
+{
+    ImageListAllocator allocator(BASE_ID, CAPACITY);
+    std::mt19937 random(1234);
+    std::vector<std::pair<uint32, uint32>> allocations;
+    for (sint32 i = 0; i < 10000; i++)
+    {
+        if (allocations.empty() || random() % 3 != 0)
+        {
+            uint32 count = 1 + random() % 64;
+            uint32 baseId = allocator.Allocate(count);
+            if (baseId != ImageListAllocator::INVALID_ID)
+            {
+                ASSERT_GE(baseId, BASE_ID);
+                ASSERT_LE(baseId + count, BASE_ID + CAPACITY);
+                for (const auto &allocation : allocations)
+                {
+                    bool overlaps = baseId < allocation.first + allocation.second && allocation.first < baseId + count;
+                    ASSERT_FALSE(overlaps);
+                }
+                allocations.emplace_back(baseId, count);
+            }
+        }
+        else
+        {
+            size_t index = random() % allocations.size();
+            ASSERT_TRUE(allocator.Free(allocations[index].first, allocations[index].second));
+            allocations.erase(allocations.begin() + index);
+        }
+    }
+
+    for (const auto &allocation : allocations)
+    {
+        ASSERT_TRUE(allocator.Free(allocation.first, allocation.second));
+    }
+    auto stats = allocator.GetStats();
+    ASSERT_EQ(stats.allocated_images, 0u);
+    ASSERT_EQ(stats.allocations, 0u);
+    ASSERT_EQ(stats.free_ranges, 1u);
+    ASSERT_EQ(stats.largest_free_range, CAPACITY);
+}